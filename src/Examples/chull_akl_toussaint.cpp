@@ -0,0 +1,81 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * The Akl-Toussaint cull ahead of the monotone chain on uniform, gaussian and on-circle points: the fraction of the
+ * points culled and the hull times with and without it, both on a warm scratch.
+ *
+ * usage: chull_akl_toussaint [points] [repeats]
+ */
+int main(int argc, char* argv[]) {
+    size_t n = 1000000;
+    int repeats = 5;
+    if (argc > 1)
+        n = atoll(argv[1]);
+    if (argc > 2)
+        repeats = atoi(argv[2]);
+
+    mt19937 gen(1);
+    uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    normal_distribution<float> gaussian(0.0f, 1.0f);
+    uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    const auto run = [&](const string& name, const vector<vec2f>& points) {
+        chull_scratch_2d<float> scratch;
+        chull_akl_toussaint_scratch_2d<float> culled_scratch;
+        vector<vec2f> hull, culled_hull, kept;
+        performance_timer timer;
+
+        kept.reserve(points.size());
+        akl_toussaint_filter_2d(points.begin(), points.end(), back_inserter(kept));
+
+        double plain = 0.0, culled = 0.0;
+        for (int r = 0; r < repeats; ++r) {
+            hull.clear();
+            timer.start();
+            chull_graham_2d(points.begin(), points.end(), back_inserter(hull), scratch);
+            timer.stop();
+            plain += timer.elapsed_seconds();
+
+            culled_hull.clear();
+            timer.start();
+            chull_akl_toussaint_2d(points.begin(), points.end(), back_inserter(culled_hull), culled_scratch);
+            timer.stop();
+            culled += timer.elapsed_seconds();
+        }
+
+        cout << name << ": " << hull.size() << " hull vertices, "
+             << 100.0 * (points.size() - kept.size()) / points.size() << "% culled, "
+             << plain / repeats * 1e3 << " ms -> " << culled / repeats * 1e3 << " ms ("
+             << plain / culled << "x)" << (hull == culled_hull ? "" : ", hulls differ") << endl;
+    };
+
+    vector<vec2f> points(n);
+    for (auto& p : points)
+        p = vec2f(uniform(gen), uniform(gen));
+    run("uniform  ", points);
+
+    for (auto& p : points)
+        p = vec2f(gaussian(gen), gaussian(gen));
+    run("gaussian ", points);
+
+    for (auto& p : points) {
+        const auto a = angle(gen);
+        p = vec2f(cos(a), sin(a));
+    }
+    run("on circle", points);
+
+    return 0;
+}
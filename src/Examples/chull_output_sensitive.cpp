@@ -0,0 +1,109 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Hull times as the hull size h grows from a constant to n: the vertices of a regular h-gon with the other points
+ * uniform inside it, up to all points on a circle, and uniform and gaussian clouds.  Compares the monotone chain,
+ * Akl-Toussaint culling, quickhull and the chull_auto_2d dispatcher, all on a warm scratch.
+ *
+ * usage: chull_output_sensitive [points] [repeats]
+ */
+int main(int argc, char* argv[]) {
+    size_t n = 1000000;
+    int repeats = 3;
+    if (argc > 1)
+        n = atoll(argv[1]);
+    if (argc > 2)
+        repeats = atoi(argv[2]);
+
+    mt19937 gen(1);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    normal_distribution<double> gaussian(0.0, 1.0);
+
+    // h polygon vertices on the unit circle, the rest uniform in the polygon's inscribed disc
+    const auto polygon_cloud = [&](size_t h) {
+        vector<vec2d> points;
+        const double step = 2.0 * M_PI / h;
+        for (size_t i = 0; i < h; ++i)
+            points.emplace_back(cos(i * step), sin(i * step));
+        const double inner = cos(step / 2) * (1.0 - 1e-9);
+        while (points.size() < n) {
+            const double r = inner * sqrt(unit(gen));
+            const double a = 2.0 * M_PI * unit(gen);
+            points.emplace_back(r * cos(a), r * sin(a));
+        }
+        shuffle(points.begin(), points.end(), gen);
+        return points;
+    };
+
+    chull_scratch_2d<double> scratch;
+    chull_akl_toussaint_scratch_2d<double> akl_scratch;
+    chull_quickhull_scratch_2d<double> quickhull_scratch;
+    const auto time = [&](const vector<vec2d>& points, vector<vec2d>& hull, auto algorithm) {
+        performance_timer timer;
+        double total = 0.0;
+        for (int r = 0; r < repeats; ++r) {
+            hull.clear();
+            timer.start();
+            algorithm(points, back_inserter(hull));
+            timer.stop();
+            total += timer.elapsed_seconds();
+        }
+        return total / repeats * 1e3;
+    };
+
+    const auto run = [&](const string& name, const vector<vec2d>& points) {
+        vector<vec2d> expected, hull;
+        const auto graham = time(points, expected, [&](const auto& p, auto out) {
+            chull_graham_2d(p.begin(), p.end(), out, scratch);
+        });
+        const auto akl = time(points, hull, [&](const auto& p, auto out) {
+            chull_akl_toussaint_2d(p.begin(), p.end(), out, akl_scratch);
+        });
+        bool same = hull == expected;
+        const auto quick = time(points, hull, [&](const auto& p, auto out) {
+            chull_quickhull_2d(p.begin(), p.end(), out, quickhull_scratch);
+        });
+        same &= hull == expected;
+        const auto automatic = time(points, hull, [&](const auto& p, auto out) {
+            chull_auto_2d(p.begin(), p.end(), out, quickhull_scratch);
+        });
+        same &= hull == expected;
+
+        cout << name << "  h " << expected.size() << "  graham " << graham << " ms  akl-toussaint " << akl
+             << " ms  quickhull " << quick << " ms  auto " << automatic << " ms" << (same ? "" : "  hulls differ")
+             << endl;
+    };
+
+    for (size_t h : {4, 16, 256, 4096, 65536, 262144})
+        run("polygon " + to_string(h), polygon_cloud(h));
+
+    vector<vec2d> points(n);
+    for (auto& p : points) {
+        const double a = 2.0 * M_PI * unit(gen);
+        p = vec2d(cos(a), sin(a));
+    }
+    run("circle", points);
+
+    for (auto& p : points)
+        p = vec2d(unit(gen), unit(gen));
+    run("uniform", points);
+
+    for (auto& p : points)
+        p = vec2d(gaussian(gen), gaussian(gen));
+    run("gaussian", points);
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Strong scaling of the parallel hulls and of parallel_sort: the same uniform point cloud on 1, 2, 4, ... threads up
+ * to max_threads, against chull_graham_2d and std::sort.
+ *
+ * usage: chull_parallel [points] [max_threads]
+ */
+int main(int argc, char* argv[]) {
+    size_t n = 10000000;
+    size_t max_threads = max(1u, thread::hardware_concurrency());
+    if (argc > 1)
+        n = atoll(argv[1]);
+    if (argc > 2)
+        max_threads = atoi(argv[2]);
+
+    mt19937 gen(1);
+    uniform_real_distribution<float> dis(0.0f, 1.0f);
+    vector<vec2f> points(n);
+    for (auto& p : points)
+        p = vec2f(dis(gen), dis(gen));
+
+    vector<vec2f> hull;
+    performance_timer timer;
+    timer.start();
+    chull_graham_2d(points.begin(), points.end(), back_inserter(hull));
+    timer.stop();
+    const auto sequential = timer.elapsed_seconds();
+    cout << n << " points, " << hull.size() << " hull vertices" << endl;
+    cout << "chull_graham_2d: " << sequential * 1e3 << " ms" << endl;
+
+    auto sorted = points;
+    timer.start();
+    sort(sorted.begin(), sorted.end());
+    timer.stop();
+    const auto sequential_sort = timer.elapsed_seconds();
+    cout << "std::sort: " << sequential_sort * 1e3 << " ms" << endl;
+
+    cout << "threads  chull_parallel_2d  chull_parallel_sorted_2d  parallel_sort" << endl;
+    for (size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        vector<vec2f> parallel_hull;
+        timer.start();
+        chull_parallel_2d(points.begin(), points.end(), back_inserter(parallel_hull), n_threads);
+        timer.stop();
+        const auto local_hulls = timer.elapsed_seconds();
+        if (parallel_hull != hull)
+            cout << "chull_parallel_2d differs" << endl;
+
+        parallel_hull.clear();
+        timer.start();
+        chull_parallel_sorted_2d(points.begin(), points.end(), back_inserter(parallel_hull), n_threads);
+        timer.stop();
+        const auto sorted_chains = timer.elapsed_seconds();
+        if (parallel_hull != hull)
+            cout << "chull_parallel_sorted_2d differs" << endl;
+
+        sorted = points;
+        timer.start();
+        parallel_sort(sorted.begin(), sorted.end(), less<>(), n_threads);
+        timer.stop();
+        const auto sort_time = timer.elapsed_seconds();
+
+        cout << n_threads << "  " << local_hulls * 1e3 << " ms (" << sequential / local_hulls << "x)  "
+             << sorted_chains * 1e3 << " ms (" << sequential / sorted_chains << "x)  "
+             << sort_time * 1e3 << " ms (" << sequential_sort / sort_time << "x)" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <MTLib/mtlib.h>
+
+#include "common/counting_allocator.h"
+#include "common/performance_timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Hulls of many small point sets, as a per-object hull pass does: the plain chull_graham_2d against the scratch
+ * variants writing points and indices, reporting hulls per second and heap allocations per hull.
+ *
+ * usage: chull_small [points per set] [sets]
+ */
+int main(int argc, char* argv[]) {
+    size_t n = 16;
+    size_t sets = 1000000;
+    if (argc > 1)
+        n = atoi(argv[1]);
+    if (argc > 2)
+        sets = atoi(argv[2]);
+
+    mt19937 gen(1);
+    uniform_real_distribution<float> dis(-1.0f, 1.0f);
+
+    // a pool of sets reused round robin, small enough to stay in cache
+    const size_t pool = 1024;
+    vector<vec2f> points(pool * n);
+    for (auto& p : points)
+        p = vec2f(dis(gen), dis(gen));
+
+    vector<vec2f> hull;
+    vector<uint32_t> indices;
+    hull.reserve(n);
+    indices.reserve(n);
+    chull_scratch_2d<float> scratch;
+    size_t checksum = 0;
+
+    const auto run = [&](const char* name, auto hull_of) {
+        performance_timer timer;
+        const size_t before = heap_allocations;
+        timer.start();
+        for (size_t s = 0; s < sets; ++s) {
+            const auto first = points.begin() + (s % pool) * n;
+            checksum += hull_of(first, first + n);
+        }
+        timer.stop();
+        const size_t count = heap_allocations - before;
+        cout << name << ": " << sets / timer.elapsed_seconds() / 1e6 << " M hulls/s, "
+             << double(count) / sets << " allocations/hull" << endl;
+    };
+
+    run("chull_graham_2d        ", [&](auto first, auto last) {
+        hull.clear();
+        chull_graham_2d(first, last, back_inserter(hull));
+        return hull.size();
+    });
+    run("chull_graham_2d scratch", [&](auto first, auto last) {
+        hull.clear();
+        chull_graham_2d(first, last, back_inserter(hull), scratch);
+        return hull.size();
+    });
+    run("chull_graham_2d_indices", [&](auto first, auto last) {
+        indices.clear();
+        chull_graham_2d_indices(first, last, back_inserter(indices), scratch);
+        return indices.size();
+    });
+    run("chull_monotone_chain_2d", [&](auto first, auto last) {
+        return chull_monotone_chain_2d(first, last, scratch);
+    });
+
+    cout << "checksum " << checksum << endl;
+    return 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#ifndef _COMMON_COUNTING_ALLOCATOR_H_
+#define _COMMON_COUNTING_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Replaces the global operator new and delete to count the heap allocations of the whole program.  The replacements
+ * are definitions, so only the one source file of an example includes this header.
+ */
+inline std::atomic<std::size_t> heap_allocations {0};
+
+void* operator new(std::size_t size) {
+    ++heap_allocations;
+    // a zero size request still returns a unique pointer, which malloc(0) need not
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+// inlined into a caller, the free would be paired with operator new by GCC's -Wmismatched-new-delete
+[[gnu::noinline]] void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif
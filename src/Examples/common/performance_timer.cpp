@@ -13,4 +13,8 @@ void performance_timer::stop() {
 void performance_timer::report(const string& msg) {
     const auto elapsed = chrono::duration_cast<chrono::milliseconds>(_stop - _start);
     cout << msg << ": " << elapsed.count() << "ms\n";
+}
+
+double performance_timer::elapsed_seconds() const {
+    return chrono::duration<double>(_stop - _start).count();
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ class performance_timer {
         void start();
         void stop();
         void report(const std::string& msg = "elapsed");
+        double elapsed_seconds() const;
     
     private:
         std::chrono::high_resolution_clock _clock;
@@ -0,0 +1,108 @@
+#include <MTLib/mtlib.h>
+
+#include "common/counting_allocator.h"
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+namespace {
+
+using dcel_type = ds::dcel_vector;
+using mesh_type = ds::polygon_mesh<ds::dcel_vector_Traits>;
+
+/**
+ * Applies batch edits to random faces of the mesh, then undoes them in reverse order.  done keeps its capacity from
+ * one round to the next.
+ */
+template <typename Handle, typename Edit, typename Undo>
+void edit_round(mesh_type& mesh, mt19937& gen, size_t batch, vector<Handle>& done, Edit edit, Undo undo) {
+    uniform_int_distribution<size_t> dis(0, mesh.faces.size() - 1);
+    done.clear();
+    while (done.size() < batch) {
+        const auto handle = edit(mesh.faces[dis(gen)]);
+        if (handle != Handle())
+            done.push_back(handle);
+    }
+    for (auto it = done.rbegin(); it != done.rend(); ++it)
+        undo(*it);
+}
+
+template <typename Handle, typename Edit, typename Undo>
+void run(const char* name, mesh_type& mesh, size_t batch, size_t rounds, Edit edit, Undo undo) {
+    mt19937 gen(0);
+    vector<Handle> done;
+    edit_round(mesh, gen, batch, done, edit, undo);
+
+    const size_t allocations = heap_allocations;
+    performance_timer timer;
+    timer.start();
+    for (size_t r = 0; r < rounds; ++r)
+        edit_round(mesh, gen, batch, done, edit, undo);
+    timer.stop();
+
+    const double edits = 2.0 * static_cast<double>(batch * rounds);
+    cout << "  " << name << ": " << edits / timer.elapsed_seconds() / 1e6 << " M edits/s, "
+         << heap_allocations - allocations << " allocations after warm-up\n";
+}
+
+}   // namespace
+
+/**
+ * Edits a dcel_vector grid of k x k quads with split_edge_at / remove_vertex, split_face_at / merge_faces_at and
+ * add_vertex / remove_vertex, in batches that are undone in reverse order, and reports the edits per second and the
+ * allocations made after a first warm-up batch.
+ *
+ * usage: dcel_edits [grid side] [batch size] [rounds]
+ */
+int main(int argc, char* argv[]) {
+    size_t k = 1000;
+    size_t batch = 100000;
+    size_t rounds = 20;
+    if (argc > 1)
+        k = static_cast<size_t>(atoi(argv[1]));
+    if (argc > 2)
+        batch = static_cast<size_t>(atoi(argv[2]));
+    if (argc > 3)
+        rounds = static_cast<size_t>(atoi(argv[3]));
+
+    vector<vec2d> points((k + 1) * (k + 1));
+    vector<uint32_t> indices;
+    vector<uint32_t> offsets(1, 0);
+    for (uint32_t j = 0; j < k; ++j) {
+        for (uint32_t i = 0; i < k; ++i) {
+            const auto v = static_cast<uint32_t>(j * (k + 1) + i);
+            const auto above = static_cast<uint32_t>(v + k + 1);
+            indices.insert(indices.end(), { v, v + 1, above + 1, above });
+            offsets.push_back(static_cast<uint32_t>(indices.size()));
+        }
+    }
+    auto mesh = ds::dcel_from_polygons(points, indices, offsets, 1);
+    auto& d = mesh.dcel;
+    cout << k * k << " quads, " << d.half_edges_size() << " half-edges, batches of " << batch << " edits and undos\n";
+
+    run<dcel_type::vertex_handle>("split_edge_at / remove_vertex", mesh, batch, rounds,
+        [&](dcel_type::face_handle f) { return d.split_edge_at(d[f].incident); },
+        [&](dcel_type::vertex_handle w) { d.remove_vertex(w); });
+
+    // faces already split down to triangles are skipped
+    run<dcel_type::half_edge_handle>("split_face_at / merge_faces_at", mesh, batch, rounds,
+        [&](dcel_type::face_handle f) {
+            const auto a = d[f].incident;
+            const auto b = d[d[a].next].next;
+            return d[b].next != a ? d.split_face_at(a, b) : dcel_type::null_half_edge;
+        },
+        [&](dcel_type::half_edge_handle e) { d.merge_faces_at(d[e].twin); });
+
+    run<dcel_type::vertex_handle>("add_vertex / remove_vertex", mesh, batch, rounds,
+        [&](dcel_type::face_handle f) { return d.add_vertex(d[f].incident); },
+        [&](dcel_type::vertex_handle w) { d.remove_vertex(w); });
+
+    return 0;
+}
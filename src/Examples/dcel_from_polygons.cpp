@@ -0,0 +1,110 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+namespace {
+
+/**
+ * Builds the dcel of the polygons with create_vertex, create_half_edge and create_face, matching the twins with a
+ * std::unordered_map from directed vertex pairs, the way it is usually written by hand.  Leaves the boundary
+ * half-edges without twins, so it does less than dcel_from_polygons.
+ */
+ds::dcel_vector build_by_hand(size_t n_vertices, const vector<uint32_t>& indices, const vector<uint32_t>& offsets) {
+    ds::dcel_vector d;
+    vector<ds::dcel_vector::vertex_handle> vertices(n_vertices);
+    for (auto& v : vertices)
+        v = d.create_vertex();
+
+    unordered_map<uint64_t, ds::dcel_vector::half_edge_handle> half_edges;
+    for (size_t f = 0; f + 1 < offsets.size(); ++f) {
+        const auto face = d.create_face();
+        const auto first = d.create_half_edge();
+        d[face].incident = first;
+        auto prev = first;
+        for (auto h = offsets[f]; h < offsets[f + 1]; ++h) {
+            const auto he = h == offsets[f] ? first : d.create_half_edge();
+            const uint64_t u = indices[h];
+            const uint64_t v = indices[h + 1 < offsets[f + 1] ? h + 1 : offsets[f]];
+            d[he].origin = vertices[u];
+            d[he].face = face;
+            d[he].prev = prev;
+            d[prev].next = he;
+            d[vertices[u]].incident = he;
+            const auto twin = half_edges.find(v << 32 | u);
+            if (twin != half_edges.end()) {
+                d[he].twin = twin->second;
+                d[twin->second].twin = he;
+            }
+            else {
+                half_edges.emplace(u << 32 | v, he);
+            }
+            prev = he;
+        }
+        d[first].prev = prev;
+        d[prev].next = first;
+    }
+    return d;
+}
+
+}   // namespace
+
+/**
+ * Builds the dcel of a grid of k x k quads, given as indexed polygons, with dcel_from_polygons on 1, 2, 4, ... threads
+ * for k up to about 3200 (10^7 faces).  For comparison, builds it by hand matching the twins with a std::unordered_map.
+ *
+ * usage: dcel_from_polygons [largest grid side] [largest number of threads]
+ */
+int main(int argc, char* argv[]) {
+    size_t max_k = 3200;
+    size_t max_threads = max<size_t>(4, thread::hardware_concurrency());
+    if (argc > 1)
+        max_k = static_cast<size_t>(atoi(argv[1]));
+    if (argc > 2)
+        max_threads = static_cast<size_t>(atoi(argv[2]));
+
+    for (size_t k = 1000; k <= max_k; k = k * 16 / 5) {
+        vector<vec2d> points;
+        vector<uint32_t> indices;
+        vector<uint32_t> offsets(1, 0);
+        for (size_t j = 0; j <= k; ++j) {
+            for (size_t i = 0; i <= k; ++i)
+                points.emplace_back(static_cast<double>(i), static_cast<double>(j));
+        }
+        for (uint32_t j = 0; j < k; ++j) {
+            for (uint32_t i = 0; i < k; ++i) {
+                const auto v = static_cast<uint32_t>(j * (k + 1) + i);
+                const auto above = static_cast<uint32_t>(v + k + 1);
+                indices.insert(indices.end(), { v, v + 1, above + 1, above });
+                offsets.push_back(static_cast<uint32_t>(indices.size()));
+            }
+        }
+        cout << k * k << " quads, " << indices.size() << " polygon half-edges\n";
+
+        performance_timer timer;
+        timer.start();
+        const auto by_hand = build_by_hand(points.size(), indices, offsets);
+        timer.stop();
+        cout << "  by hand with std::unordered_map: " << 1000 * timer.elapsed_seconds() << " ms, "
+             << by_hand.half_edges_size() << " half-edges\n";
+
+        for (size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+            timer.start();
+            const auto mesh = ds::dcel_from_polygons(points, indices, offsets, n_threads);
+            timer.stop();
+            cout << "  dcel_from_polygons, " << n_threads << " threads: " << 1000 * timer.elapsed_seconds() << " ms, "
+                 << mesh.dcel.half_edges_size() << " half-edges\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Sums the face areas and edge lengths of a grid of k x k quads, once with the vertex positions in a
+ * std::unordered_map next to a dcel_list and once with them in the side array of dcel_vector_data_Traits.
+ *
+ * usage: dcel_positions [grid side] [repeats]
+ */
+int main(int argc, char* argv[]) {
+    size_t k = 1000;
+    size_t repeats = 5;
+    if (argc > 1)
+        k = static_cast<size_t>(atoi(argv[1]));
+    if (argc > 2)
+        repeats = static_cast<size_t>(atoi(argv[2]));
+
+    vector<vec2d> points;
+    for (size_t j = 0; j <= k; ++j) {
+        for (size_t i = 0; i <= k; ++i)
+            points.emplace_back(static_cast<double>(i), static_cast<double>(j));
+    }
+    vector<uint32_t> indices;
+    vector<uint32_t> offsets(1, 0);
+    for (uint32_t j = 0; j < k; ++j) {
+        for (uint32_t i = 0; i < k; ++i) {
+            const auto v = static_cast<uint32_t>(j * (k + 1) + i);
+            const auto above = static_cast<uint32_t>(v + k + 1);
+            indices.insert(indices.end(), { v, v + 1, above + 1, above });
+            offsets.push_back(static_cast<uint32_t>(indices.size()));
+        }
+    }
+    cout << k * k << " quads\n";
+    performance_timer timer;
+
+    {
+        auto mesh = ds::dcel_from_polygons<ds::dcel_list_Traits>(points, indices, offsets, 1);
+        auto& d = mesh.dcel;
+        unordered_map<const ds::dcel_list::vertex*, vec2d> position;
+        for (size_t v = 0; v < points.size(); ++v)
+            position.emplace(mesh.vertices[v], points[v]);
+
+        double area = 0;
+        double length = 0;
+        timer.start();
+        for (size_t r = 0; r < repeats; ++r) {
+            for (auto f : mesh.faces) {
+                for (auto h = d.half_edge_loop_begin(d[f].incident); h != d.half_edge_loop_end(d[f].incident); ++h)
+                    area += dot_perp(position[h->origin], position[h->next->origin]) / 2;
+            }
+            for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h)
+                length += mtlib::length(position[h->twin->origin] - position[h->origin]);
+        }
+        timer.stop();
+        cout << "  dcel_list with std::unordered_map: " << 1000 * timer.elapsed_seconds() / repeats << " ms, area "
+             << area / repeats << ", length " << length / repeats << "\n";
+    }
+
+    {
+        auto mesh = ds::dcel_from_polygons<ds::dcel_vector_data_Traits<vec2d>>(points, indices, offsets, 1);
+        auto& d = mesh.dcel;
+
+        double area = 0;
+        double length = 0;
+        timer.start();
+        for (size_t r = 0; r < repeats; ++r) {
+            for (auto f : mesh.faces)
+                area += ds::face_area_2D(d, f);
+            for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h)
+                length += ds::edge_length(d, d.handle_of(*h));
+        }
+        timer.stop();
+        cout << "  dcel_vector_data_Traits<vec2d>:    " << 1000 * timer.elapsed_seconds() / repeats << " ms, area "
+             << area / repeats << ", length " << length / repeats << "\n";
+    }
+
+    return 0;
+}
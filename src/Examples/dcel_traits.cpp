@@ -0,0 +1,162 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+namespace {
+
+/**
+ * Builds a grid of k x k quads, half-edges 2e and 2e + 1 are the two sides of edge e.  The horizontal edges come
+ * first, the even half-edge of an edge points in the positive direction.
+ */
+template <typename Traits>
+void build_grid(ds::dcel<Traits>& d, size_t k) {
+    const size_t n_horizontal = k * (k + 1);
+    const size_t n_half_edges = 4 * k * (k + 1);
+    d.reserve((k + 1) * (k + 1), n_half_edges, k * k + 1);
+
+    vector<typename Traits::vertex_handle> vertices((k + 1) * (k + 1));
+    for (auto& v : vertices)
+        v = d.create_vertex();
+    vector<typename Traits::half_edge_handle> half_edges(n_half_edges);
+    for (auto& h : half_edges)
+        h = d.create_half_edge();
+    // scatter the records as edits would, instead of laying them out in the order they are linked
+    shuffle(half_edges.begin(), half_edges.end(), mt19937(0));
+
+    const auto vertex = [&](size_t i, size_t j) { return vertices[j * (k + 1) + i]; };
+    const auto horizontal = [&](size_t i, size_t j, bool reverse) { return 2 * (j * k + i) + reverse; };
+    const auto vertical = [&](size_t i, size_t j, bool reverse) {
+        return 2 * (n_horizontal + j * (k + 1) + i) + reverse;
+    };
+    const auto set_edge = [&](size_t e, typename Traits::vertex_handle from, typename Traits::vertex_handle to) {
+        d[half_edges[e]].origin = from;
+        d[half_edges[e]].twin = half_edges[e + 1];
+        d[half_edges[e + 1]].origin = to;
+        d[half_edges[e + 1]].twin = half_edges[e];
+        d[from].incident = half_edges[e];
+    };
+    const auto set_loop = [&](const vector<size_t>& loop) {
+        const auto face = d.create_face();
+        d[face].incident = half_edges[loop[0]];
+        for (size_t i = 0; i < loop.size(); ++i) {
+            auto& h = d[half_edges[loop[i]]];
+            h.next = half_edges[loop[(i + 1) % loop.size()]];
+            h.prev = half_edges[loop[(i + loop.size() - 1) % loop.size()]];
+            h.face = face;
+        }
+    };
+
+    for (size_t j = 0; j <= k; ++j) {
+        for (size_t i = 0; i < k; ++i)
+            set_edge(horizontal(i, j, false), vertex(i, j), vertex(i + 1, j));
+    }
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t i = 0; i <= k; ++i)
+            set_edge(vertical(i, j, false), vertex(i, j), vertex(i, j + 1));
+    }
+
+    vector<size_t> loop(4);
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t i = 0; i < k; ++i) {
+            loop = { horizontal(i, j, false), vertical(i + 1, j, false), horizontal(i, j + 1, true),
+                     vertical(i, j, true) };
+            set_loop(loop);
+        }
+    }
+
+    // the outer face runs clockwise around the grid
+    loop.clear();
+    for (size_t i = k; i-- > 0;)
+        loop.push_back(horizontal(i, 0, true));
+    for (size_t j = 0; j < k; ++j)
+        loop.push_back(vertical(0, j, false));
+    for (size_t i = 0; i < k; ++i)
+        loop.push_back(horizontal(i, k, false));
+    for (size_t j = k; j-- > 0;)
+        loop.push_back(vertical(k, j, true));
+    set_loop(loop);
+}
+
+/**
+ * Walks the boundary of every face and checks the links of each half-edge on the way, returns the number of
+ * consistent half-edges.
+ */
+template <typename Dcel>
+size_t traverse_faces(const Dcel& d) {
+    size_t n = 0;
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f) {
+        for (auto h = d.half_edge_loop_begin(f->incident); h != d.half_edge_loop_end(f->incident); ++h)
+            n += d[h->twin].origin == d[h->next].origin;
+    }
+    return n;
+}
+
+template <typename Traits>
+void run(const char* name, size_t k, size_t repeats) {
+    performance_timer timer;
+    timer.start();
+    ds::dcel<Traits> d;
+    build_grid(d, k);
+    timer.stop();
+    const double construction = timer.elapsed_seconds();
+
+    size_t n = 0;
+    timer.start();
+    for (size_t r = 0; r < repeats; ++r)
+        n += traverse_faces(d);
+    timer.stop();
+
+    cout << "  " << name << ": construction " << 1000 * construction << " ms, face traversal "
+         << 1000 * timer.elapsed_seconds() / repeats << " ms" << (n == repeats * d.half_edges_size() ? "" : " (wrong)")
+         << "\n";
+
+    timer.start();
+    const auto frozen = ds::freeze(d);
+    timer.stop();
+    const double freezing = timer.elapsed_seconds();
+
+    n = 0;
+    timer.start();
+    for (size_t r = 0; r < repeats; ++r)
+        n += traverse_faces(frozen);
+    timer.stop();
+
+    cout << "  frozen     : freeze " << 1000 * freezing << " ms, face traversal "
+         << 1000 * timer.elapsed_seconds() / repeats << " ms"
+         << (n == repeats * frozen.half_edges_size() ? "" : " (wrong)") << "\n";
+}
+
+}   // namespace
+
+/**
+ * Builds quad grids of about 10^6 and 10^7 half-edges with the std::list and the vector backed DCEL traits, and times
+ * the construction and a walk around the boundary of every face.  Then freezes each of them and times the same walk on
+ * the frozen_dcel.
+ *
+ * usage: dcel_traits [largest grid side] [traversal repeats]
+ */
+int main(int argc, char* argv[]) {
+    size_t max_k = 1600;
+    size_t repeats = 5;
+    if (argc > 1)
+        max_k = static_cast<size_t>(atoi(argv[1]));
+    if (argc > 2)
+        repeats = static_cast<size_t>(atoi(argv[2]));
+
+    for (size_t k = 500; k <= max_k; k = k * 16 / 5) {
+        cout << k << " x " << k << " grid, " << 4 * k * (k + 1) << " half-edges\n";
+        run<ds::dcel_list_Traits>("dcel_list  ", k, repeats);
+        run<ds::dcel_vector_Traits>("dcel_vector", k, repeats);
+    }
+
+    return 0;
+}
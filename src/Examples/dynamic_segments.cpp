@@ -0,0 +1,82 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Loads short random segments into a dynamic_segments_2D and replaces random segments one at a time, as an editor
+ * would.  Reports edits per second, each edit being one erase and one insert, against recomputing every intersection
+ * with segment_grid_2D after an edit.
+ *
+ * usage: dynamic_segments [segments] [edits]
+ */
+int main(int argc, char* argv[]) {
+    int n_segments = 500000;
+    int n_edits = 100000;
+    if (argc > 1)
+        n_segments = atoi(argv[1]);
+    if (argc > 2)
+        n_edits = atoi(argv[2]);
+
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(0, 10000);
+    uniform_real_distribution<double> offset(-10, 10);
+    auto random_segment = [&]() {
+        vec2d p(dis(gen), dis(gen));
+        return segment2d(p, p + vec2d(offset(gen), offset(gen)));
+    };
+
+    vector<segment2d> segments;
+    for (int i = 0; i < n_segments; ++i)
+        segments.push_back(random_segment());
+
+    performance_timer timer;
+    intersection::dynamic_segments_2D<double> set;
+    timer.start();
+    set.assign(segments.begin(), segments.end());
+    timer.stop();
+    const double load_time = timer.elapsed_seconds();
+    const size_t n_loaded = set.n_intersections();
+
+    vector<uint32_t> live;
+    for (int i = 0; i < n_segments; ++i)
+        live.push_back(i);
+    uniform_int_distribution<size_t> pick(0, live.size() - 1);
+
+    timer.start();
+    for (int edit = 0; edit < n_edits; ++edit) {
+        const auto k = pick(gen);
+        set.erase(live[k]);
+        live[k] = set.insert(random_segment());
+    }
+    timer.stop();
+    const double edit_time = timer.elapsed_seconds();
+
+    for (size_t k = 0; k < live.size(); ++k)
+        segments[k] = set.segment(live[k]);
+
+    vector<uint32_t> indices;
+    vector<pair<vec2d, span<const uint32_t>>> events;
+    intersection::segment_grid_2D<double> grid;
+    timer.start();
+    grid(segments.begin(), segments.end(), indices, back_inserter(events));
+    timer.stop();
+    const double grid_time = timer.elapsed_seconds();
+
+    cout << n_segments << " segments\n"
+         << "  load:           " << load_time << " s, " << n_loaded << " intersections\n"
+         << "  edits:          " << n_edits / edit_time << " edits/s, "
+         << 1e6 * edit_time / n_edits << " us/edit, " << set.n_intersections() << " intersections after\n"
+         << "  grid recompute: " << grid_time << " s, " << events.size() << " events, "
+         << grid_time * n_edits / edit_time << "x an edit\n";
+
+    return 0;
+}
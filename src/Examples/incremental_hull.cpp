@@ -0,0 +1,95 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * A stream of telemetry points kept in an incremental_hull_2d: the cost of an insert, of containment and extreme
+ * point queries and of a snapshot, against rebuilding the hull of the whole buffer with chull_graham_2d, for points
+ * spread uniformly and for points on a circle, which all become hull vertices.
+ *
+ * usage: incremental_hull [points] [queries]
+ */
+int main(int argc, char* argv[]) {
+    size_t n = 1000000;
+    size_t n_queries = 1000000;
+    if (argc > 1)
+        n = atoll(argv[1]);
+    if (argc > 2)
+        n_queries = atoll(argv[2]);
+
+    mt19937 gen(1);
+    uniform_real_distribution<double> unit(-1.0, 1.0);
+
+    const auto run = [&](const string& name, const vector<vec2d>& points) {
+        incremental_hull_2d<double> hull;
+        performance_timer timer;
+
+        timer.start();
+        for (const auto& p : points)
+            hull.insert(p);
+        timer.stop();
+        const auto insert = timer.elapsed_seconds();
+
+        vector<vec2d> queries(n_queries);
+        for (auto& q : queries)
+            q = vec2d(1.2 * unit(gen), 1.2 * unit(gen));
+        size_t inside = 0;
+        timer.start();
+        for (const auto& q : queries)
+            inside += hull.contains(q);
+        timer.stop();
+        const auto contains = timer.elapsed_seconds();
+
+        double sum = 0.0;
+        timer.start();
+        for (const auto& q : queries)
+            sum += dot(q, hull.extreme(q));
+        timer.stop();
+        const auto extreme = timer.elapsed_seconds();
+
+        vector<vec2d> snapshot;
+        snapshot.reserve(hull.size());
+        timer.start();
+        hull.snapshot(back_inserter(snapshot));
+        timer.stop();
+        const auto export_time = timer.elapsed_seconds();
+
+        chull_scratch_2d<double> scratch;
+        vector<vec2d> rebuilt;
+        timer.start();
+        chull_graham_2d(points.begin(), points.end(), back_inserter(rebuilt), scratch);
+        timer.stop();
+        const auto rebuild = timer.elapsed_seconds();
+
+        cout << name << ": " << n << " points, h " << hull.size() << (rebuilt == snapshot ? "" : " (differs)") << endl
+             << "  insert   " << insert / n * 1e9 << " ns/point" << endl
+             << "  contains " << contains / n_queries * 1e9 << " ns/query (" << inside << " inside)" << endl
+             << "  extreme  " << extreme / n_queries * 1e9 << " ns/query (" << sum << ")" << endl
+             << "  snapshot " << export_time * 1e6 << " us" << endl
+             << "  rebuild  " << rebuild * 1e3 << " ms" << endl;
+    };
+
+    vector<vec2d> points(n);
+    for (auto& p : points)
+        p = vec2d(unit(gen), unit(gen));
+    run("uniform", points);
+
+    for (auto& p : points) {
+        const double a = M_PI * unit(gen);
+        p = vec2d(cos(a), sin(a));
+    }
+    run("on circle", points);
+
+    return 0;
+}
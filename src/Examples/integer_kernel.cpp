@@ -0,0 +1,179 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Compares the integer kernel with the floating point one on millimetre coordinates in a 100 km square: the same
+ * points as int32_t, int64_t and double, the doubles under plain_predicates and adaptive_predicates.  Times
+ * orientation_2D on random and on nearly colinear triples, intersect_segment_segment_2D on pairs of short segments and
+ * chull_graham_2d.
+ *
+ * usage: integer_kernel [triples] [repetitions]
+ */
+template <typename Scalar>
+vector<vec2<Scalar>> convert(const vector<vec2<int32_t>>& points) {
+    vector<vec2<Scalar>> result;
+    result.reserve(points.size());
+    for (const auto& p : points)
+        result.emplace_back((Scalar)p[0], (Scalar)p[1]);
+    return result;
+}
+
+template <typename Predicates, typename Scalar>
+double time_orientation(const vector<vec2<Scalar>>& points, int n_repetitions, int& checksum) {
+    const size_t n = points.size() / 3;
+    performance_timer timer;
+    checksum = 0;
+    timer.start();
+    for (int r = 0; r < n_repetitions; ++r) {
+        for (size_t i = 0; i < n; ++i)
+            checksum += Predicates::orientation_2D(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+    }
+    timer.stop();
+    return timer.elapsed_seconds() / n_repetitions / n;
+}
+
+template <typename Predicates, typename Scalar>
+double time_intersections(const vector<vec2<Scalar>>& points, int n_repetitions, int& checksum) {
+    const size_t n = points.size() / 4;
+    performance_timer timer;
+    checksum = 0;
+    timer.start();
+    for (int r = 0; r < n_repetitions; ++r) {
+        for (size_t i = 0; i < n; ++i) {
+            const segment2<Scalar> s1(points[4 * i], points[4 * i + 1]);
+            const segment2<Scalar> s2(points[4 * i + 2], points[4 * i + 3]);
+            const auto [result, success] = intersect_segment_segment_2D(s1, s2, Predicates());
+            checksum += success ? 1 + (result.point[0] > (Scalar)0) : 0;
+        }
+    }
+    timer.stop();
+    return timer.elapsed_seconds() / n_repetitions / n;
+}
+
+template <typename Predicates, typename Scalar>
+double time_hull(const vector<vec2<Scalar>>& points, size_t& hull_size) {
+    vector<vec2<Scalar>> hull;
+    performance_timer timer;
+    timer.start();
+    chull_graham_2d(points.begin(), points.end(), back_inserter(hull), Predicates());
+    timer.stop();
+    hull_size = hull.size();
+    return timer.elapsed_seconds();
+}
+
+template <typename Timer>
+void report(const char* name, const char* unit, double scale, Timer time) {
+    int checksum;
+    const double int32_time = time(plain_predicates(), int32_t(), checksum);
+    cout << name << ":\n"
+         << "  int32_t:           " << scale * int32_time << unit << " (" << checksum << ")\n";
+    const double int64_time = time(plain_predicates(), int64_t(), checksum);
+    cout << "  int64_t:           " << scale * int64_time << unit << " (" << checksum << ")\n";
+    const double plain_time = time(plain_predicates(), double(), checksum);
+    cout << "  double, plain:     " << scale * plain_time << unit << " (" << checksum << ")\n";
+    const double adaptive_time = time(adaptive_predicates(), double(), checksum);
+    cout << "  double, adaptive:  " << scale * adaptive_time << unit << " (" << checksum << "), "
+         << adaptive_time / int32_time << "x int32_t\n";
+}
+
+int main(int argc, char* argv[]) {
+    int n_triples = 100000;
+    int n_repetitions = 100;
+    if (argc > 1)
+        n_triples = atoi(argv[1]);
+    if (argc > 2)
+        n_repetitions = atoi(argv[2]);
+
+    mt19937 gen(0);
+    const int32_t side = 100000000;
+    uniform_int_distribution<int32_t> dis(0, side);
+
+    vector<vec2<int32_t>> points;
+    for (int i = 0; i < 3 * n_triples; ++i)
+        points.emplace_back(dis(gen), dis(gen));
+
+    auto orientation = [&](const vector<vec2<int32_t>>& triples) {
+        const auto as_int64 = convert<int64_t>(triples);
+        const auto as_double = convert<double>(triples);
+        return [&, as_int64, as_double](auto predicates, auto scalar, int& checksum) {
+            using Predicates = decltype(predicates);
+            using Scalar = decltype(scalar);
+            if constexpr (is_same<Scalar, int32_t>::value)
+                return time_orientation<Predicates>(triples, n_repetitions, checksum);
+            else if constexpr (is_same<Scalar, int64_t>::value)
+                return time_orientation<Predicates>(as_int64, n_repetitions, checksum);
+            else
+                return time_orientation<Predicates>(as_double, n_repetitions, checksum);
+        };
+    };
+    report("orientation_2D, random", " ns", 1e9, orientation(points));
+
+    // survey points one millimetre either side of a long straight boundary
+    vector<vec2<int32_t>> colinear;
+    uniform_int_distribution<int32_t> along(0, side / 3);
+    uniform_int_distribution<int32_t> off(-1, 1);
+    for (int i = 0; i < n_triples; ++i) {
+        colinear.emplace_back(0, 0);
+        colinear.emplace_back(3 * (side / 3), 2 * (side / 3));
+        const int32_t t = along(gen);
+        colinear.emplace_back(3 * t + off(gen), 2 * t + off(gen));
+    }
+    report("orientation_2D, nearly colinear", " ns", 1e9, orientation(colinear));
+
+    // pairs of segments up to 20 m long
+    vector<vec2<int32_t>> ends;
+    uniform_int_distribution<int32_t> offset(-20000, 20000);
+    uniform_int_distribution<int32_t> near(0, side / 1000);
+    for (int i = 0; i < n_triples; ++i) {
+        const vec2<int32_t> p(near(gen), near(gen));
+        ends.push_back(p);
+        ends.emplace_back(p[0] + offset(gen), p[1] + offset(gen));
+        const vec2<int32_t> q(p[0] + offset(gen) / 2, p[1] + offset(gen) / 2);
+        ends.push_back(q);
+        ends.emplace_back(q[0] + offset(gen), q[1] + offset(gen));
+    }
+    const auto ends_int64 = convert<int64_t>(ends);
+    const auto ends_double = convert<double>(ends);
+    report("intersect_segment_segment_2D", " ns", 1e9, [&](auto predicates, auto scalar, int& checksum) {
+        using Predicates = decltype(predicates);
+        using Scalar = decltype(scalar);
+        if constexpr (is_same<Scalar, int32_t>::value)
+            return time_intersections<Predicates>(ends, n_repetitions / 4 + 1, checksum);
+        else if constexpr (is_same<Scalar, int64_t>::value)
+            return time_intersections<Predicates>(ends_int64, n_repetitions / 4 + 1, checksum);
+        else
+            return time_intersections<Predicates>(ends_double, n_repetitions / 4 + 1, checksum);
+    });
+
+    // hulls of a million random points
+    points.resize(1000000);
+    for (auto& p : points)
+        p = vec2<int32_t>(dis(gen), dis(gen));
+    const auto points_int64 = convert<int64_t>(points);
+    const auto points_double = convert<double>(points);
+    report("chull_graham_2d of 1000000 points", " ms", 1e3, [&](auto predicates, auto scalar, int& checksum) {
+        using Predicates = decltype(predicates);
+        using Scalar = decltype(scalar);
+        size_t hull_size;
+        double time;
+        if constexpr (is_same<Scalar, int32_t>::value)
+            time = time_hull<Predicates>(points, hull_size);
+        else if constexpr (is_same<Scalar, int64_t>::value)
+            time = time_hull<Predicates>(points_int64, hull_size);
+        else
+            time = time_hull<Predicates>(points_double, hull_size);
+        checksum = static_cast<int>(hull_size);
+        return time;
+    });
+
+    return 0;
+}
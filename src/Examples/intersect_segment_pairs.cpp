@@ -0,0 +1,85 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Tests a candidate pair list of short random segments with intersect_segment_pairs_2D and with a loop over
+ * intersect_segment_segment_2D, and reports pairs per second for both.
+ *
+ * Configure with -DNATIVE_ARCH=ON for the AVX2 kernels.
+ *
+ * usage: intersect_segment_pairs [segments] [pairs]
+ */
+template <typename Scalar>
+void run(const char* name, int n_segments, int n_pairs) {
+    mt19937 gen(0);
+    uniform_real_distribution<Scalar> dis(0, 100);
+    uniform_real_distribution<Scalar> offset(-5, 5);
+
+    vector<segment2<Scalar>> segments;
+    for (int i = 0; i < n_segments; ++i) {
+        vec2<Scalar> p(dis(gen), dis(gen));
+        segments.emplace_back(p, p + vec2<Scalar>(offset(gen), offset(gen)));
+    }
+    const intersection::segments_soa_2D<Scalar> soa(segments.begin(), segments.end());
+
+    // broad-phase like candidates, pairs of nearby segments
+    uniform_int_distribution<int> segment(0, n_segments - 1);
+    uniform_int_distribution<int> nearby(-64, 64);
+    vector<uint32_t> first;
+    vector<uint32_t> second;
+    first.reserve(n_pairs);
+    second.reserve(n_pairs);
+    for (int k = 0; k < n_pairs; ++k) {
+        const int i = segment(gen);
+        first.push_back(i);
+        second.push_back(std::clamp(i + nearby(gen), 0, n_segments - 1));
+    }
+
+    performance_timer timer;
+    vector<intersection::pair_hit_2D<Scalar>> hits;
+    hits.reserve(n_pairs);
+
+    timer.start();
+    for (size_t k = 0; k < first.size(); ++k) {
+        const auto[result, success] = intersect_segment_segment_2D(segments[first[k]], segments[second[k]]);
+        if (success)
+            hits.push_back({static_cast<uint32_t>(k), result.t1, result.t2});
+    }
+    timer.stop();
+    const double scalar_time = timer.elapsed_seconds();
+    const size_t scalar_hits = hits.size();
+
+    hits.clear();
+    timer.start();
+    intersect_segment_pairs_2D(soa, span<const uint32_t>(first), span<const uint32_t>(second), hits);
+    timer.stop();
+    const double batch_time = timer.elapsed_seconds();
+
+    cout << name << ", " << intersection::intersect_segment_pairs_isa() << ":\n"
+         << "  scalar loop: " << n_pairs / scalar_time << " pairs/s, " << scalar_hits << " hits\n"
+         << "  batched:     " << n_pairs / batch_time << " pairs/s, " << hits.size() << " hits, "
+         << scalar_time / batch_time << "x\n";
+}
+
+int main(int argc, char* argv[]) {
+    int n_segments = 100000;
+    int n_pairs = 10000000;
+    if (argc > 1)
+        n_segments = atoi(argv[1]);
+    if (argc > 2)
+        n_pairs = atoi(argv[2]);
+
+    run<float>("float", n_segments, n_pairs);
+    run<double>("double", n_segments, n_pairs);
+
+    return 0;
+}
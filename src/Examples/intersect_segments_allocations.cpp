@@ -0,0 +1,90 @@
+#include <MTLib/mtlib.h>
+
+#include "common/counting_allocator.h"
+#include "common/performance_timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Counts the events of a sweep without storing them.
+ */
+struct counting_iterator {
+    using iterator_category = output_iterator_tag;
+    using value_type = void;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    size_t* count;
+
+    counting_iterator& operator*() { return *this; }
+    counting_iterator& operator++() { return *this; }
+    counting_iterator operator++(int) { return *this; }
+
+    template <typename T>
+    counting_iterator& operator=(const T&) {
+        ++*count;
+        return *this;
+    }
+};
+
+/**
+ * Reports the heap allocations per input segment of a cold sweep and of sweeps on an engine that has already
+ * seen an input of the same size.
+ *
+ * usage: intersect_segments_allocations [segments] [rounds]
+ */
+int main(int argc, char* argv[]) {
+    int n_segments = 10000;
+    int n_rounds = 8;
+    if (argc > 1)
+        n_segments = atoi(argv[1]);
+    if (argc > 2)
+        n_rounds = atoi(argv[2]);
+
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(0.0, 1000.0);
+    uniform_real_distribution<double> offset(-20.0, 20.0);
+
+    vector<vector<segment2d>> inputs(n_rounds + 1);
+    for (auto& input : inputs) {
+        input.reserve(n_segments);
+        for (int i = 0; i < n_segments; ++i) {
+            vec2d p(dis(gen), dis(gen));
+            input.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+        }
+    }
+
+    intersection::segment_sweep_2D<double> sweep;
+    size_t events = 0;
+
+    performance_timer timer;
+    timer.start();
+    size_t before = heap_allocations;
+    sweep(inputs[0].begin(), inputs[0].end(), counting_iterator {&events});
+    size_t cold = heap_allocations - before;
+    timer.stop();
+
+    cout << "cold:   " << (double)cold / n_segments << " allocations/segment, "
+         << events << " events, " << timer.elapsed_seconds() << " s\n";
+
+    for (int round = 1; round <= n_rounds; ++round) {
+        events = 0;
+        timer.start();
+        before = heap_allocations;
+        sweep(inputs[round].begin(), inputs[round].end(), counting_iterator {&events});
+        size_t warm = heap_allocations - before;
+        timer.stop();
+
+        cout << "warm " << round << ": " << (double)warm / n_segments << " allocations/segment, "
+             << events << " events, " << timer.elapsed_seconds() << " s\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Random segments of the given length, with random directions or, like hatch lines, all horizontal.
+ */
+static vector<segment2d> random_segments(int n, double size, double length, bool hatch) {
+    const double pi = acos(-1.0);
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(0.0, size);
+    uniform_real_distribution<double> angle(0.0, pi);
+
+    vector<segment2d> segments;
+    segments.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const vec2d p(dis(gen), dis(gen));
+        const double a = hatch ? 0.0 : angle(gen);
+        segments.emplace_back(p, p + vec2d(length * cos(a), length * sin(a)));
+    }
+    return segments;
+}
+
+/**
+ * Alternately horizontal and vertical segments of the given length with integer endpoints, so that where they overlap
+ * dozens of them meet at each point.
+ */
+static vector<segment2d> lattice_segments(int n, double size, double length) {
+    mt19937 gen(0);
+    uniform_int_distribution<int> dis(0, static_cast<int>(size));
+    const double rounded_length = max(1.0, round(length));
+
+    vector<segment2d> segments;
+    segments.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const vec2d p(dis(gen), dis(gen));
+        segments.emplace_back(p, p + (i % 2 == 0 ? vec2d(rounded_length, 0.0) : vec2d(0.0, rounded_length)));
+    }
+    return segments;
+}
+
+/**
+ * Times the sweep and the grid on segments of increasing length and shows which one
+ * intersection::prefer_grid_2D picks.  Lengths are given relative to the mean spacing sqrt(area / n).
+ *
+ * usage: intersect_segments_crossover [segments]
+ */
+int main(int argc, char* argv[]) {
+    int n_segments = 20000;
+    if (argc > 1)
+        n_segments = atoi(argv[1]);
+
+    const double size = 1000.0;
+    const double spacing = sqrt(size * size / n_segments);
+
+    cout << "directions, length/spacing, events, sweep s, grid s, sweep/grid, picks\n";
+    for (const char* directions : {"random", "hatch", "lattice"})
+    for (double relative_length : {0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0}) {
+        const string kind = directions;
+        const auto segments = kind == "lattice"
+            ? lattice_segments(n_segments, size / 10.0, relative_length * spacing / 10.0)
+            : random_segments(n_segments, size, relative_length * spacing, kind == "hatch");
+
+        performance_timer timer;
+        vector<intersection::segment_index> indices;
+        vector<pair<vec2d, span<const intersection::segment_index>>> events;
+
+        intersection::segment_sweep_2D<double> sweep;
+        timer.start();
+        sweep(segments.begin(), segments.end(), indices, back_inserter(events));
+        timer.stop();
+        const double sweep_time = timer.elapsed_seconds();
+        const size_t n_events = events.size();
+
+        indices.clear();
+        events.clear();
+        intersection::segment_grid_2D<double> grid;
+        timer.start();
+        grid(segments.begin(), segments.end(), indices, back_inserter(events));
+        timer.stop();
+        const double grid_time = timer.elapsed_seconds();
+
+        cout << kind << ", "
+             << relative_length << ", "
+             << n_events << ", "
+             << sweep_time << ", "
+             << grid_time << ", "
+             << sweep_time / grid_time << ", "
+             << (intersection::prefer_grid_2D(segments.begin(), segments.end()) ? "grid" : "sweep") << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>  // memcpy
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Writes files of 1, 2, 4, ... million short random segments and intersects each with intersect_segments_external_2D
+ * and, for comparison, by loading it into memory for intersect_segments_2D.  Every run happens in its own process so
+ * its peak resident set size can be reported; the external one should stay flat as the input grows.
+ *
+ * usage: intersect_segments_external [millions of segments, largest] [memory budget in MiB] [directory]
+ */
+
+// runs f in a child process, returns the child's peak RSS in MiB and its time in seconds
+template <typename F>
+pair<double, double> measure(F f) {
+    performance_timer timer;
+    timer.start();
+    const pid_t pid = fork();
+    if (pid == 0)
+        _exit(f() ? 0 : 1);
+
+    int status = 0;
+    rusage usage;
+    wait4(pid, &status, 0, &usage);
+    timer.stop();
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        cerr << "run failed\n";
+    return {usage.ru_maxrss / 1024.0, timer.elapsed_seconds()};
+}
+
+int main(int argc, char* argv[]) {
+    int max_millions = 4;
+    size_t budget_mib = 64;
+    string directory = "/tmp";
+    if (argc > 1)
+        max_millions = atoi(argv[1]);
+    if (argc > 2)
+        budget_mib = static_cast<size_t>(atoi(argv[2]));
+    if (argc > 3)
+        directory = argv[3];
+
+    const string segment_path = directory + "/mtlib_external_segments.bin";
+    const string report_path = directory + "/mtlib_external_reports.bin";
+
+    cout << "memory budget " << budget_mib << " MiB\n";
+    for (int millions = 1; millions <= max_millions; millions *= 2) {
+        const size_t n = static_cast<size_t>(millions) * 1000000;
+
+        // the square grows with the input, so the density of the segments stays the same
+        const double side = 10.0 * sqrt(static_cast<double>(n));
+        mt19937 gen(0);
+        uniform_real_distribution<double> dis(0, side);
+        uniform_real_distribution<double> offset(-10, 10);
+        vector<segment2d> block;
+        FILE* file = fopen(segment_path.c_str(), "wb");
+        for (size_t i = 0; i < n; ++i) {
+            vec2d p(dis(gen), dis(gen));
+            const vec2d q = p + vec2d(offset(gen), offset(gen));
+            const double record[4] = {p[0], p[1], q[0], q[1]};
+            fwrite(record, sizeof(double), 4, file);
+        }
+        fclose(file);
+
+        const auto external = measure([&]() {
+            return intersect_segments_external_2D<double>(segment_path, report_path, budget_mib << 20);
+        });
+
+        size_t n_reports = 0;
+        visit_intersection_reports_2D<double>(report_path, [&](const vec2d&, span<const uint32_t>) { ++n_reports; });
+
+        const auto in_memory = measure([&]() {
+            mapped_file input(segment_path);
+            vector<segment2d> segments(n);
+            for (size_t i = 0; i < n; ++i) {
+                double record[4];
+                memcpy(record, input.data() + i * sizeof(record), sizeof(record));
+                segments[i] = segment2d(vec2d(record[0], record[1]), vec2d(record[2], record[3]));
+            }
+            input.close();
+
+            size_t n_events = 0;
+            visit_intersections_2D(segments.begin(), segments.end(),
+                [&](const vec2d&, span<const uint32_t>) { ++n_events; });
+            return n_events == n_reports;
+        });
+
+        cout << n << " segments, " << n_reports << " intersections\n"
+             << "  external:  " << external.first << " MiB peak RSS, " << external.second << " s\n"
+             << "  in memory: " << in_memory.first << " MiB peak RSS, " << in_memory.second << " s\n";
+    }
+
+    remove(segment_path.c_str());
+    remove(report_path.c_str());
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Times intersect_segments_parallel_2D on 1, 2, 4, 8 and 16 threads against the sequential sweep of the same input.
+ *
+ * usage: intersect_segments_parallel [segments]
+ */
+int main(int argc, char* argv[]) {
+    int n_segments = 200000;
+    if (argc > 1)
+        n_segments = atoi(argv[1]);
+
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(0.0, 10000.0);
+    uniform_real_distribution<double> offset(-20.0, 20.0);
+
+    vector<segment2d> segments;
+    segments.reserve(n_segments);
+    for (int i = 0; i < n_segments; ++i) {
+        vec2d p(dis(gen), dis(gen));
+        segments.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+    }
+
+    performance_timer timer;
+    vector<intersection::segment_index> expected_indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> expected;
+
+    timer.start();
+    intersect_segments_2D(segments.begin(), segments.end(), expected_indices, back_inserter(expected));
+    timer.stop();
+    const double sequential = timer.elapsed_seconds();
+    cout << "sequential: " << sequential << " s, " << expected.size() << " events\n";
+
+    for (size_t n_threads : {1, 2, 4, 8, 16}) {
+        vector<intersection::segment_index> indices;
+        vector<pair<vec2d, span<const intersection::segment_index>>> events;
+
+        timer.start();
+        intersect_segments_parallel_2D(segments.begin(), segments.end(), indices, back_inserter(events), n_threads);
+        timer.stop();
+
+        const bool match = indices == expected_indices && events.size() == expected.size();
+        cout << n_threads << " threads: "
+             << timer.elapsed_seconds() << " s, "
+             << sequential / timer.elapsed_seconds() << "x, "
+             << events.size() << " events"
+             << (match ? "" : ", MISMATCH") << "\n";
+    }
+
+    return 0;
+}
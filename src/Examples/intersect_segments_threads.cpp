@@ -0,0 +1,84 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Runs one sweep per tile on 1, 2, 4, ... threads and reports the throughput at each thread count.
+ *
+ * usage: intersect_segments_threads [tiles] [segments per tile]
+ */
+int main(int argc, char* argv[]) {
+    int n_tiles = 64;
+    int n_segments = 2000;
+    if (argc > 1)
+        n_tiles = atoi(argv[1]);
+    if (argc > 2)
+        n_segments = atoi(argv[2]);
+
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(0.0, 1000.0);
+    uniform_real_distribution<double> offset(-20.0, 20.0);
+
+    vector<vector<segment2d>> tiles(n_tiles);
+    for (auto& tile : tiles) {
+        tile.reserve(n_segments);
+        for (int i = 0; i < n_segments; ++i) {
+            vec2d p(dis(gen), dis(gen));
+            tile.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+        }
+    }
+
+    const unsigned int max_threads = max(1u, thread::hardware_concurrency());
+    double single_thread_rate = 0.0;
+
+    for (unsigned int n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        vector<size_t> events(n_threads, 0);
+
+        performance_timer timer;
+        timer.start();
+
+        vector<thread> threads;
+        for (unsigned int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                intersection::segment_sweep_2D<double> sweep;
+                vector<pair<vec2d, vector<segment2d>>> intersections;
+                for (size_t i = t; i < tiles.size(); i += n_threads) {
+                    intersections.clear();
+                    sweep(tiles[i].begin(), tiles[i].end(), back_inserter(intersections));
+                    events[t] += intersections.size();
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        timer.stop();
+
+        const double rate = n_tiles / timer.elapsed_seconds();
+        if (n_threads == 1)
+            single_thread_rate = rate;
+
+        size_t total_events = 0;
+        for (auto e : events)
+            total_events += e;
+
+        cout << n_threads << " threads: "
+             << rate << " tiles/s, "
+             << rate / single_thread_rate << "x, "
+             << total_events << " events\n";
+
+        if (n_threads < max_threads && n_threads * 2 > max_threads)
+            n_threads = max_threads / 2;
+    }
+
+    return 0;
+}
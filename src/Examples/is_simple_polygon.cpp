@@ -0,0 +1,108 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Simplicity test built on the full sweep: every event other than two consecutive edges meeting at their shared
+ * vertex makes the polygon not simple.
+ */
+static bool is_simple_full_sweep(const vector<vec2d>& polygon) {
+    const size_t n = polygon.size();
+    vector<segment2d> edges;
+    for (size_t i = 0; i < n; ++i)
+        edges.emplace_back(polygon[i], polygon[(i + 1) % n]);
+
+    vector<intersection::segment_index> indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> events;
+    intersect_segments_2D(edges.begin(), edges.end(), indices, back_inserter(events));
+
+    for (const auto& [point, through] : events) {
+        if (through.size() != 2)
+            return false;
+        const auto lhs = through[0];
+        const auto rhs = through[1];
+        if (rhs == lhs + 1 && point == polygon[rhs])
+            continue;
+        if (lhs == 0 && rhs == n - 1 && point == polygon[0])
+            continue;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Star shaped polygon with random radii, simple by construction.
+ */
+static vector<vec2d> random_star(size_t n, mt19937& gen) {
+    const double pi = acos(-1.0);
+    uniform_real_distribution<double> radius(10.0, 100.0);
+
+    vector<vec2d> polygon;
+    for (size_t i = 0; i < n; ++i) {
+        const double angle = 2.0 * pi * i / n;
+        const double r = radius(gen);
+        polygon.emplace_back(r * cos(angle), r * sin(angle));
+    }
+    return polygon;
+}
+
+/**
+ * Compares is_simple_polygon_2d to a simplicity test on the full sweep, for simple star shaped polygons and for
+ * the same polygons with two vertices swapped.
+ *
+ * usage: is_simple_polygon [polygons] [vertices]
+ */
+int main(int argc, char* argv[]) {
+    int n_polygons = 200;
+    int n_vertices = 2000;
+    if (argc > 1)
+        n_polygons = atoi(argv[1]);
+    if (argc > 2)
+        n_vertices = atoi(argv[2]);
+
+    mt19937 gen(0);
+    uniform_int_distribution<int> vertex(0, n_vertices - 1);
+
+    vector<vector<vec2d>> simple;
+    vector<vector<vec2d>> not_simple;
+    for (int i = 0; i < n_polygons; ++i) {
+        simple.push_back(random_star(n_vertices, gen));
+        not_simple.push_back(simple.back());
+        swap(not_simple.back()[vertex(gen)], not_simple.back()[vertex(gen)]);
+    }
+
+    for (const auto* polygons : {&simple, &not_simple}) {
+        cout << (polygons == &simple ? "simple" : "not simple") << ", "
+             << n_polygons << " polygons of " << n_vertices << " vertices\n";
+
+        size_t count = 0;
+        performance_timer timer;
+        timer.start();
+        for (const auto& polygon : *polygons)
+            count += is_simple_polygon_2d(polygon.begin(), polygon.end());
+        timer.stop();
+        const double shamos_hoey = timer.elapsed_seconds();
+        cout << "  is_simple_polygon_2d: " << count << " simple, " << shamos_hoey << " s\n";
+
+        count = 0;
+        timer.start();
+        for (const auto& polygon : *polygons)
+            count += is_simple_full_sweep(polygon);
+        timer.stop();
+        const double full_sweep = timer.elapsed_seconds();
+        cout << "  full sweep:           " << count << " simple, " << full_sweep << " s, "
+             << full_sweep / shamos_hoey << "x\n";
+    }
+
+    return 0;
+}
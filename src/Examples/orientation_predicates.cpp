@@ -0,0 +1,110 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Evaluates orientation_2D with plain_predicates and adaptive_predicates on random point triples and on triples that
+ * are nearly colinear, and reports the rate at which the floating point filter decides, the time per predicate and
+ * how often the plain predicate gets the sign wrong.  The triples fit in cache and are evaluated repeatedly, so that
+ * the time is that of the predicates.  Ends with chull_graham_2d under both policies.
+ *
+ * usage: orientation_predicates [triples] [repetitions]
+ */
+template <typename Predicates>
+double time_predicates(const vector<vec2d>& points, int n_repetitions, int& checksum) {
+    const size_t n = points.size() / 3;
+    performance_timer timer;
+    checksum = 0;
+    timer.start();
+    for (int r = 0; r < n_repetitions; ++r) {
+        for (size_t i = 0; i < n; ++i)
+            checksum += Predicates::orientation_2D(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+    }
+    timer.stop();
+    return timer.elapsed_seconds() / n_repetitions;
+}
+
+void run(const char* name, const vector<vec2d>& points, int n_repetitions) {
+    const size_t n = points.size() / 3;
+
+    int plain_sum;
+    int adaptive_sum;
+    const double plain_time = time_predicates<plain_predicates>(points, n_repetitions, plain_sum);
+    const double adaptive_time = time_predicates<adaptive_predicates>(points, n_repetitions, adaptive_sum);
+
+    size_t filter_hits = 0;
+    size_t wrong = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const auto& v1 = points[3 * i];
+        const auto& v2 = points[3 * i + 1];
+        const auto& v3 = points[3 * i + 2];
+        int sign;
+        filter_hits += turn_2D_filter(v1, v2, v1, v3, sign);
+        wrong += plain_predicates::orientation_2D(v1, v2, v3) != adaptive_predicates::orientation_2D(v1, v2, v3);
+    }
+
+    cout << name << " (checksums " << plain_sum << ", " << adaptive_sum << "):\n"
+         << "  filter hit rate: " << 100.0 * filter_hits / n << "%\n"
+         << "  plain:    " << 1e9 * plain_time / n << " ns/predicate, " << 100.0 * wrong / n << "% wrong signs\n"
+         << "  adaptive: " << 1e9 * adaptive_time / n << " ns/predicate, " << adaptive_time / plain_time << "x\n";
+}
+
+int main(int argc, char* argv[]) {
+    int n_triples = 100000;
+    int n_repetitions = 100;
+    if (argc > 1)
+        n_triples = atoi(argv[1]);
+    if (argc > 2)
+        n_repetitions = atoi(argv[2]);
+
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(-1000, 1000);
+
+    vector<vec2d> points;
+    for (int i = 0; i < 3 * n_triples; ++i)
+        points.emplace_back(dis(gen), dis(gen));
+    run("random", points, n_repetitions);
+
+    // points within a few ulps of the line through (12, 12) and (24, 24)
+    const double ulp = ldexp(1.0, -53);
+    uniform_int_distribution<int> offset(0, 255);
+    points.clear();
+    for (int i = 0; i < n_triples; ++i) {
+        points.emplace_back(0.5 + offset(gen) * ulp, 0.5 + offset(gen) * ulp);
+        points.emplace_back(12, 12);
+        points.emplace_back(24, 24);
+    }
+    run("nearly colinear", points, n_repetitions);
+
+    // hulls of random points, where the filter almost always decides
+    points.resize(1000000);
+    for (auto& p : points)
+        p = vec2d(dis(gen), dis(gen));
+
+    performance_timer timer;
+    vector<vec2d> hull;
+    timer.start();
+    chull_graham_2d(points.begin(), points.end(), back_inserter(hull));
+    timer.stop();
+    const double plain_time = timer.elapsed_seconds();
+
+    hull.clear();
+    timer.start();
+    chull_graham_2d(points.begin(), points.end(), back_inserter(hull), adaptive_predicates());
+    timer.stop();
+    const double adaptive_time = timer.elapsed_seconds();
+
+    cout << "chull_graham_2d of " << points.size() << " points:\n"
+         << "  plain:    " << 1000 * plain_time << " ms\n"
+         << "  adaptive: " << 1000 * adaptive_time << " ms, " << adaptive_time / plain_time << "x\n";
+
+    return 0;
+}
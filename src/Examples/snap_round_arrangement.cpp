@@ -0,0 +1,67 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Builds the snap-rounded arrangement of 1000, 2000, 4000, ... random segments with snap_round_arrangement_2D and
+ * reports its size and time.  For comparison, times testing every pair of segments with intersect_segment_segment_2D,
+ * which alone is the cost of finding the split points in quadratic time.
+ *
+ * usage: snap_round_arrangement [largest number of segments] [pixel size] [largest number for the pair test]
+ */
+int main(int argc, char* argv[]) {
+    size_t max_n = 256000;
+    double pixel_size = 0.01;
+    size_t max_brute_force = 16000;
+    if (argc > 1)
+        max_n = static_cast<size_t>(atoi(argv[1]));
+    if (argc > 2)
+        pixel_size = atof(argv[2]);
+    if (argc > 3)
+        max_brute_force = static_cast<size_t>(atoi(argv[3]));
+
+    for (size_t n = 1000; n <= max_n; n *= 2) {
+        // the square grows with the input, so every segment crosses about the same number of others
+        const double side = 10.0 * sqrt(static_cast<double>(n));
+        mt19937 gen(0);
+        uniform_real_distribution<double> dis(0, side);
+        uniform_real_distribution<double> offset(-10, 10);
+        vector<segment2d> segments;
+        for (size_t i = 0; i < n; ++i) {
+            const vec2d p(dis(gen), dis(gen));
+            segments.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+        }
+
+        performance_timer timer;
+        timer.start();
+        const auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), pixel_size);
+        timer.stop();
+
+        cout << n << " segments: " << arrangement.dcel.vertices_size() << " vertices, "
+             << arrangement.dcel.half_edges_size() / 2 << " edges, " << arrangement.dcel.faces_size() << " faces\n"
+             << "  snap_round_arrangement_2D: " << 1000 * timer.elapsed_seconds() << " ms\n";
+
+        if (n <= max_brute_force) {
+            size_t n_crossings = 0;
+            timer.start();
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = i + 1; j < n; ++j)
+                    n_crossings += intersect_segment_segment_2D(segments[i], segments[j]).second;
+            }
+            timer.stop();
+            cout << "  all pairs tested:          " << 1000 * timer.elapsed_seconds() << " ms, " << n_crossings
+                 << " crossings\n";
+        }
+    }
+
+    return 0;
+}
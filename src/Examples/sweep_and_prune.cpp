@@ -0,0 +1,106 @@
+#include <MTLib/mtlib.h>
+
+#include "common/performance_timer.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+/**
+ * Moves short random segments a little every frame and finds the intersecting pairs with the sweep-and-prune broad
+ * phase followed by intersect_segment_pairs_2D.  Reports the time per frame of re-sorting the broad phase with a
+ * full sort and with insertion sort, and of the pair scan and narrow phase that follow.
+ *
+ * usage: sweep_and_prune [segments] [frames]
+ */
+int main(int argc, char* argv[]) {
+    int n_segments = 200000;
+    int n_frames = 50;
+    if (argc > 1)
+        n_segments = atoi(argv[1]);
+    if (argc > 2)
+        n_frames = atoi(argv[2]);
+
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(0, 10000);
+    uniform_real_distribution<double> offset(-5, 5);
+    uniform_real_distribution<double> velocity(-0.5, 0.5);
+
+    vector<segment2d> segments;
+    vector<vec2d> velocities;
+    for (int i = 0; i < n_segments; ++i) {
+        vec2d p(dis(gen), dis(gen));
+        segments.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+        velocities.emplace_back(velocity(gen), velocity(gen));
+    }
+
+    intersection::sweep_and_prune_2D<double> rebuilt;
+    intersection::sweep_and_prune_2D<double> updated;
+    rebuilt.build(segments.begin(), segments.end());
+    updated.build(segments.begin(), segments.end());
+
+    performance_timer timer;
+    double rebuild_time = 0;
+    double update_time = 0;
+    double scan_time = 0;
+    double narrow_time = 0;
+    size_t n_pairs = 0;
+    size_t n_hits = 0;
+    size_t n_moves = 0;
+
+    vector<pair<uint32_t, uint32_t>> pairs;
+    vector<uint32_t> first;
+    vector<uint32_t> second;
+    vector<intersection::pair_hit_2D<double>> hits;
+
+    for (int frame = 0; frame < n_frames; ++frame) {
+        for (size_t i = 0; i < segments.size(); ++i)
+            segments[i] = segment2d(segments[i][0] + velocities[i], segments[i][1] + velocities[i]);
+
+        timer.start();
+        rebuilt.build(segments.begin(), segments.end());
+        timer.stop();
+        rebuild_time += timer.elapsed_seconds();
+
+        timer.start();
+        n_moves += updated.update(segments.begin(), segments.end());
+        timer.stop();
+        update_time += timer.elapsed_seconds();
+
+        pairs.clear();
+        timer.start();
+        updated.pairs(back_inserter(pairs));
+        timer.stop();
+        scan_time += timer.elapsed_seconds();
+        n_pairs += pairs.size();
+
+        timer.start();
+        const intersection::segments_soa_2D<double> soa(segments.begin(), segments.end());
+        first.clear();
+        second.clear();
+        for (const auto& [i, j] : pairs) {
+            first.push_back(i);
+            second.push_back(j);
+        }
+        hits.clear();
+        intersect_segment_pairs_2D(soa, span<const uint32_t>(first), span<const uint32_t>(second), hits);
+        timer.stop();
+        narrow_time += timer.elapsed_seconds();
+        n_hits += hits.size();
+    }
+
+    cout << n_segments << " segments, " << n_frames << " frames, "
+         << (double)n_pairs / n_frames << " candidate pairs and " << (double)n_hits / n_frames << " hits per frame\n"
+         << "  build, full sort:       " << 1000 * rebuild_time / n_frames << " ms/frame\n"
+         << "  update, insertion sort: " << 1000 * update_time / n_frames << " ms/frame, "
+         << (double)n_moves / n_frames << " moves/frame, " << rebuild_time / update_time << "x\n"
+         << "  pair scan:              " << 1000 * scan_time / n_frames << " ms/frame\n"
+         << "  narrow phase:           " << 1000 * narrow_time / n_frames << " ms/frame\n";
+
+    return 0;
+}
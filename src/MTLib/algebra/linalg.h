@@ -3,15 +3,54 @@
 
 #include "MTLib/algebra/vec.h"
 
+#include <cstdint>  // int32_t, int64_t
+#include <type_traits>
+
 namespace mtlib {
 
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+
+/**
+ * The type products of two differences of Scalars are computed in.  Floating point types stay as they are, 32 and 64
+ * bit integers are widened so that cross_2D and signed_area_2D are exact for coordinates of magnitude below 2^30 and
+ * 2^62 respectively.
+ */
+template <typename Scalar>
+struct wide_scalar { using type = Scalar; };
+
+template <>
+struct wide_scalar<std::int32_t> { using type = std::int64_t; };
+
+template <>
+struct wide_scalar<std::int64_t> { using type = int128; };
+
 template <typename Scalar>
-constexpr Scalar signed_area_2D(const vec2<Scalar>& v1, const vec2<Scalar>& v2, const vec2<Scalar>& v3) {
-    return dot_perp(v2 - v1, v3 - v1);
+using wide_scalar_t = typename wide_scalar<Scalar>::type;
+
+/**
+ * (p1 - p0) x (q1 - q0), positive if q turns counter-clockwise from p.
+ */
+template <typename Scalar>
+constexpr wide_scalar_t<Scalar> cross_2D(
+    const vec2<Scalar>& p0, const vec2<Scalar>& p1, const vec2<Scalar>& q0, const vec2<Scalar>& q1
+) {
+    if constexpr (std::is_integral<Scalar>::value) {
+        using Wide = wide_scalar_t<Scalar>;
+        return ((Wide)p1[0] - p0[0]) * ((Wide)q1[1] - q0[1]) - ((Wide)p1[1] - p0[1]) * ((Wide)q1[0] - q0[0]);
+    }
+    else {
+        return dot_perp(p1 - p0, q1 - q0);
+    }
+}
+
+template <typename Scalar>
+constexpr wide_scalar_t<Scalar> signed_area_2D(const vec2<Scalar>& v1, const vec2<Scalar>& v2, const vec2<Scalar>& v3) {
+    return cross_2D(v1, v2, v1, v3);
 }
 
-template <typename InputIt, typename Scalar>
-constexpr Scalar signed_area_2D(const InputIt& it1, const InputIt& it2, const InputIt& it3) {
+template <typename InputIt>
+constexpr auto signed_area_2D(const InputIt& it1, const InputIt& it2, const InputIt& it3) {
     return signed_area_2D(*it1, *it2, *it3);
 }
 
@@ -0,0 +1,229 @@
+#ifndef _MTLIB_ALGEBRA_PREDICATES_H_
+#define _MTLIB_ALGEBRA_PREDICATES_H_
+
+#include "MTLib/algebra/linalg.h"
+#include "MTLib/algebra/vec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>  // size_t
+#include <limits>
+#include <type_traits>
+
+namespace mtlib {
+
+/**
+ * Sign of a value as -1, 0 or 1.
+ */
+template <typename Scalar>
+constexpr int sign_of(Scalar value) {
+    return (value > (Scalar)0) - (value < (Scalar)0);
+}
+
+namespace exact {
+
+/**
+ * Floating point expansion arithmetic after Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+ * Geometric Predicates".  An expansion is a sum of non-overlapping components in increasing order of magnitude, its
+ * sign is the sign of its last component.  Exact as long as nothing overflows or underflows.
+ */
+
+// x + y == a + b exactly, x = fl(a + b)
+template <typename Scalar>
+constexpr void two_sum(Scalar a, Scalar b, Scalar& x, Scalar& y) {
+    x = a + b;
+    const Scalar b_virtual = x - a;
+    const Scalar a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// x + y == a + b exactly, requires |a| >= |b|
+template <typename Scalar>
+constexpr void fast_two_sum(Scalar a, Scalar b, Scalar& x, Scalar& y) {
+    x = a + b;
+    y = b - (x - a);
+}
+
+// x + y == a - b exactly, x = fl(a - b)
+template <typename Scalar>
+constexpr void two_diff(Scalar a, Scalar b, Scalar& x, Scalar& y) {
+    x = a - b;
+    const Scalar b_virtual = a - x;
+    const Scalar a_virtual = x + b_virtual;
+    y = (a - a_virtual) + (b_virtual - b);
+}
+
+// x + y == a * b exactly, x = fl(a * b)
+template <typename Scalar>
+inline void two_product(Scalar a, Scalar b, Scalar& x, Scalar& y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+/**
+ * h = e * b, returns the number of components of h.  h may not alias e and needs room for 2 * e_size components.
+ */
+template <typename Scalar>
+inline std::size_t scale_expansion(std::size_t e_size, const Scalar* e, Scalar b, Scalar* h) {
+    std::size_t h_size = 0;
+    Scalar q, tail;
+    two_product(e[0], b, q, tail);
+    if (tail != (Scalar)0)
+        h[h_size++] = tail;
+    for (std::size_t i = 1; i < e_size; ++i) {
+        Scalar product, product_tail, sum;
+        two_product(e[i], b, product, product_tail);
+        two_sum(q, product_tail, sum, tail);
+        if (tail != (Scalar)0)
+            h[h_size++] = tail;
+        fast_two_sum(product, sum, q, tail);
+        if (tail != (Scalar)0)
+            h[h_size++] = tail;
+    }
+    if (q != (Scalar)0 || h_size == 0)
+        h[h_size++] = q;
+    return h_size;
+}
+
+/**
+ * h = e + f, returns the number of components of h.  h may not alias e or f and needs room for e_size + f_size.
+ *
+ * Merges the components of e and f by magnitude, so e and f must be strongly non-overlapping, which the expansions
+ * built here are.
+ */
+template <typename Scalar>
+inline std::size_t expansion_sum(std::size_t e_size, const Scalar* e, std::size_t f_size, const Scalar* f, Scalar* h) {
+    std::size_t e_index = 0;
+    std::size_t f_index = 0;
+    auto smaller_from_e = [&]() {
+        return f_index == f_size || (e_index < e_size && std::abs(e[e_index]) < std::abs(f[f_index]));
+    };
+    auto next = [&]() {
+        return smaller_from_e() ? e[e_index++] : f[f_index++];
+    };
+
+    std::size_t h_size = 0;
+    Scalar q = next();
+    if (e_index < e_size || f_index < f_size) {
+        Scalar sum, tail;
+        fast_two_sum(next(), q, sum, tail);
+        q = sum;
+        if (tail != (Scalar)0)
+            h[h_size++] = tail;
+        while (e_index < e_size || f_index < f_size) {
+            two_sum(q, next(), sum, tail);
+            q = sum;
+            if (tail != (Scalar)0)
+                h[h_size++] = tail;
+        }
+    }
+    if (q != (Scalar)0 || h_size == 0)
+        h[h_size++] = q;
+    return h_size;
+}
+
+/**
+ * Exact sign of (p1 - p0) x (q1 - q0).
+ */
+template <typename Scalar>
+int turn_2D(const vec2<Scalar>& p0, const vec2<Scalar>& p1, const vec2<Scalar>& q0, const vec2<Scalar>& q1) {
+    // every difference as a two component expansion, tail first
+    Scalar px[2], py[2], qx[2], qy[2];
+    two_diff(p1[0], p0[0], px[1], px[0]);
+    two_diff(p1[1], p0[1], py[1], py[0]);
+    two_diff(q1[0], q0[0], qx[1], qx[0]);
+    two_diff(q1[1], q0[1], qy[1], qy[0]);
+
+    auto product = [](const Scalar* a, const Scalar* b, Scalar* h) {
+        Scalar low[4], high[4];
+        const auto low_size = scale_expansion(2, a, b[0], low);
+        const auto high_size = scale_expansion(2, a, b[1], high);
+        return expansion_sum(low_size, low, high_size, high, h);
+    };
+
+    Scalar left[8], right[8], det[16];
+    const auto left_size = product(px, qy, left);
+    const auto right_size = product(py, qx, right);
+    for (std::size_t i = 0; i < right_size; ++i)
+        right[i] = -right[i];
+    const auto det_size = expansion_sum(left_size, left, right_size, right, det);
+    return sign_of(det[det_size - 1]);
+}
+
+}   // namespace exact
+
+/**
+ * Sign of (p1 - p0) x (q1 - q0) if plain floating point gets it right, the sign is then stored in sign and true is
+ * returned.  Uses the error bound of Shewchuk's orient2d, which holds for any four points.
+ */
+template <typename Scalar>
+bool turn_2D_filter(
+    const vec2<Scalar>& p0, const vec2<Scalar>& p1, const vec2<Scalar>& q0, const vec2<Scalar>& q1, int& sign
+) {
+    static_assert(std::is_floating_point<Scalar>::value, "the error bound is for floating point");
+    constexpr Scalar eps = std::numeric_limits<Scalar>::epsilon() / 2;
+    constexpr Scalar error_bound = ((Scalar)3 + (Scalar)16 * eps) * eps;
+
+    const Scalar left = (p1[0] - p0[0]) * (q1[1] - q0[1]);
+    const Scalar right = (p1[1] - p0[1]) * (q1[0] - q0[0]);
+    const Scalar det = left - right;
+
+    // products that are both exactly zero mean an exact zero, every other case is decided by the error bound
+    const Scalar det_sum = std::abs(left) + std::abs(right);
+    if (std::abs(det) > error_bound * det_sum || det_sum == (Scalar)0) {
+        sign = sign_of(det);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Predicates computed in plain arithmetic.  Exact for integer coordinates, which are widened as in cross_2D, for
+ * floating point coordinates fast and exact only away from degenerate configurations.
+ */
+struct plain_predicates {
+    /**
+     * Sign of signed_area_2D(v1, v2, v3): 1 if counter-clockwise, -1 if clockwise, 0 if colinear.
+     */
+    template <typename Scalar>
+    static int orientation_2D(const vec2<Scalar>& v1, const vec2<Scalar>& v2, const vec2<Scalar>& v3) {
+        return sign_of(signed_area_2D(v1, v2, v3));
+    }
+
+    /**
+     * Sign of (p1 - p0) x (q1 - q0), positive if q turns counter-clockwise from p.
+     */
+    template <typename Scalar>
+    static int turn_2D(const vec2<Scalar>& p0, const vec2<Scalar>& p1, const vec2<Scalar>& q0, const vec2<Scalar>& q1) {
+        return sign_of(cross_2D(p0, p1, q0, q1));
+    }
+};
+
+/**
+ * Exact predicates for floating point coordinates.  A floating point filter decides all but the nearly degenerate
+ * cases, which fall back to expansion arithmetic.
+ */
+struct adaptive_predicates {
+    template <typename Scalar>
+    static int orientation_2D(const vec2<Scalar>& v1, const vec2<Scalar>& v2, const vec2<Scalar>& v3) {
+        return turn_2D(v1, v2, v1, v3);
+    }
+
+    template <typename Scalar>
+    static int turn_2D(const vec2<Scalar>& p0, const vec2<Scalar>& p1, const vec2<Scalar>& q0, const vec2<Scalar>& q1) {
+        // integer coordinates are already exact in the wide type
+        if constexpr (std::is_integral<Scalar>::value) {
+            return sign_of(cross_2D(p0, p1, q0, q1));
+        }
+        else {
+            int sign;
+            if (turn_2D_filter(p0, p1, q0, q1, sign))
+                return sign;
+            return exact::turn_2D(p0, p1, q0, q1);
+        }
+    }
+};
+
+}   // namespace mtlib
+
+#endif // _MTLIB_ALGEBRA_PREDICATES_H_
@@ -90,8 +90,11 @@ constexpr Scalar inv_lerp(const vec<N, Scalar>& start, const vec<N, Scalar>& end
 
 // Linear Algebra
 template <std::size_t N, typename Scalar>
-constexpr vec<N, Scalar> dot(const vec<N, Scalar>& lhs, const vec<N, Scalar>& rhs) {
-    return lhs * rhs;
+constexpr Scalar dot(const vec<N, Scalar>& lhs, const vec<N, Scalar>& rhs) {
+    Scalar result = 0;
+    for (std::size_t i = 0; i < N; ++i)
+        result += lhs[i] * rhs[i];
+    return result;
 }
 
 template <typename Scalar>
@@ -3,60 +3,284 @@
 
 #include "MTLib/algebra/vec.h"
 #include "MTLib/algebra/linalg.h"
+#include "MTLib/algebra/predicates.h"
 #include "MTLib/comp_geo/overlap_convex_point_2d.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
 namespace mtlib {
 
-template <typename RandomIt, typename OutputIt, typename Scalar = typename RandomIt::value_type::scalar_type>
-void chull_graham_2d(const RandomIt& first, const RandomIt& last, const OutputIt& d_first) {
+/**
+ * Scratch space of the monotone chain hulls, its buffers only grow, so a scratch reused for many small hulls stops
+ * allocating after the first ones.
+ */
+template<typename Scalar, typename Index = std::uint32_t>
+struct chull_scratch_2d {
+    // the points are sorted with their input index, which keeps the sort and the chains cache friendly
+    struct entry {
+        vec2<Scalar> point;
+        Index index;
+    };
+
+    std::vector<entry> sorted;
+    std::vector<Index> stack;
+};
+
+/**
+ * Leaves in scratch.stack the indices into [first, last) of the hull vertices in counter-clockwise order, starting at
+ * the lexicographically smallest point, and returns their number.  Andrew's monotone chain on an index stack: the lower
+ * chain is built left to right, the upper one right to left on top of it, and a point is popped while the last turn
+ * is not counter-clockwise.  Repeated and colinear points never become vertices, so the hull of colinear points is
+ * their two extremes and the hull of a repeated point is that point once.
+ *
+ * Nothing is allocated once scratch has held an input of the same size.
+ */
+template<typename RandomIt, typename Scalar, typename Index, typename Predicates = plain_predicates>
+std::size_t chull_monotone_chain_2d(
+        RandomIt first, RandomIt last, chull_scratch_2d<Scalar, Index>& scratch, Predicates = Predicates()
+) {
     assert(distance(first, last) > 0);
 
-    int n = distance(first, last);
-    std::vector<vec2<Scalar>> result;
+    const auto n = static_cast<Index>(distance(first, last));
+    auto& sorted = scratch.sorted;
+    sorted.resize(n);
+    for (Index i = 0; i < n; ++i)
+        sorted[i] = {first[i], i};
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.point < b.point; });
 
-    if (n <= 3) {
-        for (auto it = first; it != last; ++it)
-            result.push_back(*it);
-        
-        if (result.size() == 3 && !is_ccw(result[0], result[1], result[2]))
-            std::swap(result[0], result[1]);
+    if (n == 0)
+        return 0;
 
-        std::copy(result.begin(), result.end(), d_first);
+    // the chains below would start and end on the same point
+    auto& stack = scratch.stack;
+    if (sorted.front().point == sorted.back().point) {
+        stack.resize(std::max<std::size_t>(stack.size(), 1));
+        stack[0] = sorted.front().index;
+        return 1;
     }
-    else {
-        std::vector<vec2<Scalar>> cp(n);
-        std::copy(first, last, cp.begin());
-        std::sort(cp.begin(), cp.end());
-
-        // bottom hull
-        result.push_back(cp[0]);
-        result.push_back(cp[1]);
-        for (std::size_t i = 2; i < cp.size(); ++i) {
-            result.push_back(cp[i]);
-            while (result.size() > 2 && !is_ccw(result[result.size() - 3], result[result.size() - 2], result[result.size() - 1]))
-                result.erase(result.end() - 2);
+
+    // the stack holds positions in sorted until the end
+    stack.resize(2 * std::size_t(n));
+    std::size_t k = 0;
+    const auto push = [&](Index i, std::size_t bottom) {
+        while (k > bottom &&
+               Predicates::orientation_2D(sorted[stack[k - 2]].point, sorted[stack[k - 1]].point, sorted[i].point) <= 0)
+            --k;
+        stack[k++] = i;
+    };
+
+    // the upper chain starts on the last point of the lower one and ends on its first point, which is dropped
+    for (Index i = 0; i < n; ++i)
+        push(i, 1);
+    const auto lower = k;
+    for (Index i = n - 1; i-- > 0;)
+        push(i, lower);
+
+    for (std::size_t i = 0; i + 1 < k; ++i)
+        stack[i] = sorted[stack[i]].index;
+    return k - 1;
+}
+
+/**
+ * Writes to d_first the indices into [first, last) of the hull vertices, as ordered by chull_monotone_chain_2d.
+ */
+template<typename RandomIt, typename OutputIt, typename Scalar, typename Index, typename Predicates = plain_predicates>
+OutputIt chull_graham_2d_indices(
+        RandomIt first, RandomIt last, OutputIt d_first, chull_scratch_2d<Scalar, Index>& scratch,
+        Predicates = Predicates()
+) {
+    const auto size = chull_monotone_chain_2d(first, last, scratch, Predicates());
+    return std::copy(scratch.stack.begin(), scratch.stack.begin() + size, d_first);
+}
+
+/**
+ * chull_graham_2d with caller owned scratch space, allocation free once scratch has grown to the input size.
+ */
+template<typename RandomIt, typename OutputIt, typename Scalar, typename Index, typename Predicates = plain_predicates>
+OutputIt chull_graham_2d(
+        RandomIt first, RandomIt last, OutputIt d_first, chull_scratch_2d<Scalar, Index>& scratch,
+        Predicates = Predicates()
+) {
+    const auto size = chull_monotone_chain_2d(first, last, scratch, Predicates());
+    for (std::size_t i = 0; i < size; ++i)
+        *d_first++ = first[scratch.stack[i]];
+    return d_first;
+}
+
+/**
+ * Writes to d_first, in input order, the points of [first, last) that are not strictly inside the octagon of the
+ * extreme points in x, y, x + y and x - y, and returns the end of the output.  No hull vertex is strictly inside, so
+ * the hull of the output is the hull of the input, while on spread out input most points are culled.
+ *
+ * After one pass for the extremes the octagon test is one branch free pass of eight turns per point.  Floating point
+ * turns only cull a point when Shewchuk's error bound proves it inside, integer turns are exact.
+ */
+template<typename RandomIt, typename OutputIt>
+OutputIt akl_toussaint_filter_2d(RandomIt first, RandomIt last, OutputIt d_first) {
+    using point_type = typename std::iterator_traits<RandomIt>::value_type;
+    using Scalar = typename point_type::scalar_type;
+    using Wide = wide_scalar_t<Scalar>;
+    if (first == last)
+        return d_first;
+
+    // blocks of points are split into coordinate arrays, which the passes below vectorize over
+    const auto n = static_cast<std::size_t>(distance(first, last));
+    constexpr std::size_t block = 256;
+    Wide lanes[4][block];
+    const auto load = [&](std::size_t begin, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            const Wide x = first[begin + i][0];
+            const Wide y = first[begin + i][1];
+            lanes[0][i] = x;
+            lanes[1][i] = x + y;
+            lanes[2][i] = y;
+            lanes[3][i] = y - x;
         }
-        std::move(result.begin(), result.end(), d_first);
-
-        // top hull
-        result.clear();
-        result.push_back(cp[cp.size() - 1]);
-        result.push_back(cp[cp.size() - 2]);
-        for (int i = cp.size() - 3; i >= 0; --i) {
-            result.push_back(cp[i]);
-            while (result.size() > 2 && !is_ccw(result[result.size() - 3], result[result.size() - 2], result[result.size() - 1]))
-                result.erase(result.end() - 2);
+    };
+
+    // counter-clockwise from east the extremes are the maxima of x, x + y, y, y - x, then their minima
+    Wide extreme_key[8];
+    std::size_t extreme_index[8] = {};
+    load(0, 1);
+    for (int d = 0; d < 8; ++d)
+        extreme_key[d] = lanes[d % 4][0];
+    for (std::size_t begin = 0; begin < n; begin += block) {
+        const auto size = std::min(block, n - begin);
+        load(begin, size);
+        for (int l = 0; l < 4; ++l) {
+            // eight running extremes per lane, which vectorize without reassociating a floating point reduction
+            const auto lane = lanes[l];
+            for (auto i = size; i % 8; ++i)
+                lane[i] = lane[0];
+            Wide highs[8], lows[8];
+            std::copy(lane, lane + 8, highs);
+            std::copy(lane, lane + 8, lows);
+            for (std::size_t i = 8; i < size; i += 8) {
+                for (int j = 0; j < 8; ++j) {
+                    highs[j] = std::max(highs[j], lane[i + j]);
+                    lows[j] = std::min(lows[j], lane[i + j]);
+                }
+            }
+            const Wide high = *std::max_element(highs, highs + 8);
+            const Wide low = *std::min_element(lows, lows + 8);
+            if (high > extreme_key[l]) {
+                extreme_key[l] = high;
+                extreme_index[l] = begin + (std::find(lane, lane + size, high) - lane);
+            }
+            if (low < extreme_key[l + 4]) {
+                extreme_key[l + 4] = low;
+                extreme_index[l + 4] = begin + (std::find(lane, lane + size, low) - lane);
+            }
         }
-        std::move(result.begin() + 1, result.end() - 1, d_first);
     }
+    point_type extreme[8];
+    for (int d = 0; d < 8; ++d)
+        extreme[d] = first[extreme_index[d]];
+
+    // the octagon's edges of nonzero length, repeated up to eight, which leaves the test unchanged
+    Wide ax[8], ay[8], dx[8], dy[8];
+    int n_edges = 0;
+    for (int d = 0; d < 8; ++d) {
+        const auto& a = extreme[d];
+        const auto& b = extreme[(d + 1) % 8];
+        if (a != b) {
+            ax[n_edges] = a[0];
+            ay[n_edges] = a[1];
+            dx[n_edges] = (Wide)b[0] - a[0];
+            dy[n_edges] = (Wide)b[1] - a[1];
+            ++n_edges;
+        }
+    }
+    if (n_edges < 3)
+        return std::copy(first, last, d_first);
+    for (int e = n_edges; e < 8; ++e) {
+        ax[e] = ax[e - n_edges];
+        ay[e] = ay[e - n_edges];
+        dx[e] = dx[e - n_edges];
+        dy[e] = dy[e - n_edges];
+    }
+
+    const auto xs = lanes[0];
+    const auto ys = lanes[2];
+    unsigned char inside[block];
+    for (std::size_t begin = 0; begin < n; begin += block) {
+        const auto size = std::min(block, n - begin);
+        load(begin, size);
+        for (std::size_t i = 0; i < size; ++i)
+            inside[i] = 1;
+        for (int e = 0; e < 8; ++e) {
+            if constexpr (std::is_floating_point<Scalar>::value) {
+                constexpr Scalar eps = std::numeric_limits<Scalar>::epsilon() / 2;
+                constexpr Scalar error_bound = ((Scalar)3 + (Scalar)16 * eps) * eps;
+                for (std::size_t i = 0; i < size; ++i) {
+                    const Scalar left = dx[e] * (ys[i] - ay[e]);
+                    const Scalar right = dy[e] * (xs[i] - ax[e]);
+                    inside[i] &= left - right > error_bound * (std::abs(left) + std::abs(right));
+                }
+            }
+            else {
+                for (std::size_t i = 0; i < size; ++i)
+                    inside[i] &= dx[e] * (ys[i] - ay[e]) - dy[e] * (xs[i] - ax[e]) > 0;
+            }
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!inside[i])
+                *d_first++ = first[begin + i];
+        }
+    }
+    return d_first;
+}
+
+/**
+ * Scratch space of chull_akl_toussaint_2d: the points the filter keeps and the monotone chain's scratch for their hull.
+ */
+template<typename Scalar, typename Index = std::uint32_t>
+struct chull_akl_toussaint_scratch_2d {
+    std::vector<vec2<Scalar>> filtered;
+    chull_scratch_2d<Scalar, Index> chain;
+};
+
+/**
+ * chull_graham_2d of the points akl_toussaint_filter_2d keeps, which gives the same hull for a fraction of the sort
+ * when most points are well inside it.
+ */
+template<typename RandomIt, typename OutputIt, typename Scalar, typename Index, typename Predicates = plain_predicates>
+OutputIt chull_akl_toussaint_2d(
+        RandomIt first, RandomIt last, OutputIt d_first, chull_akl_toussaint_scratch_2d<Scalar, Index>& scratch,
+        Predicates = Predicates()
+) {
+    assert(distance(first, last) > 0);
+
+    auto& filtered = scratch.filtered;
+    filtered.clear();
+    akl_toussaint_filter_2d(first, last, std::back_inserter(filtered));
+    return chull_graham_2d(filtered.begin(), filtered.end(), d_first, scratch.chain, Predicates());
 }
 
+/**
+ * Predicates is plain_predicates or adaptive_predicates, the latter keeps the hull convex on nearly colinear input.
+ */
+template<
+        typename RandomIt, typename OutputIt, typename Scalar = typename RandomIt::value_type::scalar_type,
+        typename Predicates = plain_predicates
+>
+void chull_graham_2d(const RandomIt& first, const RandomIt& last, const OutputIt& d_first, Predicates = Predicates()) {
+    assert(distance(first, last) > 0);
+
+    chull_scratch_2d<Scalar> scratch;
+    const auto size = chull_monotone_chain_2d(first, last, scratch, Predicates());
+    auto out = d_first;
+    for (std::size_t i = 0; i < size; ++i)
+        *out++ = vec2<Scalar>(first[scratch.stack[i]]);
+}
 }
 
 #endif // _MTLIB_CONVEX_HULL_2D_H_
\ No newline at end of file
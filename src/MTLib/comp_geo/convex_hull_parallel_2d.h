@@ -0,0 +1,131 @@
+#ifndef _MTLIB_CONVEX_HULL_PARALLEL_2D_H_
+#define _MTLIB_CONVEX_HULL_PARALLEL_2D_H_
+
+#include "MTLib/algebra/predicates.h"
+#include "MTLib/comp_geo/convex_hull_2d.h"
+#include "MTLib/util/parallel_sort.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <functional>   // less
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace mtlib {
+
+/**
+ * chull_graham_2d on n_threads threads: every thread takes the hull of its own part of the input, and the hull of the
+ * union of these local hulls, which is usually tiny, is the hull of the input.  The output is the same as
+ * chull_graham_2d's, parts smaller than min_part points are not worth a thread.
+ */
+template<typename RandomIt, typename OutputIt, typename Predicates = plain_predicates>
+OutputIt chull_parallel_2d(
+        RandomIt first, RandomIt last, OutputIt d_first, std::size_t n_threads = std::thread::hardware_concurrency(),
+        Predicates = Predicates(), std::size_t min_part = 1 << 14
+) {
+    using point_type = typename std::iterator_traits<RandomIt>::value_type;
+    assert(distance(first, last) > 0);
+
+    const auto n = static_cast<std::size_t>(distance(first, last));
+    n_threads = std::max<std::size_t>(1, std::min(n_threads, n / std::max<std::size_t>(min_part, 1)));
+    chull_scratch_2d<typename point_type::scalar_type> scratch;
+    if (n_threads == 1)
+        return chull_graham_2d(first, last, d_first, scratch, Predicates());
+
+    std::vector<std::vector<point_type>> local(n_threads);
+    const auto work = [&](std::size_t t) {
+        chull_scratch_2d<typename point_type::scalar_type> local_scratch;
+        const auto begin = first + n * t / n_threads;
+        const auto end = first + n * (t + 1) / n_threads;
+        chull_graham_2d(begin, end, std::back_inserter(local[t]), local_scratch, Predicates());
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < n_threads; ++t)
+        threads.emplace_back(work, t);
+    work(0);
+    for (auto& thread : threads)
+        thread.join();
+
+    std::vector<point_type> hulls;
+    for (const auto& hull : local)
+        hulls.insert(hulls.end(), hull.begin(), hull.end());
+    return chull_graham_2d(hulls.begin(), hulls.end(), d_first, scratch, Predicates());
+}
+
+/**
+ * chull_graham_2d on n_threads threads through a lexicographic parallel_sort of a copy of the input.  Every thread
+ * then builds the lower and the upper chain of a consecutive range of the sorted points, and one sequential monotone
+ * chain pass over the concatenated chains of all ranges, which are still sorted, gives the hull.  The output is the
+ * same as chull_graham_2d's.
+ *
+ * Does more work than chull_parallel_2d, but sorts the whole input, which pays off when the sorted points are wanted
+ * anyway, and every step past the sort is linear.
+ */
+template<typename RandomIt, typename OutputIt, typename Predicates = plain_predicates>
+OutputIt chull_parallel_sorted_2d(
+        RandomIt first, RandomIt last, OutputIt d_first, std::size_t n_threads = std::thread::hardware_concurrency(),
+        Predicates = Predicates(), std::size_t min_part = 1 << 14
+) {
+    using point_type = typename std::iterator_traits<RandomIt>::value_type;
+    assert(distance(first, last) > 0);
+
+    const auto n = static_cast<std::size_t>(distance(first, last));
+    if (n <= 3) {
+        chull_scratch_2d<typename point_type::scalar_type> scratch;
+        return chull_graham_2d(first, last, d_first, scratch, Predicates());
+    }
+    n_threads = std::max<std::size_t>(1, std::min(n_threads, n / std::max<std::size_t>(min_part, 1)));
+
+    const auto run = [&](auto work) {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1; t < n_threads; ++t)
+            threads.emplace_back(work, t, n * t / n_threads, n * (t + 1) / n_threads);
+        work(0, 0, n / n_threads);
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    std::vector<point_type> sorted(n);
+    run([&](std::size_t, std::size_t begin, std::size_t end) {
+        std::copy(first + begin, first + end, sorted.begin() + begin);
+    });
+    parallel_sort(sorted.begin(), sorted.end(), std::less<>(), n_threads);
+
+    // the chains below would start and end on the same point
+    if (sorted.front() == sorted.back()) {
+        *d_first++ = sorted.front();
+        return d_first;
+    }
+
+    // appends the lower chain of sorted points to chain, or the upper one when sign is -1
+    const auto append_chain = [](const auto& begin, const auto& end, std::vector<point_type>& chain, int sign) {
+        for (auto it = begin; it != end; ++it) {
+            while (chain.size() > 1 &&
+                   sign * Predicates::orientation_2D(chain[chain.size() - 2], chain.back(), *it) <= 0)
+                chain.pop_back();
+            chain.push_back(*it);
+        }
+    };
+
+    std::vector<std::vector<point_type>> lower(n_threads), upper(n_threads);
+    run([&](std::size_t t, std::size_t begin, std::size_t end) {
+        append_chain(sorted.begin() + begin, sorted.begin() + end, lower[t], 1);
+        append_chain(sorted.begin() + begin, sorted.begin() + end, upper[t], -1);
+    });
+
+    std::vector<point_type> lower_hull, upper_hull;
+    for (std::size_t t = 0; t < n_threads; ++t) {
+        append_chain(lower[t].begin(), lower[t].end(), lower_hull, 1);
+        append_chain(upper[t].begin(), upper[t].end(), upper_hull, -1);
+    }
+
+    // the upper chain runs from the first point to the last one, both already on the lower chain
+    d_first = std::copy(lower_hull.begin(), lower_hull.end(), d_first);
+    return std::copy(upper_hull.rbegin() + 1, upper_hull.rend() - 1, d_first);
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_CONVEX_HULL_PARALLEL_2D_H_
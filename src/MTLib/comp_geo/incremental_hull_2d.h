@@ -0,0 +1,212 @@
+#ifndef _MTLIB_INCREMENTAL_HULL_2D_H_
+#define _MTLIB_INCREMENTAL_HULL_2D_H_
+
+#include "MTLib/algebra/predicates.h"
+#include "MTLib/algebra/vec.h"
+#include "MTLib/util/pool_allocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <functional>   // less
+#include <iterator>
+#include <set>
+
+namespace mtlib {
+
+/**
+ * The lower hull chain of a growing point set, lexicographically from its smallest to its largest point with strictly
+ * counter-clockwise turns, see incremental_hull_2d.
+ *
+ * The vertices are kept in one balanced tree and the edges between them in another, ordered by direction, which
+ * rotates counter-clockwise along the chain from just above straight down to straight up.  Either tree answers its
+ * queries by a single descent.
+ */
+template <typename Scalar, typename Predicates = plain_predicates>
+class lower_hull_chain_2d {
+public:
+    using point_type = vec2<Scalar>;
+
+    explicit lower_hull_chain_2d(node_pool* pool)
+        : vertices_(std::less<>(), pool_allocator<point_type>(pool)),
+          edges_(edge_comparer(), pool_allocator<edge_type>(pool))
+    {}
+
+    std::size_t size() const { return vertices_.size(); }
+    bool empty() const { return vertices_.empty(); }
+    const point_type& front() const { return *vertices_.begin(); }
+    const point_type& back() const { return *vertices_.rbegin(); }
+    auto begin() const { return vertices_.begin(); }
+    auto end() const { return vertices_.end(); }
+
+    void clear() {
+        vertices_.clear();
+        edges_.clear();
+    }
+
+    /**
+     * Adds p and drops the vertices it makes redundant, returns whether p became a vertex.  Amortized O(log n), as a
+     * vertex is dropped at most once.
+     */
+    bool insert(const point_type& p) {
+        auto right = vertices_.lower_bound(p);
+        if (right != vertices_.end() && *right == p)
+            return false;
+        auto left = right == vertices_.begin() ? vertices_.end() : std::prev(right);
+
+        // a point between the ends is a vertex only strictly below the edge over it
+        if (left != vertices_.end() && right != vertices_.end()) {
+            if (Predicates::orientation_2D(*left, *right, p) >= 0)
+                return false;
+            edges_.erase({*left, *right});
+        }
+
+        while (right != vertices_.end() && std::next(right) != vertices_.end() &&
+               Predicates::orientation_2D(p, *right, *std::next(right)) <= 0) {
+            edges_.erase({*right, *std::next(right)});
+            right = vertices_.erase(right);
+        }
+        while (left != vertices_.end() && left != vertices_.begin() &&
+               Predicates::orientation_2D(*std::prev(left), *left, p) <= 0) {
+            const auto before = std::prev(left);
+            edges_.erase({*before, *left});
+            vertices_.erase(left);
+            left = before;
+        }
+
+        vertices_.insert(right, p);
+        if (left != vertices_.end())
+            edges_.insert({*left, p});
+        if (right != vertices_.end())
+            edges_.insert({p, *right});
+        return true;
+    }
+
+    /**
+     * Whether p is between the ends lexicographically and on or above the chain, in O(log n).
+     */
+    bool covers(const point_type& p) const {
+        if (vertices_.empty() || p < front() || back() < p)
+            return false;
+        const auto right = vertices_.lower_bound(p);
+        if (*right == p)
+            return true;
+        return Predicates::orientation_2D(*std::prev(right), *right, p) >= 0;
+    }
+
+    /**
+     * A vertex furthest in direction d, which points down or to the right, d[1] < 0 or d[1] == 0 < d[0].  The first
+     * edge not gaining in d, the first at or counter-clockwise from d turned a quarter counter-clockwise, starts at it.
+     */
+    const point_type& extreme(const point_type& d) const {
+        assert(!vertices_.empty() && (d[1] < 0 || (d[1] == 0 && d[0] > 0)));
+        const auto it = edges_.lower_bound({point_type(0, 0), point_type(-d[1], d[0])});
+        return it == edges_.end() ? back() : it->from;
+    }
+
+private:
+    struct edge_type {
+        point_type from, to;
+    };
+
+    struct edge_comparer {
+        bool operator()(const edge_type& lhs, const edge_type& rhs) const {
+            return Predicates::turn_2D(lhs.from, lhs.to, rhs.from, rhs.to) > 0;
+        }
+    };
+
+    std::set<point_type, std::less<>, pool_allocator<point_type>> vertices_;
+    std::set<edge_type, edge_comparer, pool_allocator<edge_type>> edges_;
+};
+
+/**
+ * Convex hull of a stream of points, updated on every insert instead of rebuilt.
+ *
+ * Keeps the lower chain of the points and, as the lower chain of the points turned by half a turn, their upper chain,
+ * both as lower_hull_chain_2d.  A point inside the hull is rejected in O(log h), any other insert is amortized
+ * O(log n).  contains() and extreme() are O(log h), snapshot() writes the h vertices in O(h) in the order of
+ * chull_graham_2d, counter-clockwise from the lexicographically smallest point, with every vertex once.
+ *
+ * The tree nodes come from a pool owned by the instance, so a hull that is cleared and refilled stops allocating.
+ * Predicates is plain_predicates or adaptive_predicates, the latter keeps the chains convex and the edge order
+ * consistent on nearly colinear input.
+ */
+template <typename Scalar, typename Predicates = plain_predicates>
+class incremental_hull_2d {
+public:
+    using scalar_type = Scalar;
+    using point_type = vec2<Scalar>;
+
+    incremental_hull_2d()
+        : lower_(&pool_), upper_(&pool_)
+    {}
+
+    // the chains hold a pointer to pool_
+    incremental_hull_2d(const incremental_hull_2d&) = delete;
+    incremental_hull_2d& operator=(const incremental_hull_2d&) = delete;
+
+    bool empty() const { return lower_.empty(); }
+
+    /**
+     * Number of hull vertices.
+     */
+    std::size_t size() const {
+        if (lower_.size() <= 1)
+            return lower_.size();
+        return lower_.size() + upper_.size() - 2;
+    }
+
+    void clear() {
+        lower_.clear();
+        upper_.clear();
+    }
+
+    /**
+     * Adds p, returns whether it became a hull vertex.
+     */
+    bool insert(const point_type& p) {
+        const bool on_lower = lower_.insert(p);
+        const bool on_upper = upper_.insert(-p);
+        return on_lower || on_upper;
+    }
+
+    /**
+     * Whether p is inside the hull or on its boundary.
+     */
+    bool contains(const point_type& p) const {
+        return lower_.covers(p) && upper_.covers(-p);
+    }
+
+    /**
+     * A hull vertex furthest in direction d, which is not zero.
+     */
+    point_type extreme(const point_type& d) const {
+        assert(!empty() && (d[0] != 0 || d[1] != 0));
+        if (d[1] < 0 || (d[1] == 0 && d[0] > 0))
+            return lower_.extreme(d);
+        return -upper_.extreme(-d);
+    }
+
+    /**
+     * Writes the hull vertices counter-clockwise from the lexicographically smallest one.
+     */
+    template <typename OutputIt>
+    OutputIt snapshot(OutputIt d_first) const {
+        d_first = std::copy(lower_.begin(), lower_.end(), d_first);
+        if (upper_.size() > 2) {
+            // the upper chain turned back runs from the largest point to the smallest one
+            for (auto it = std::next(upper_.begin()); it != std::prev(upper_.end()); ++it)
+                *d_first++ = -*it;
+        }
+        return d_first;
+    }
+
+private:
+    node_pool pool_;
+    lower_hull_chain_2d<Scalar, Predicates> lower_;
+    lower_hull_chain_2d<Scalar, Predicates> upper_;
+};
+
+}   // namespace mtlib
+
+#endif // _MTLIB_INCREMENTAL_HULL_2D_H_
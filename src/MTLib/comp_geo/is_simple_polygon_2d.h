@@ -0,0 +1,72 @@
+#ifndef _MTLIB_IS_SIMPLE_POLYGON_2D_H_
+#define _MTLIB_IS_SIMPLE_POLYGON_2D_H_
+
+#include "MTLib/algebra/linalg.h"
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/any_intersection_2D.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+
+/**
+ * True if the closed polygon through the vertices in [first, last) does not touch itself.
+ *
+ * Consecutive edges may only share their common vertex, an edge that folds back over the previous one makes the
+ * polygon not simple.  Repeated vertices and polygons with fewer than 3 vertices are not simple.
+ *
+ * O(n log n), stops at the first intersection found.
+ */
+template <typename RandomIt>
+bool is_simple_polygon_2d(const RandomIt& first, const RandomIt& last) {
+    using Scalar = typename std::iterator_traits<RandomIt>::value_type::value_type;
+    using intersection::segment_index;
+
+    const auto n = static_cast<segment_index>(std::distance(first, last));
+    if (n < 3)
+        return false;
+
+    // edge i runs from vertex i to vertex i + 1
+    std::vector<segment2<Scalar>> edges;
+    edges.reserve(n);
+    for (segment_index i = 0; i < n; ++i) {
+        const auto& v1 = first[i];
+        const auto& v2 = first[(i + 1) % n];
+        if (v1 == v2)
+            return false;
+        edges.emplace_back(std::min(v1, v2), std::max(v1, v2));
+    }
+
+    return !intersection::any_intersection_sweep_2D(edges, [&](segment_index lhs, segment_index rhs) {
+        if (rhs < lhs)
+            std::swap(lhs, rhs);
+
+        // consecutive edges meet at their shared vertex, they only intersect if the later one folds back
+        segment_index from = n;
+        if (rhs == lhs + 1)
+            from = lhs;
+        else if (lhs == 0 && rhs == n - 1)
+            from = rhs;
+
+        if (from != n) {
+            const auto& prev = first[from];
+            const auto& shared = first[(from + 1) % n];
+            const auto& next = first[(from + 2) % n];
+            const auto back = prev - shared;
+            const auto forward = next - shared;
+            return signed_area_2D(prev, shared, next) == (Scalar)0 &&
+                back[0] * forward[0] + back[1] * forward[1] > (Scalar)0;
+        }
+
+        return overlap_segment_segment_2D(edges[lhs], edges[rhs]);
+    });
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_IS_SIMPLE_POLYGON_2D_H_
@@ -6,12 +6,16 @@
 #define MTLIB_DCEL_H
 
 #include "../algebra/vec.h"
+#include "slot_vector.h"
 
 #include <algorithm>
+#include <cassert>
 #include <functional> // reference_wrapper
 #include <iterator> // (make_)reverse_iterator
 #include <cstddef> // size_t
+#include <cstdint> // uint32_t
 #include <list> // using lists since removal is the only time references are invalidated
+#include <vector>
 
 namespace mtlib {
 namespace ds {
@@ -19,19 +23,31 @@ namespace ds {
 template<typename Traits> class dcel;
 struct dcel_list_Traits;
 using dcel_list = dcel<dcel_list_Traits>;
-
+struct dcel_no_data;
+template<
+    typename Position = dcel_no_data, typename VertexData = dcel_no_data,
+    typename HalfEdgeData = dcel_no_data, typename FaceData = dcel_no_data
+>
+struct dcel_vector_data_Traits;
+using dcel_vector_Traits = dcel_vector_data_Traits<>;
+using dcel_vector = dcel<dcel_vector_Traits>;
+
+/**
+ * Records hold handles to each other, the Traits decide what a handle is: a pointer for dcel_list_Traits, a 32-bit
+ * index for dcel_vector_Traits.  The records are reached from their handles through dcel::operator[].
+ */
 template<typename Traits>
 struct dcel_vertex {
-    typename Traits::half_edge* incident = nullptr;
+    typename Traits::half_edge_handle incident = Traits::null_half_edge;
 };
 
 template<typename Traits>
 struct dcel_half_edge {
-    typename Traits::vertex* origin = nullptr;
-    typename Traits::half_edge* twin = nullptr;
-    typename Traits::half_edge* next = nullptr;
-    typename Traits::half_edge* prev = nullptr;
-    typename Traits::face* face = nullptr;
+    typename Traits::vertex_handle origin = Traits::null_vertex;
+    typename Traits::half_edge_handle twin = Traits::null_half_edge;
+    typename Traits::half_edge_handle next = Traits::null_half_edge;
+    typename Traits::half_edge_handle prev = Traits::null_half_edge;
+    typename Traits::face_handle face = Traits::null_face;
 
     constexpr bool operator==(const dcel_half_edge& other) const {
         return origin == other.origin &&
@@ -44,44 +60,206 @@ struct dcel_half_edge {
 
 template<typename Traits>
 struct dcel_face {
-    typename Traits::half_edge* incident = nullptr;
+    typename Traits::half_edge_handle incident = Traits::null_half_edge;
+};
+
+/**
+ * A 32-bit index handle to an Element in a contiguous store, null by default.
+ */
+template<typename Element>
+struct dcel_index {
+    static constexpr std::uint32_t null_index = ~std::uint32_t(0);
+
+    std::uint32_t index = null_index;
+
+    constexpr bool operator==(const dcel_index& other) const { return index == other.index; }
+    constexpr bool operator!=(const dcel_index& other) const { return index != other.index; }
+    constexpr bool operator<(const dcel_index& other) const { return index < other.index; }
 };
 
+/**
+ * Stands for no data at all in the data types of the traits, the dcel keeps no side array for it.
+ */
+struct dcel_no_data { };
+
+/**
+ * Values of type T for the elements of one kind of a dcel with index handles, stored in their own array at the index
+ * of their element.
+ */
+template<typename T>
+class dcel_side_array {
+public:
+    // gives the element a default value, the slot may have been used by an erased element
+    template<typename Element>
+    void assign(dcel_index<Element> handle) {
+        if (handle.index >= values_.size())
+            values_.resize(handle.index + std::size_t(1));
+        values_[handle.index] = T();
+    }
+
+    void reserve(std::size_t n) { values_.reserve(n); }
+
+    template<typename Element>
+    T& operator[](dcel_index<Element> handle) { return values_[handle.index]; }
+
+    template<typename Element>
+    const T& operator[](dcel_index<Element> handle) const { return values_[handle.index]; }
+
+private:
+    std::vector<T> values_;
+};
+
+template<>
+class dcel_side_array<dcel_no_data> {
+public:
+    template<typename Handle>
+    void assign(Handle) { }
+
+    void reserve(std::size_t) { }
+};
+
+/**
+ * Each element in its own std::list node, handles are pointers to the records.  Erasing an element is linear in the
+ * number of elements of its kind.
+ */
 struct dcel_list_Traits {
     using vertex = dcel_vertex<dcel_list_Traits>;
+    using vertex_handle = vertex*;
     using vertex_container = std::list<vertex>;
     using vertices_iterator = vertex_container::iterator;
     using vertices_reverse_iterator = vertex_container::reverse_iterator;
 
     using half_edge = dcel_half_edge<dcel_list_Traits>;
+    using half_edge_handle = half_edge*;
     using half_edge_container = std::list<half_edge>;
     using half_edges_iterator = half_edge_container::iterator;
     using half_edges_reverse_iterator = half_edge_container::reverse_iterator;
 
     using face = dcel_face<dcel_list_Traits>;
+    using face_handle = face*;
     using face_container = std::list<face>;
     using faces_iterator = face_container::iterator;
     using faces_reverse_iterator = face_container::reverse_iterator;
+
+    using position_type = dcel_no_data;
+    using vertex_data_type = dcel_no_data;
+    using half_edge_data_type = dcel_no_data;
+    using face_data_type = dcel_no_data;
+
+    static constexpr vertex_handle null_vertex = nullptr;
+    static constexpr half_edge_handle null_half_edge = nullptr;
+    static constexpr face_handle null_face = nullptr;
+
+    template <typename T>
+    static T* create(std::list<T>& container) {
+        container.emplace_back();
+        return &container.back();
+    }
+
+    template <typename T>
+    static void erase(std::list<T>& container, T* handle) {
+        container.erase(std::find_if(container.begin(), container.end(), [&](const T& element) {
+            return &element == handle;
+        }));
+    }
+
+    template <typename T>
+    static T& get(std::list<T>&, T* handle) { return *handle; }
+
+    template <typename T>
+    static const T& get(const std::list<T>&, T* handle) { return *handle; }
+
+    template <typename T>
+    static T* handle_of(const std::list<T>&, const T& element) { return const_cast<T*>(&element); }
+
+    template <typename T>
+    static void reserve(std::list<T>&, std::size_t) { }
+};
+
+/**
+ * Each element kind stored contiguously in a slot_vector, handles are 32-bit indices.  Erased elements leave a hole
+ * that the next element of their kind fills, so erasing is constant time and never moves another element.
+ *
+ * A position for every vertex and data of the given types for every vertex, half-edge and face are kept in side
+ * arrays next to the records, structure of arrays, and reached through dcel::position and dcel::data.  dcel_no_data
+ * leaves them out.
+ */
+template<typename Position, typename VertexData, typename HalfEdgeData, typename FaceData>
+struct dcel_vector_data_Traits {
+    using vertex = dcel_vertex<dcel_vector_data_Traits>;
+    using vertex_handle = dcel_index<vertex>;
+    using vertex_container = slot_vector<vertex>;
+    using vertices_iterator = typename vertex_container::iterator;
+    using vertices_reverse_iterator = typename vertex_container::reverse_iterator;
+
+    using half_edge = dcel_half_edge<dcel_vector_data_Traits>;
+    using half_edge_handle = dcel_index<half_edge>;
+    using half_edge_container = slot_vector<half_edge>;
+    using half_edges_iterator = typename half_edge_container::iterator;
+    using half_edges_reverse_iterator = typename half_edge_container::reverse_iterator;
+
+    using face = dcel_face<dcel_vector_data_Traits>;
+    using face_handle = dcel_index<face>;
+    using face_container = slot_vector<face>;
+    using faces_iterator = typename face_container::iterator;
+    using faces_reverse_iterator = typename face_container::reverse_iterator;
+
+    using position_type = Position;
+    using vertex_data_type = VertexData;
+    using half_edge_data_type = HalfEdgeData;
+    using face_data_type = FaceData;
+
+    static constexpr vertex_handle null_vertex = vertex_handle();
+    static constexpr half_edge_handle null_half_edge = half_edge_handle();
+    static constexpr face_handle null_face = face_handle();
+
+    template <typename T>
+    static dcel_index<T> create(slot_vector<T>& container) { return {container.insert()}; }
+
+    template <typename T>
+    static void erase(slot_vector<T>& container, dcel_index<T> handle) { container.erase(handle.index); }
+
+    template <typename T>
+    static T& get(slot_vector<T>& container, dcel_index<T> handle) { return container[handle.index]; }
+
+    template <typename T>
+    static const T& get(const slot_vector<T>& container, dcel_index<T> handle) { return container[handle.index]; }
+
+    template <typename T>
+    static dcel_index<T> handle_of(const slot_vector<T>& container, const T& element) {
+        return {container.index_of(element)};
+    }
+
+    template <typename T>
+    static void reserve(slot_vector<T>& container, std::size_t n) { container.reserve(n); }
 };
 
 template<typename Traits>
 class dcel {
 public:
     using vertex = typename Traits::vertex;
+    using vertex_handle = typename Traits::vertex_handle;
     using vertex_container = typename Traits::vertex_container;
     using vertices_iterator = typename Traits::vertices_iterator;
     using vertices_reverse_iterator = typename Traits::vertices_reverse_iterator;
 
     using half_edge = typename Traits::half_edge;
+    using half_edge_handle = typename Traits::half_edge_handle;
     using half_edge_container = typename Traits::half_edge_container;
     using half_edges_iterator = typename Traits::half_edges_iterator;
     using half_edges_reverse_iterator = typename Traits::half_edges_reverse_iterator;
 
     using face = typename Traits::face;
+    using face_handle = typename Traits::face_handle;
     using face_container = typename Traits::face_container;
     using faces_iterator = typename Traits::faces_iterator;
     using faces_reverse_iterator = typename Traits::faces_reverse_iterator;
 
+    using position_type = typename Traits::position_type;
+    using vertex_data_type = typename Traits::vertex_data_type;
+    using half_edge_data_type = typename Traits::half_edge_data_type;
+    using face_data_type = typename Traits::face_data_type;
+
     struct half_edge_loop_iterator;
     using half_edge_loop_reverse_iterator = std::reverse_iterator<half_edge_loop_iterator>;
 
@@ -89,112 +267,385 @@ public:
     using vertex_incident_reverse_iterator = std::reverse_iterator<vertex_incident_iterator>;
 
 public:
-    static constexpr vertex* null_vertex = nullptr;
-    static constexpr half_edge* null_half_edge = nullptr;
-    static constexpr face* null_face = nullptr;
+    static constexpr vertex_handle null_vertex = Traits::null_vertex;
+    static constexpr half_edge_handle null_half_edge = Traits::null_half_edge;
+    static constexpr face_handle null_face = Traits::null_face;
+
+    vertex& operator[](vertex_handle handle) { return Traits::get(vertices_, handle); }
+    const vertex& operator[](vertex_handle handle) const { return Traits::get(vertices_, handle); }
+    half_edge& operator[](half_edge_handle handle) { return Traits::get(half_edges_, handle); }
+    const half_edge& operator[](half_edge_handle handle) const { return Traits::get(half_edges_, handle); }
+    face& operator[](face_handle handle) { return Traits::get(faces_, handle); }
+    const face& operator[](face_handle handle) const { return Traits::get(faces_, handle); }
+
+    /**
+     * The handle of an element of this dcel, e.g. one reached through an iterator.
+     */
+    vertex_handle handle_of(const vertex& v) const { return Traits::handle_of(vertices_, v); }
+    half_edge_handle handle_of(const half_edge& h) const { return Traits::handle_of(half_edges_, h); }
+    face_handle handle_of(const face& f) const { return Traits::handle_of(faces_, f); }
+
+    /**
+     * The side array values of an element, for traits that keep them, e.g. dcel_vector_data_Traits.
+     */
+    position_type& position(vertex_handle handle) { return positions_[handle]; }
+    const position_type& position(vertex_handle handle) const { return positions_[handle]; }
+    vertex_data_type& data(vertex_handle handle) { return vertex_data_[handle]; }
+    const vertex_data_type& data(vertex_handle handle) const { return vertex_data_[handle]; }
+    half_edge_data_type& data(half_edge_handle handle) { return half_edge_data_[handle]; }
+    const half_edge_data_type& data(half_edge_handle handle) const { return half_edge_data_[handle]; }
+    face_data_type& data(face_handle handle) { return face_data_[handle]; }
+    const face_data_type& data(face_handle handle) const { return face_data_[handle]; }
+
+    void reserve(std::size_t n_vertices, std::size_t n_half_edges, std::size_t n_faces) {
+        Traits::reserve(vertices_, n_vertices);
+        Traits::reserve(half_edges_, n_half_edges);
+        Traits::reserve(faces_, n_faces);
+        positions_.reserve(n_vertices);
+        vertex_data_.reserve(n_vertices);
+        half_edge_data_.reserve(n_half_edges);
+        face_data_.reserve(n_faces);
+    }
 
     constexpr typename vertex_container::size_type vertices_size() const { return vertices_.size(); }
     constexpr bool vertices_empty() const { return vertices_.empty(); }
 
-    vertex* create_vertex() {
-        vertices_.emplace_back();
-        auto& v = vertices_.back();
-        v.incident = null_half_edge;
-        return &v;
+    vertex_handle create_vertex() {
+        auto handle = Traits::create(vertices_);
+        (*this)[handle].incident = null_half_edge;
+        positions_.assign(handle);
+        vertex_data_.assign(handle);
+        return handle;
+    }
+
+    /**
+     * Erases the vertex, handles to it are left dangling.
+     */
+    void erase_vertex(vertex_handle handle) {
+        Traits::erase(vertices_, handle);
     }
 
-    bool is_consistent(const vertex* handle) {
-        return handle->incident != null_half_edge;
+    bool is_consistent(vertex_handle handle) {
+        return (*this)[handle].incident != null_half_edge;
     }
 
     constexpr vertices_iterator vertices_begin() { return vertices_.begin(); }
     constexpr vertices_iterator vertices_end() { return vertices_.end(); }
+    constexpr auto vertices_begin() const { return vertices_.begin(); }
+    constexpr auto vertices_end() const { return vertices_.end(); }
     constexpr vertices_reverse_iterator vertices_rbegin() { return vertices_.rbegin(); }
     constexpr vertices_reverse_iterator vertices_rend() { return vertices_.rend(); }
 
     constexpr typename half_edge_container::size_type half_edges_size() const { return half_edges_.size(); }
     constexpr bool half_edges_empty() const { return half_edges_.empty(); }
 
-    half_edge* create_half_edge() {
-        half_edges_.emplace_back();
-        auto& h = half_edges_.back();
+    half_edge_handle create_half_edge() {
+        auto handle = Traits::create(half_edges_);
+        auto& h = (*this)[handle];
         h.origin = null_vertex;
         h.twin = null_half_edge;
         h.prev = null_half_edge;
         h.next = null_half_edge;
         h.face = null_face;
-        return &h;
+        half_edge_data_.assign(handle);
+        return handle;
     }
 
-    constexpr bool is_consistent(const half_edge* handle) {
-        return handle->origin != null_vertex &&
-            handle->twin != null_half_edge &&
-            handle->prev != null_half_edge &&
-            handle->next != null_half_edge &&
-            handle->face != null_face;
+    /**
+     * Erases the half-edge, handles to it are left dangling.
+     */
+    void erase_half_edge(half_edge_handle handle) {
+        Traits::erase(half_edges_, handle);
+    }
+
+    constexpr bool is_consistent(half_edge_handle handle) {
+        const auto& h = (*this)[handle];
+        return h.origin != null_vertex &&
+            h.twin != null_half_edge &&
+            h.prev != null_half_edge &&
+            h.next != null_half_edge &&
+            h.face != null_face;
     }
 
     constexpr half_edges_iterator half_edges_begin() { return half_edges_.begin(); }
     constexpr half_edges_iterator half_edges_end() { return half_edges_.end(); }
+    constexpr auto half_edges_begin() const { return half_edges_.begin(); }
+    constexpr auto half_edges_end() const { return half_edges_.end(); }
     constexpr half_edges_reverse_iterator half_edges_rbegin() { return half_edges_.rbegin(); }
     constexpr half_edges_reverse_iterator half_edges_rend() { return half_edges_.rend(); }
 
     constexpr typename face_container::size_type faces_size() const { return faces_.size(); }
     constexpr bool faces_empty() const { return faces_.empty(); }
 
-    face* create_face() {
-        faces_.emplace_back();
-        auto& f = faces_.back();
-        f.incident = null_half_edge;
-        return &f;
+    face_handle create_face() {
+        auto handle = Traits::create(faces_);
+        (*this)[handle].incident = null_half_edge;
+        face_data_.assign(handle);
+        return handle;
+    }
+
+    /**
+     * Erases the face, handles to it are left dangling.
+     */
+    void erase_face(face_handle handle) {
+        Traits::erase(faces_, handle);
     }
 
-    constexpr bool is_consistent(const face* handle) {
-        return handle->incident != null_half_edge;
+    constexpr bool is_consistent(face_handle handle) {
+        return (*this)[handle].incident != null_half_edge;
     }
 
     constexpr faces_iterator faces_begin() { return faces_.begin(); }
     constexpr faces_iterator faces_end() { return faces_.end(); }
+    constexpr auto faces_begin() const { return faces_.begin(); }
+    constexpr auto faces_end() const { return faces_.end(); }
     constexpr faces_reverse_iterator faces_rbegin() { return faces_.rbegin(); }
     constexpr faces_reverse_iterator faces_rend() { return faces_.rend(); }
 
-    half_edge_loop_iterator half_edge_loop_begin(half_edge* he) const {
-        return half_edge_loop_iterator(he);
+    /**
+     * Splits the edge of h, from u to v, at a new vertex w and returns w.  h keeps running from u, now to w, and its
+     * twin from v, now to w, the two new half-edges leave w.  Constant time.
+     */
+    vertex_handle split_edge_at(half_edge_handle h) {
+        const auto t = (*this)[h].twin;
+        const auto w = create_vertex();
+        const auto h2 = create_half_edge();
+        const auto t2 = create_half_edge();
+
+        link_after(h, h2, w);
+        link_after(t, t2, w);
+        (*this)[h].twin = t2;
+        (*this)[t2].twin = h;
+        (*this)[t].twin = h2;
+        (*this)[h2].twin = t;
+        (*this)[w].incident = h2;
+        return w;
+    }
+
+    /**
+     * Splits the face of a and b, two different half-edges of the same loop, by a new edge from the origin of a to the
+     * origin of b.  Returns its half-edge from a's origin, whose side holds b and a new face, the other side keeps the
+     * old face and holds a.  Linear in the length of the new face's boundary, as its half-edges change face.
+     */
+    half_edge_handle split_face_at(half_edge_handle a, half_edge_handle b) {
+        const auto f = (*this)[a].face;
+        const auto g = create_face();
+        const auto e = create_half_edge();
+        const auto e2 = create_half_edge();
+        const auto pa = (*this)[a].prev;
+        const auto pb = (*this)[b].prev;
+
+        auto& he = (*this)[e];
+        he.origin = (*this)[a].origin;
+        he.twin = e2;
+        he.prev = pa;
+        he.next = b;
+        auto& he2 = (*this)[e2];
+        he2.origin = (*this)[b].origin;
+        he2.twin = e;
+        he2.prev = pb;
+        he2.next = a;
+        he2.face = f;
+        (*this)[pa].next = e;
+        (*this)[b].prev = e;
+        (*this)[pb].next = e2;
+        (*this)[a].prev = e2;
+
+        (*this)[f].incident = e2;
+        (*this)[g].incident = e;
+        set_loop_face(e, g);
+        return e;
+    }
+
+    /**
+     * Removes the edge of h, between two different faces, and returns the face of h, which takes over the boundary of
+     * the other one.  Inverse of split_face_at on the twin of the half-edge it returned.  Linear in the length of the
+     * other face's boundary.
+     */
+    face_handle merge_faces_at(half_edge_handle h) {
+        const auto t = (*this)[h].twin;
+        const auto f = (*this)[h].face;
+        const auto g = (*this)[t].face;
+        assert(f != g);
+        const auto h_next = (*this)[h].next;
+        const auto t_next = (*this)[t].next;
+
+        const auto h_prev = (*this)[h].prev;
+        const auto t_prev = (*this)[t].prev;
+
+        for (auto x = t_next; x != t; x = (*this)[x].next)
+            (*this)[x].face = f;
+        (*this)[h_prev].next = t_next;
+        (*this)[t_next].prev = h_prev;
+        (*this)[t_prev].next = h_next;
+        (*this)[h_next].prev = t_prev;
+        if ((*this)[f].incident == h)
+            (*this)[f].incident = h_next;
+        replace_incident((*this)[h].origin, h, t_next);
+        replace_incident((*this)[t].origin, t, h_next);
+
+        erase_half_edge(h);
+        erase_half_edge(t);
+        erase_face(g);
+        return f;
+    }
+
+    /**
+     * Adds a vertex inside the face of h joined by a new edge to the origin of h, in the corner between h and its
+     * prev, and returns it.  Constant time.
+     */
+    vertex_handle add_vertex(half_edge_handle h) {
+        const auto w = create_vertex();
+        const auto e = create_half_edge();
+        const auto e2 = create_half_edge();
+        const auto p = (*this)[h].prev;
+        const auto f = (*this)[h].face;
+
+        auto& he = (*this)[e];
+        he.origin = (*this)[h].origin;
+        he.twin = e2;
+        he.prev = p;
+        he.next = e2;
+        he.face = f;
+        auto& he2 = (*this)[e2];
+        he2.origin = w;
+        he2.twin = e;
+        he2.prev = e;
+        he2.next = h;
+        he2.face = f;
+        (*this)[p].next = e;
+        (*this)[h].prev = e2;
+        (*this)[w].incident = e2;
+        return w;
     }
 
-    half_edge_loop_iterator half_edge_loop_end(half_edge* he) const {
-        return half_edge_loop_iterator(he, true);
+    /**
+     * Removes a vertex with one or two edges.  A vertex at the end of a single edge goes with the edge, undoing
+     * add_vertex, one between two edges is removed by joining them, undoing split_edge_at.  Constant time.
+     */
+    void remove_vertex(vertex_handle w) {
+        const auto a = (*this)[w].incident;
+        const auto t = (*this)[a].twin;
+        const auto b = (*this)[t].next;
+
+        if (b == a) {
+            const auto v = (*this)[t].origin;
+            const auto n = (*this)[a].next;
+            const auto f = (*this)[a].face;
+            if (n == t) {
+                // the edge was all there was of its component
+                (*this)[v].incident = null_half_edge;
+                if ((*this)[f].incident == a || (*this)[f].incident == t)
+                    (*this)[f].incident = null_half_edge;
+            }
+            else {
+                unlink(t);
+                unlink(a);
+                if ((*this)[f].incident == a || (*this)[f].incident == t)
+                    (*this)[f].incident = n;
+                replace_incident(v, t, n);
+            }
+            erase_half_edge(a);
+            erase_half_edge(t);
+            erase_vertex(w);
+            return;
+        }
+
+        // h runs into w before a and t before b, both are extended over the removed half-edges
+        const auto h = (*this)[b].twin;
+        assert((*this)[h].next == a);
+        unlink(a);
+        unlink(b);
+        (*this)[h].twin = t;
+        (*this)[t].twin = h;
+        replace_face_incident(a, h);
+        replace_face_incident(b, t);
+        erase_half_edge(a);
+        erase_half_edge(b);
+        erase_vertex(w);
     }
 
-    half_edge_loop_reverse_iterator half_edge_loop_rbegin(half_edge* he) const {
+    // the loop iterators give mutable access to the records, as handles do
+    half_edge_loop_iterator half_edge_loop_begin(half_edge_handle he) const {
+        return half_edge_loop_iterator(const_cast<dcel*>(this), he);
+    }
+
+    half_edge_loop_iterator half_edge_loop_end(half_edge_handle he) const {
+        return half_edge_loop_iterator(const_cast<dcel*>(this), he, true);
+    }
+
+    half_edge_loop_reverse_iterator half_edge_loop_rbegin(half_edge_handle he) const {
         return std::make_reverse_iterator(half_edge_loop_end(he));
     }
 
-    half_edge_loop_reverse_iterator half_edge_loop_rend(half_edge* he) const {
+    half_edge_loop_reverse_iterator half_edge_loop_rend(half_edge_handle he) const {
         return std::make_reverse_iterator(half_edge_loop_begin(he));
     }
 
-    vertex_incident_iterator vertex_incident_begin(half_edge* incident) const {
-        return vertex_incident_iterator(incident);
+    vertex_incident_iterator vertex_incident_begin(half_edge_handle incident) const {
+        return vertex_incident_iterator(const_cast<dcel*>(this), incident);
     }
 
-    vertex_incident_iterator vertex_incident_end(half_edge* incident) const {
-        return vertex_incident_iterator(incident, true);
+    vertex_incident_iterator vertex_incident_end(half_edge_handle incident) const {
+        return vertex_incident_iterator(const_cast<dcel*>(this), incident, true);
     }
 
-    vertex_incident_reverse_iterator vertex_incident_rbegin(half_edge* incident) const {
+    vertex_incident_reverse_iterator vertex_incident_rbegin(half_edge_handle incident) const {
         return std::make_reverse_iterator(vertex_incident_end(incident));
     }
 
-    vertex_incident_reverse_iterator vertex_incident_rend(half_edge* incident) const {
+    vertex_incident_reverse_iterator vertex_incident_rend(half_edge_handle incident) const {
         return std::make_reverse_iterator(vertex_incident_begin(incident));
     }
 
 private:
+    // puts the new half-edge h2 leaving w after h in its loop
+    void link_after(half_edge_handle h, half_edge_handle h2, vertex_handle w) {
+        auto& he = (*this)[h];
+        auto& he2 = (*this)[h2];
+        he2.origin = w;
+        he2.face = he.face;
+        he2.prev = h;
+        he2.next = he.next;
+        (*this)[he.next].prev = h2;
+        he.next = h2;
+    }
+
+    // takes h out of its loop, h keeps its links
+    void unlink(half_edge_handle h) {
+        const auto& he = (*this)[h];
+        (*this)[he.prev].next = he.next;
+        (*this)[he.next].prev = he.prev;
+    }
+
+    void set_loop_face(half_edge_handle first, face_handle f) {
+        auto h = first;
+        do {
+            (*this)[h].face = f;
+            h = (*this)[h].next;
+        } while (h != first);
+    }
+
+    void replace_incident(vertex_handle v, half_edge_handle old_incident, half_edge_handle new_incident) {
+        if ((*this)[v].incident == old_incident)
+            (*this)[v].incident = new_incident;
+    }
+
+    void replace_face_incident(half_edge_handle old_incident, half_edge_handle new_incident) {
+        auto& f = (*this)[(*this)[old_incident].face];
+        if (f.incident == old_incident)
+            f.incident = new_incident;
+    }
+
     vertex_container vertices_;
     half_edge_container half_edges_;
     face_container faces_;
 
+    dcel_side_array<position_type> positions_;
+    dcel_side_array<vertex_data_type> vertex_data_;
+    dcel_side_array<half_edge_data_type> half_edge_data_;
+    dcel_side_array<face_data_type> face_data_;
+
 public:
     struct half_edge_loop_iterator {
         using iterator_category = std::bidirectional_iterator_tag;
@@ -205,27 +656,33 @@ public:
 
         half_edge_loop_iterator() = delete;
 
-        half_edge_loop_iterator(half_edge* first, bool is_end = false)
-            : first_(first), he_(is_end ? nullptr : first)
+        half_edge_loop_iterator(dcel* d, half_edge_handle first, bool is_end = false)
+            : dcel_(d), first_(first), he_(is_end ? null_half_edge : first)
         { }
 
         half_edge_loop_iterator& operator++() {
-            if (he_ != nullptr)
-                he_ = he_->next != first_ ? he_->next : nullptr;
+            if (he_ != null_half_edge) {
+                const auto next = (*dcel_)[he_].next;
+                he_ = next != first_ ? next : null_half_edge;
+            }
             return *this;
         }
 
         half_edge_loop_iterator& operator--() {
             if (he_ != first_)
-                he_ = he_ == nullptr ? first_->prev : he_->prev;
+                he_ = he_ == null_half_edge ? (*dcel_)[first_].prev : (*dcel_)[he_].prev;
             return *this;
         }
 
         half_edge& operator*() const {
-            return *he_;
+            return (*dcel_)[he_];
         }
 
         half_edge* operator->() const {
+            return &(*dcel_)[he_];
+        }
+
+        half_edge_handle handle() const {
             return he_;
         }
 
@@ -238,8 +695,9 @@ public:
         }
 
     private:
-        const half_edge* first_;
-        half_edge* he_;
+        dcel* dcel_;
+        half_edge_handle first_;
+        half_edge_handle he_;
     };
 
     struct vertex_incident_iterator {
@@ -251,27 +709,35 @@ public:
 
         vertex_incident_iterator() = delete;
 
-        vertex_incident_iterator(half_edge* he, bool is_end = false)
-            : first_(he), he_(is_end ? nullptr : he)
+        vertex_incident_iterator(dcel* d, half_edge_handle he, bool is_end = false)
+            : dcel_(d), first_(he), he_(is_end ? null_half_edge : he)
         { }
 
         vertex_incident_iterator& operator++() {
-            if (he_ != nullptr)
-                he_ = he_->twin->next == first_ ? nullptr : he_->twin->next;
+            if (he_ != null_half_edge) {
+                const auto next = (*dcel_)[(*dcel_)[he_].twin].next;
+                he_ = next == first_ ? null_half_edge : next;
+            }
             return *this;
         }
 
         vertex_incident_iterator& operator--() {
-            if (he_ != first_)
-                he_ = he_ == nullptr ? first_->prev->twin : he_->prev->twin;
+            if (he_ != first_) {
+                const auto from = he_ == null_half_edge ? first_ : he_;
+                he_ = (*dcel_)[(*dcel_)[from].prev].twin;
+            }
             return *this;
         }
 
         half_edge& operator*() const {
-            return *he_;
+            return (*dcel_)[he_];
         }
 
         half_edge* operator->() const {
+            return &(*dcel_)[he_];
+        }
+
+        half_edge_handle handle() const {
             return he_;
         }
 
@@ -284,11 +750,41 @@ public:
         }
 
     private:
-        const half_edge* first_;
-        half_edge* he_;
+        dcel* dcel_;
+        half_edge_handle first_;
+        half_edge_handle he_;
     };
 };
 
+/**
+ * Signed area inside the loop of the half-edge h of a dcel with vec2 positions, positive if it runs
+ * counter-clockwise.  Reads the positions from their side array.
+ */
+template<typename Traits>
+auto loop_area_2D(const dcel<Traits>& d, typename Traits::half_edge_handle h) {
+    using scalar_type = typename Traits::position_type::scalar_type;
+    scalar_type area = (scalar_type)0;
+    for (auto it = d.half_edge_loop_begin(h); it != d.half_edge_loop_end(h); ++it)
+        area += dot_perp(d.position(it->origin), d.position(d[it->next].origin));
+    return area / (scalar_type)2;
+}
+
+/**
+ * Signed area of the face f of a dcel with vec2 positions, see loop_area_2D.
+ */
+template<typename Traits>
+auto face_area_2D(const dcel<Traits>& d, typename Traits::face_handle f) {
+    return loop_area_2D(d, d[f].incident);
+}
+
+/**
+ * Length of the edge of the half-edge h of a dcel with vec positions.
+ */
+template<typename Traits>
+auto edge_length(const dcel<Traits>& d, typename Traits::half_edge_handle h) {
+    return length(d.position(d[d[h].twin].origin) - d.position(d[h].origin));
+}
+
 } // ds
 } // mtlib
 
@@ -0,0 +1,293 @@
+#ifndef _MTLIB_DS_DCEL_FROM_POLYGONS_H_
+#define _MTLIB_DS_DCEL_FROM_POLYGONS_H_
+
+#include "MTLib/ds/dcel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mtlib {
+namespace ds {
+
+/**
+ * A dcel built from indexed polygons, with the handles of the input's vertices and polygons.
+ */
+template <typename Traits = dcel_vector_Traits>
+struct polygon_mesh {
+    ds::dcel<Traits> dcel;
+
+    // vertex i of the input, polygon i of the input
+    std::vector<typename Traits::vertex_handle> vertices;
+    std::vector<typename Traits::face_handle> faces;
+
+    // holds every boundary, its incident half-edge is on one of them, null when there is no boundary
+    typename Traits::face_handle outer_face = Traits::null_face;
+
+    // the polygon half-edges of the edges shared by more than two polygons or twice in the same direction
+    std::vector<typename Traits::half_edge_handle> non_manifold;
+};
+
+/**
+ * Builds the dcel of polygons given by indices into points.  Polygon f has the corners
+ * points[indices[offsets[f]]], ..., points[indices[offsets[f + 1] - 1]] in counter-clockwise order, so offsets holds
+ * one more entry than there are polygons.
+ *
+ * Every corner gives the half-edge to the next corner, in a face of its own.  The twins are matched by hashing the
+ * (min, max) vertex pair of every half-edge into partitions that n_threads threads fill and resolve independently.
+ * An edge used by exactly two polygons in opposite directions joins them.  Any other edge is a boundary: each of its
+ * polygon half-edges gets a twin on the outer face, and the edge is listed as non-manifold unless a single polygon
+ * uses it.  The boundaries are linked around their vertices in the same parallel pass, so the outer face walks them
+ * clockwise.  Vertices used by no polygon have no incident half-edge, the others one leaving them on a boundary when
+ * they are on one.  Traits with vertex positions, see dcel_vector_data_Traits, take them from points.
+ */
+template <typename Traits = dcel_vector_Traits, typename Point>
+polygon_mesh<Traits> dcel_from_polygons(
+    const std::vector<Point>& points, const std::vector<std::uint32_t>& indices,
+    const std::vector<std::uint32_t>& offsets, std::size_t n_threads = std::thread::hardware_concurrency()
+) {
+    using std::uint32_t;
+    using std::uint64_t;
+    constexpr uint32_t null_number = ~uint32_t(0);
+
+    const std::size_t n_polygons = offsets.empty() ? 0 : offsets.size() - 1;
+    const uint32_t m = n_polygons ? offsets.back() : 0;
+    assert(offsets.empty() || offsets.front() == 0);
+    assert(indices.size() == m);
+    n_threads = std::max<std::size_t>(1, n_threads);
+
+    // calls work(begin, end) on n_threads consecutive parts of [0, n)
+    const auto run = [&](std::size_t n, auto work) {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1; t < n_threads; ++t)
+            threads.emplace_back(work, t, n * t / n_threads, n * (t + 1) / n_threads);
+        work(0, 0, n / n_threads);
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    // the polygon half-edges are numbered by their corner, next and prev stay within the polygon
+    std::vector<uint32_t> next(m), prev(m);
+    run(n_polygons, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto f = begin; f < end; ++f) {
+            const auto first = offsets[f];
+            const auto last = offsets[f + 1];
+            assert(last - first >= 2);
+            for (auto h = first; h < last; ++h) {
+                next[h] = h + 1 < last ? h + 1 : first;
+                prev[h] = h > first ? h - 1 : last - 1;
+            }
+        }
+    });
+
+    const auto key = [&](uint32_t h) {
+        const auto u = indices[h];
+        const auto v = indices[next[h]];
+        return static_cast<uint64_t>(std::min(u, v)) << 32 | std::max(u, v);
+    };
+    const auto hash = [](uint64_t k) { return k * 0x9e3779b97f4a7c15ull; };
+
+    // partitions of about 2^16 half-edges keep every hash table in cache
+    int partition_bits = 1;
+    while ((std::size_t(1) << partition_bits) < std::max<std::size_t>(4 * n_threads, m >> 16))
+        ++partition_bits;
+    const std::size_t n_partitions = std::size_t(1) << partition_bits;
+    const auto partition_of = [&](uint32_t h) {
+        return static_cast<std::size_t>(hash(key(h)) >> (64 - partition_bits));
+    };
+
+    // scatter the half-edges to their partitions, each thread into its own range of every partition
+    std::vector<std::vector<uint32_t>> counts(n_threads, std::vector<uint32_t>(n_partitions + 1, 0));
+    run(m, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        for (auto h = static_cast<uint32_t>(begin); h < end; ++h)
+            ++counts[t][partition_of(h)];
+    });
+    std::vector<uint32_t> partition_offsets(n_partitions + 1, 0);
+    uint32_t total = 0;
+    for (std::size_t p = 0; p < n_partitions; ++p) {
+        partition_offsets[p] = total;
+        for (std::size_t t = 0; t < n_threads; ++t) {
+            const auto count = counts[t][p];
+            counts[t][p] = total;
+            total += count;
+        }
+    }
+    partition_offsets[n_partitions] = total;
+
+    // every half-edge goes with its key and whether it runs from the smaller vertex to the larger one
+    struct keyed_half_edge {
+        uint64_t key;
+        uint32_t h;
+        uint32_t forward;
+    };
+    std::vector<keyed_half_edge> keyed(m);
+    run(m, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        for (auto h = static_cast<uint32_t>(begin); h < end; ++h)
+            keyed[counts[t][partition_of(h)]++] = {key(h), h, indices[h] < indices[next[h]]};
+    });
+
+    // match the twins in every partition with an open addressing table, the half-edges of one edge are chained
+    std::vector<uint32_t> twin(m);
+    std::vector<char> flagged(m, 0);
+    run(n_partitions, [&](std::size_t, std::size_t begin, std::size_t end) {
+        struct slot {
+            uint64_t key;
+            uint32_t head;
+            uint32_t count;
+        };
+        constexpr uint64_t empty = ~uint64_t(0);
+        std::vector<slot> table;
+        std::vector<uint32_t> chain;
+        for (auto p = begin; p < end; ++p) {
+            const auto part = keyed.data() + partition_offsets[p];
+            const auto size = partition_offsets[p + 1] - partition_offsets[p];
+            int table_bits = 4;
+            while ((std::size_t(1) << table_bits) < 2 * std::size_t(size))
+                ++table_bits;
+            const auto mask = (std::size_t(1) << table_bits) - 1;
+            table.assign(mask + 1, {empty, null_number, 0});
+            chain.resize(size);
+
+            for (uint32_t i = 0; i < size; ++i) {
+                const auto k = part[i].key;
+                auto s = static_cast<std::size_t>(hash(k) << partition_bits >> (64 - table_bits));
+                while (table[s].key != empty && table[s].key != k)
+                    s = (s + 1) & mask;
+                table[s].key = k;
+                chain[i] = table[s].head;
+                table[s].head = i;
+                ++table[s].count;
+            }
+
+            for (const auto& entry : table) {
+                if (entry.key == empty)
+                    continue;
+                const auto& a = part[entry.head];
+                if (entry.count == 2 && a.forward != part[chain[entry.head]].forward) {
+                    const auto& b = part[chain[entry.head]];
+                    twin[a.h] = b.h;
+                    twin[b.h] = a.h;
+                    continue;
+                }
+                for (auto i = entry.head; i != null_number; i = chain[i]) {
+                    twin[part[i].h] = null_number;
+                    flagged[part[i].h] = entry.count > 1;
+                }
+            }
+        }
+    });
+    keyed = std::vector<keyed_half_edge>();
+
+    // number the outer half-edges after the polygon ones, in the order of their twins
+    std::vector<uint32_t> n_boundary(n_threads + 1, 0);
+    run(m, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        n_boundary[t + 1] = static_cast<uint32_t>(std::count(twin.begin() + begin, twin.begin() + end, null_number));
+    });
+    for (std::size_t t = 0; t < n_threads; ++t)
+        n_boundary[t + 1] += n_boundary[t];
+    const auto b = n_boundary[n_threads];
+    assert(std::size_t(m) + b < null_number);
+
+    std::vector<uint32_t> boundary_twin(b);
+    run(m, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        auto r = n_boundary[t];
+        for (auto h = begin; h < end; ++h) {
+            if (twin[h] == null_number) {
+                boundary_twin[r] = static_cast<uint32_t>(h);
+                twin[h] = m + r++;
+            }
+        }
+    });
+
+    // create the elements, then link them in parallel, every record is written by one thread
+    polygon_mesh<Traits> result;
+    auto& d = result.dcel;
+    d.reserve(points.size(), std::size_t(m) + b, n_polygons + 1);
+    result.vertices.reserve(points.size());
+    for (std::size_t v = 0; v < points.size(); ++v) {
+        result.vertices.push_back(d.create_vertex());
+        if constexpr (!std::is_same_v<typename Traits::position_type, dcel_no_data>)
+            d.position(result.vertices.back()) = points[v];
+    }
+    std::vector<typename Traits::half_edge_handle> half_edges;
+    half_edges.reserve(std::size_t(m) + b);
+    for (std::size_t h = 0; h < std::size_t(m) + b; ++h)
+        half_edges.push_back(d.create_half_edge());
+    result.faces.reserve(n_polygons);
+    for (std::size_t f = 0; f < n_polygons; ++f)
+        result.faces.push_back(d.create_face());
+    result.outer_face = d.create_face();
+
+    run(n_polygons, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto f = begin; f < end; ++f) {
+            d[result.faces[f]].incident = half_edges[offsets[f]];
+            for (auto h = offsets[f]; h < offsets[f + 1]; ++h) {
+                auto& he = d[half_edges[h]];
+                he.origin = result.vertices[indices[h]];
+                he.twin = half_edges[twin[h]];
+                he.next = half_edges[next[h]];
+                he.prev = half_edges[prev[h]];
+                he.face = result.faces[f];
+            }
+        }
+    });
+
+    // the outer half-edge after the one ending at u is the first outer one found turning clockwise around u
+    run(b, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto r = begin; r < end; ++r) {
+            const auto e = boundary_twin[r];
+            auto h = e;
+            while (twin[prev[h]] < m)
+                h = twin[prev[h]];
+            const auto following = twin[prev[h]];
+
+            auto& he = d[half_edges[m + r]];
+            he.origin = result.vertices[indices[next[e]]];
+            he.twin = half_edges[e];
+            he.next = half_edges[following];
+            he.face = result.outer_face;
+            d[half_edges[following]].prev = half_edges[m + r];
+        }
+    });
+
+    for (auto h = m; h-- > 0;)
+        d[result.vertices[indices[h]]].incident = half_edges[h];
+    for (auto r = b; r-- > 0;)
+        d[result.vertices[indices[next[boundary_twin[r]]]]].incident = half_edges[m + r];
+    if (b > 0)
+        d[result.outer_face].incident = half_edges[m];
+
+    for (uint32_t h = 0; h < m; ++h) {
+        if (flagged[h])
+            result.non_manifold.push_back(half_edges[h]);
+    }
+
+    return result;
+}
+
+/**
+ * dcel_from_polygons with every polygon given as a container of vertex indices.
+ */
+template <typename Traits = dcel_vector_Traits, typename Point, typename Polygon>
+polygon_mesh<Traits> dcel_from_polygons(
+    const std::vector<Point>& points, const std::vector<Polygon>& polygons,
+    std::size_t n_threads = std::thread::hardware_concurrency()
+) {
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint32_t> offsets(1, 0);
+    for (const auto& polygon : polygons) {
+        for (const auto& index : polygon)
+            indices.push_back(static_cast<std::uint32_t>(index));
+        offsets.push_back(static_cast<std::uint32_t>(indices.size()));
+    }
+    return dcel_from_polygons<Traits>(points, indices, offsets, n_threads);
+}
+
+}   // namespace ds
+}   // namespace mtlib
+
+#endif // _MTLIB_DS_DCEL_FROM_POLYGONS_H_
@@ -0,0 +1,533 @@
+#ifndef _MTLIB_DS_FROZEN_DCEL_H_
+#define _MTLIB_DS_FROZEN_DCEL_H_
+
+#include "MTLib/ds/dcel.h"
+#include "MTLib/util/span.h"
+
+#include <cassert>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t, uintptr_t
+#include <iterator>
+#include <vector>
+
+namespace mtlib {
+namespace ds {
+
+/**
+ * Records and handles of a frozen_dcel, the handles are 32-bit indices into its arrays.
+ */
+struct frozen_dcel_Traits {
+    using vertex = dcel_vertex<frozen_dcel_Traits>;
+    using vertex_handle = dcel_index<vertex>;
+
+    using half_edge = dcel_half_edge<frozen_dcel_Traits>;
+    using half_edge_handle = dcel_index<half_edge>;
+
+    using face = dcel_face<frozen_dcel_Traits>;
+    using face_handle = dcel_index<face>;
+
+    static constexpr vertex_handle null_vertex = vertex_handle();
+    static constexpr half_edge_handle null_half_edge = half_edge_handle();
+    static constexpr face_handle null_face = face_handle();
+};
+
+/**
+ * An immutable dcel laid out for reading, made from a dcel by freeze().
+ *
+ * Each kind of element lives in one array and handles are 32-bit indices into it.  The half-edges are grouped by face
+ * and each boundary is stored in loop order, the one through the face's incident half-edge first, so walking around a
+ * face reads consecutive memory.  The half-edges leaving each vertex are listed contiguously in ring order starting
+ * with the vertex's incident half-edge (CSR), and the incident iterators walk that list instead of the twin and next
+ * links.  Vertices and faces keep the iteration order of the dcel they were frozen from.
+ */
+class frozen_dcel {
+public:
+    using Traits = frozen_dcel_Traits;
+
+    using vertex = Traits::vertex;
+    using vertex_handle = Traits::vertex_handle;
+    using vertices_iterator = std::vector<vertex>::const_iterator;
+    using vertices_reverse_iterator = std::vector<vertex>::const_reverse_iterator;
+
+    using half_edge = Traits::half_edge;
+    using half_edge_handle = Traits::half_edge_handle;
+    using half_edges_iterator = std::vector<half_edge>::const_iterator;
+    using half_edges_reverse_iterator = std::vector<half_edge>::const_reverse_iterator;
+
+    using face = Traits::face;
+    using face_handle = Traits::face_handle;
+    using faces_iterator = std::vector<face>::const_iterator;
+    using faces_reverse_iterator = std::vector<face>::const_reverse_iterator;
+
+    struct half_edge_loop_iterator;
+    using half_edge_loop_reverse_iterator = std::reverse_iterator<half_edge_loop_iterator>;
+
+    struct vertex_incident_iterator;
+    using vertex_incident_reverse_iterator = std::reverse_iterator<vertex_incident_iterator>;
+
+    static constexpr vertex_handle null_vertex = Traits::null_vertex;
+    static constexpr half_edge_handle null_half_edge = Traits::null_half_edge;
+    static constexpr face_handle null_face = Traits::null_face;
+
+    const vertex& operator[](vertex_handle handle) const { return vertices_[handle.index]; }
+    const half_edge& operator[](half_edge_handle handle) const { return half_edges_[handle.index]; }
+    const face& operator[](face_handle handle) const { return faces_[handle.index]; }
+
+    vertex_handle handle_of(const vertex& v) const { return {index_of(vertices_, v)}; }
+    half_edge_handle handle_of(const half_edge& h) const { return {index_of(half_edges_, h)}; }
+    face_handle handle_of(const face& f) const { return {index_of(faces_, f)}; }
+
+    std::size_t vertices_size() const { return vertices_.size(); }
+    bool vertices_empty() const { return vertices_.empty(); }
+
+    bool is_consistent(vertex_handle handle) const {
+        return (*this)[handle].incident != null_half_edge;
+    }
+
+    vertices_iterator vertices_begin() const { return vertices_.begin(); }
+    vertices_iterator vertices_end() const { return vertices_.end(); }
+    vertices_reverse_iterator vertices_rbegin() const { return vertices_.rbegin(); }
+    vertices_reverse_iterator vertices_rend() const { return vertices_.rend(); }
+
+    std::size_t half_edges_size() const { return half_edges_.size(); }
+    bool half_edges_empty() const { return half_edges_.empty(); }
+
+    bool is_consistent(half_edge_handle handle) const {
+        const auto& h = (*this)[handle];
+        return h.origin != null_vertex &&
+            h.twin != null_half_edge &&
+            h.prev != null_half_edge &&
+            h.next != null_half_edge &&
+            h.face != null_face;
+    }
+
+    half_edges_iterator half_edges_begin() const { return half_edges_.begin(); }
+    half_edges_iterator half_edges_end() const { return half_edges_.end(); }
+    half_edges_reverse_iterator half_edges_rbegin() const { return half_edges_.rbegin(); }
+    half_edges_reverse_iterator half_edges_rend() const { return half_edges_.rend(); }
+
+    std::size_t faces_size() const { return faces_.size(); }
+    bool faces_empty() const { return faces_.empty(); }
+
+    bool is_consistent(face_handle handle) const {
+        return (*this)[handle].incident != null_half_edge;
+    }
+
+    faces_iterator faces_begin() const { return faces_.begin(); }
+    faces_iterator faces_end() const { return faces_.end(); }
+    faces_reverse_iterator faces_rbegin() const { return faces_.rbegin(); }
+    faces_reverse_iterator faces_rend() const { return faces_.rend(); }
+
+    /**
+     * Every half-edge of the face, the boundary through its incident half-edge first in loop order, then the others.
+     */
+    span<const half_edge> face_half_edges(face_handle handle) const {
+        const auto first = face_offsets_[handle.index];
+        return {half_edges_.data() + first, face_offsets_[handle.index + 1] - first};
+    }
+
+    /**
+     * The half-edges leaving the vertex in the order of vertex_incident_iterator, its incident half-edge first.
+     */
+    span<const half_edge_handle> vertex_half_edges(vertex_handle handle) const {
+        const auto first = ring_offsets_[handle.index];
+        return {ring_.data() + first, ring_offsets_[handle.index + 1] - first};
+    }
+
+    half_edge_loop_iterator half_edge_loop_begin(half_edge_handle he) const {
+        return half_edge_loop_iterator(this, he);
+    }
+
+    half_edge_loop_iterator half_edge_loop_end(half_edge_handle he) const {
+        return half_edge_loop_iterator(this, he, true);
+    }
+
+    half_edge_loop_reverse_iterator half_edge_loop_rbegin(half_edge_handle he) const {
+        return std::make_reverse_iterator(half_edge_loop_end(he));
+    }
+
+    half_edge_loop_reverse_iterator half_edge_loop_rend(half_edge_handle he) const {
+        return std::make_reverse_iterator(half_edge_loop_begin(he));
+    }
+
+    vertex_incident_iterator vertex_incident_begin(half_edge_handle incident) const {
+        return vertex_incident_iterator(this, incident);
+    }
+
+    vertex_incident_iterator vertex_incident_end(half_edge_handle incident) const {
+        return vertex_incident_iterator(this, incident, true);
+    }
+
+    vertex_incident_reverse_iterator vertex_incident_rbegin(half_edge_handle incident) const {
+        return std::make_reverse_iterator(vertex_incident_end(incident));
+    }
+
+    vertex_incident_reverse_iterator vertex_incident_rend(half_edge_handle incident) const {
+        return std::make_reverse_iterator(vertex_incident_begin(incident));
+    }
+
+private:
+    template <typename T>
+    static std::uint32_t index_of(const std::vector<T>& elements, const T& element) {
+        return static_cast<std::uint32_t>(&element - elements.data());
+    }
+
+    template <typename DcelTraits>
+    friend frozen_dcel freeze(const dcel<DcelTraits>& d);
+
+    std::vector<vertex> vertices_;
+    std::vector<half_edge> half_edges_;
+    std::vector<face> faces_;
+
+    // the half-edges of face f are [face_offsets_[f], face_offsets_[f + 1]), the ones without a face come last
+    std::vector<std::uint32_t> face_offsets_;
+
+    // the half-edges leaving vertex v are ring_[ring_offsets_[v]] to ring_[ring_offsets_[v + 1] - 1], ring_slot_
+    // holds the position of every half-edge in ring_
+    std::vector<std::uint32_t> ring_offsets_;
+    std::vector<half_edge_handle> ring_;
+    std::vector<std::uint32_t> ring_slot_;
+
+public:
+    struct half_edge_loop_iterator {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = half_edge;
+        using difference_type = std::size_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        half_edge_loop_iterator() = delete;
+
+        half_edge_loop_iterator(const frozen_dcel* d, half_edge_handle first, bool is_end = false)
+            : dcel_(d), first_(first), he_(is_end ? null_half_edge : first)
+        { }
+
+        half_edge_loop_iterator& operator++() {
+            if (he_ != null_half_edge) {
+                const auto next = (*dcel_)[he_].next;
+                he_ = next != first_ ? next : null_half_edge;
+            }
+            return *this;
+        }
+
+        half_edge_loop_iterator& operator--() {
+            if (he_ != first_)
+                he_ = he_ == null_half_edge ? (*dcel_)[first_].prev : (*dcel_)[he_].prev;
+            return *this;
+        }
+
+        const half_edge& operator*() const {
+            return (*dcel_)[he_];
+        }
+
+        const half_edge* operator->() const {
+            return &(*dcel_)[he_];
+        }
+
+        half_edge_handle handle() const {
+            return he_;
+        }
+
+        bool operator==(const half_edge_loop_iterator& other) const {
+            return he_ == other.he_;
+        }
+
+        bool operator!=(const half_edge_loop_iterator& other) const {
+            return he_ != other.he_;
+        }
+
+    private:
+        const frozen_dcel* dcel_;
+        half_edge_handle first_;
+        half_edge_handle he_;
+    };
+
+    /**
+     * Steps through the ring of the origin of a half-edge, wrapping around at the end of the ring's slots.
+     */
+    struct vertex_incident_iterator {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = half_edge;
+        using difference_type = std::size_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        static constexpr std::uint32_t null_slot = ~std::uint32_t(0);
+
+        vertex_incident_iterator() = delete;
+
+        vertex_incident_iterator(const frozen_dcel* d, half_edge_handle he, bool is_end = false)
+            : dcel_(d),
+              begin_(d->ring_offsets_[(*d)[he].origin.index]),
+              end_(d->ring_offsets_[(*d)[he].origin.index + 1]),
+              first_(d->ring_slot_[he.index]),
+              slot_(is_end ? null_slot : first_)
+        {
+            assert(first_ != null_slot);
+        }
+
+        vertex_incident_iterator& operator++() {
+            if (slot_ != null_slot) {
+                const auto next = slot_ + 1 != end_ ? slot_ + 1 : begin_;
+                slot_ = next == first_ ? null_slot : next;
+            }
+            return *this;
+        }
+
+        vertex_incident_iterator& operator--() {
+            if (slot_ != first_) {
+                const auto from = slot_ == null_slot ? first_ : slot_;
+                slot_ = from != begin_ ? from - 1 : end_ - 1;
+            }
+            return *this;
+        }
+
+        const half_edge& operator*() const {
+            return (*dcel_)[dcel_->ring_[slot_]];
+        }
+
+        const half_edge* operator->() const {
+            return &(*dcel_)[dcel_->ring_[slot_]];
+        }
+
+        half_edge_handle handle() const {
+            return slot_ == null_slot ? null_half_edge : dcel_->ring_[slot_];
+        }
+
+        bool operator==(const vertex_incident_iterator& other) const {
+            return slot_ == other.slot_;
+        }
+
+        bool operator!=(const vertex_incident_iterator& other) const {
+            return slot_ != other.slot_;
+        }
+
+    private:
+        const frozen_dcel* dcel_;
+        std::uint32_t begin_;
+        std::uint32_t end_;
+        std::uint32_t first_;
+        std::uint32_t slot_;
+    };
+};
+
+/**
+ * Numbers the elements of one kind of a dcel in iteration order, looked up by handle.  Pointer handles go through a
+ * flat open addressing table of at least twice as many slots as elements, index handles through an array indexed by
+ * the handle.
+ */
+template <typename Handle>
+class dcel_numbering {
+public:
+    static constexpr std::uint32_t null_number = ~std::uint32_t(0);
+
+    template <typename InputIt, typename HandleOf>
+    dcel_numbering(InputIt first, InputIt last, HandleOf handle_of) {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        int table_bits = 4;
+        while ((std::size_t(1) << table_bits) < 2 * n)
+            ++table_bits;
+        shift_ = 64 - table_bits;
+        mask_ = (std::size_t(1) << table_bits) - 1;
+        table_.assign(mask_ + 1, {Handle(), null_number});
+
+        for (std::uint32_t i = 0; first != last; ++first, ++i) {
+            const auto handle = handle_of(*first);
+            auto s = slot_of(handle);
+            while (table_[s].handle != Handle())
+                s = (s + 1) & mask_;
+            table_[s] = {handle, i};
+        }
+    }
+
+    std::uint32_t operator()(Handle handle) const {
+        if (handle == Handle())
+            return null_number;
+        auto s = slot_of(handle);
+        while (table_[s].handle != handle) {
+            assert(table_[s].handle != Handle());
+            s = (s + 1) & mask_;
+        }
+        return table_[s].number;
+    }
+
+    /**
+     * Replaces every number i by numbers[i].
+     */
+    void renumber(const std::vector<std::uint32_t>& numbers) {
+        for (auto& entry : table_) {
+            if (entry.handle != Handle())
+                entry.number = numbers[entry.number];
+        }
+    }
+
+private:
+    struct entry {
+        Handle handle;
+        std::uint32_t number;
+    };
+
+    std::size_t slot_of(Handle handle) const {
+        return static_cast<std::size_t>(
+            (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(handle)) * 0x9e3779b97f4a7c15ull) >> shift_
+        );
+    }
+
+    std::vector<entry> table_;
+    int shift_ = 64;
+    std::size_t mask_ = 0;
+};
+
+/**
+ * Index handles of a dcel without erased elements are numbered by their index already, so the array is only filled
+ * once an element is out of place or renumber() is called.
+ */
+template <typename Element>
+class dcel_numbering<dcel_index<Element>> {
+public:
+    static constexpr std::uint32_t null_number = ~std::uint32_t(0);
+
+    template <typename InputIt, typename HandleOf>
+    dcel_numbering(InputIt first, InputIt last, HandleOf handle_of) {
+        for (std::uint32_t i = 0; first != last; ++first, ++i) {
+            const auto index = handle_of(*first).index;
+            if (identity_ && index == i)
+                continue;
+            if (identity_) {
+                numbers_.resize(i);
+                for (std::uint32_t j = 0; j < i; ++j)
+                    numbers_[j] = j;
+                identity_ = false;
+            }
+            if (index >= numbers_.size())
+                numbers_.resize(index + 1, null_number);
+            numbers_[index] = i;
+        }
+    }
+
+    std::uint32_t operator()(dcel_index<Element> handle) const {
+        if (identity_)
+            return handle.index;
+        return handle.index != handle.null_index ? numbers_[handle.index] : null_number;
+    }
+
+    /**
+     * Replaces every number i by numbers[i].
+     */
+    void renumber(const std::vector<std::uint32_t>& numbers) {
+        if (identity_) {
+            numbers_ = numbers;
+            identity_ = false;
+            return;
+        }
+        for (auto& number : numbers_) {
+            if (number != null_number)
+                number = numbers[number];
+        }
+    }
+
+private:
+    bool identity_ = true;
+    std::vector<std::uint32_t> numbers_;
+};
+
+/**
+ * Copies a dcel into a frozen_dcel in time linear in its size.
+ *
+ * Vertex i and face i of the result are the i-th ones in iteration order of d, the half-edges are reordered face by
+ * face as frozen_dcel describes, with the half-edges without a face at the end.  Null links stay null.  The incident
+ * rings are read from the incident half-edge of every vertex, so those must be closed.
+ */
+template <typename Traits>
+frozen_dcel freeze(const dcel<Traits>& d) {
+    using std::uint32_t;
+    using half_edge_handle = typename Traits::half_edge_handle;
+    using frozen_half_edge = frozen_dcel::half_edge_handle;
+    constexpr uint32_t null_number = ~uint32_t(0);
+
+    frozen_dcel result;
+    const auto handle_of = [&](const auto& element) { return d.handle_of(element); };
+    const dcel_numbering<typename Traits::vertex_handle> vertex_number(d.vertices_begin(), d.vertices_end(), handle_of);
+    dcel_numbering<half_edge_handle> half_edge_number(d.half_edges_begin(), d.half_edges_end(), handle_of);
+    const dcel_numbering<typename Traits::face_handle> face_number(d.faces_begin(), d.faces_end(), handle_of);
+
+    // count the half-edges of every face, the ones without a face go after the last face
+    const auto n_faces = static_cast<uint32_t>(d.faces_size());
+    std::vector<half_edge_handle> old_half_edges;
+    std::vector<uint32_t> face_of;
+    old_half_edges.reserve(d.half_edges_size());
+    face_of.reserve(d.half_edges_size());
+    std::vector<uint32_t> offsets(n_faces + 2, 0);
+    for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h) {
+        old_half_edges.push_back(d.handle_of(*h));
+        face_of.push_back(h->face != Traits::null_face ? face_number(h->face) : n_faces);
+        ++offsets[face_of.back() + 1];
+    }
+    for (uint32_t f = 0; f <= n_faces; ++f)
+        offsets[f + 1] += offsets[f];
+
+    // place the loops face by face, starting with the boundary through the incident half-edge of each face
+    std::vector<uint32_t> new_number(old_half_edges.size(), null_number);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    const auto place_loop = [&](half_edge_handle first) {
+        for (auto h = d.half_edge_loop_begin(first); h != d.half_edge_loop_end(first); ++h) {
+            const auto i = half_edge_number(h.handle());
+            if (new_number[i] != null_number)
+                break;
+            new_number[i] = cursor[face_of[i]]++;
+        }
+    };
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f) {
+        if (f->incident != Traits::null_half_edge)
+            place_loop(f->incident);
+    }
+    for (uint32_t i = 0; i < old_half_edges.size(); ++i) {
+        if (new_number[i] == null_number)
+            place_loop(old_half_edges[i]);
+    }
+
+    // from here on the half-edges are looked up by their place in the result
+    half_edge_number.renumber(new_number);
+    const auto new_half_edge = [&](half_edge_handle h) -> frozen_half_edge { return {half_edge_number(h)}; };
+
+    result.half_edges_.resize(old_half_edges.size());
+    for (uint32_t i = 0; i < old_half_edges.size(); ++i) {
+        const auto& h = d[old_half_edges[i]];
+        auto& frozen = result.half_edges_[new_number[i]];
+        frozen.origin = {vertex_number(h.origin)};
+        frozen.twin = new_half_edge(h.twin);
+        frozen.next = new_half_edge(h.next);
+        frozen.prev = new_half_edge(h.prev);
+        frozen.face = {face_of[i] != n_faces ? face_of[i] : null_number};
+    }
+
+    result.faces_.reserve(n_faces);
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f)
+        result.faces_.push_back({new_half_edge(f->incident)});
+    result.face_offsets_.assign(offsets.begin(), offsets.end() - 1);
+
+    // list the ring of every vertex from its incident half-edge
+    result.vertices_.reserve(d.vertices_size());
+    result.ring_offsets_.reserve(d.vertices_size() + 1);
+    result.ring_.reserve(old_half_edges.size());
+    result.ring_slot_.assign(old_half_edges.size(), null_number);
+    result.ring_offsets_.push_back(0);
+    for (auto v = d.vertices_begin(); v != d.vertices_end(); ++v) {
+        result.vertices_.push_back({new_half_edge(v->incident)});
+        if (v->incident != Traits::null_half_edge) {
+            for (auto h = d.vertex_incident_begin(v->incident); h != d.vertex_incident_end(v->incident); ++h) {
+                const auto frozen = new_half_edge(h.handle());
+                result.ring_slot_[frozen.index] = static_cast<uint32_t>(result.ring_.size());
+                result.ring_.push_back(frozen);
+            }
+        }
+        result.ring_offsets_.push_back(static_cast<uint32_t>(result.ring_.size()));
+    }
+
+    return result;
+}
+
+}   // namespace ds
+}   // namespace mtlib
+
+#endif // _MTLIB_DS_FROZEN_DCEL_H_
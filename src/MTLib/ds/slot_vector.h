@@ -0,0 +1,176 @@
+#ifndef _MTLIB_DS_SLOT_VECTOR_H_
+#define _MTLIB_DS_SLOT_VECTOR_H_
+
+#include <cassert>
+#include <cstddef>  // size_t, ptrdiff_t
+#include <cstdint>  // uint32_t
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace mtlib {
+namespace ds {
+
+/**
+ * Elements stored contiguously and addressed by 32-bit indices that stay valid until the element is erased.
+ *
+ * Erasing an element leaves its slot empty and puts it on a free-list, the next insert reuses it, so no other element
+ * moves.  Iteration visits the live elements in index order and skips the empty slots.
+ */
+template <typename T>
+class slot_vector {
+    template <bool Const>
+    class basic_iterator;
+
+public:
+    using value_type = T;
+    using index_type = std::uint32_t;
+    using size_type = std::size_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr index_type null_index = ~index_type(0);
+
+    size_type size() const { return slots_.size() - free_.size(); }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Number of slots, live or free, every live index is below it.
+     */
+    size_type slots() const { return slots_.size(); }
+
+    void reserve(size_type n) {
+        slots_.reserve(n);
+        live_.reserve(n);
+    }
+
+    void clear() {
+        slots_.clear();
+        live_.clear();
+        free_.clear();
+    }
+
+    index_type insert(const T& value = T()) {
+        if (!free_.empty()) {
+            const auto index = free_.back();
+            free_.pop_back();
+            slots_[index] = value;
+            live_[index] = true;
+            return index;
+        }
+
+        assert(slots_.size() < null_index);
+        slots_.push_back(value);
+        live_.push_back(true);
+        return static_cast<index_type>(slots_.size() - 1);
+    }
+
+    void erase(index_type index) {
+        assert(contains(index));
+        live_[index] = false;
+        free_.push_back(index);
+    }
+
+    bool contains(index_type index) const {
+        return index < slots_.size() && live_[index];
+    }
+
+    T& operator[](index_type index) { return slots_[index]; }
+    const T& operator[](index_type index) const { return slots_[index]; }
+
+    /**
+     * Index of an element of this slot_vector.
+     */
+    index_type index_of(const T& value) const {
+        return static_cast<index_type>(&value - slots_.data());
+    }
+
+    iterator begin() { return iterator(this, first_live(0)); }
+    iterator end() { return iterator(this, slots_.size()); }
+    const_iterator begin() const { return const_iterator(this, first_live(0)); }
+    const_iterator end() const { return const_iterator(this, slots_.size()); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+private:
+    size_type first_live(size_type index) const {
+        while (index < slots_.size() && !live_[index])
+            ++index;
+        return index;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+        using owner_type = std::conditional_t<Const, const slot_vector, slot_vector>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() = default;
+
+        basic_iterator(owner_type* owner, size_type index)
+            : owner_(owner), index_(index)
+        { }
+
+        // iterator converts to const_iterator
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& other)
+            : owner_(other.owner_), index_(other.index_)
+        { }
+
+        basic_iterator& operator++() {
+            index_ = owner_->first_live(index_ + 1);
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        basic_iterator& operator--() {
+            do {
+                --index_;
+            } while (!owner_->live_[index_]);
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            auto result = *this;
+            --*this;
+            return result;
+        }
+
+        reference operator*() const { return owner_->slots_[index_]; }
+        pointer operator->() const { return &owner_->slots_[index_]; }
+
+        index_type index() const { return static_cast<index_type>(index_); }
+
+        bool operator==(const basic_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const basic_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        template <bool> friend class basic_iterator;
+
+        owner_type* owner_ = nullptr;
+        size_type index_ = 0;
+    };
+
+    std::vector<T> slots_;
+    std::vector<bool> live_;
+    std::vector<index_type> free_;
+};
+
+}   // namespace ds
+}   // namespace mtlib
+
+#endif // _MTLIB_DS_SLOT_VECTOR_H_
@@ -0,0 +1,97 @@
+#ifndef _MTLIB_GEOMETRY_AABB_H_
+#define _MTLIB_GEOMETRY_AABB_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <iostream>
+#include <iterator>
+
+namespace mtlib {
+
+/**
+ * Axis-aligned bounding box, the closed set of points between lower and upper on every dimension.
+ */
+template <std::size_t N, typename Scalar>
+struct aabb {
+    static constexpr std::size_t rank = N;
+    using vec_type = vec<N, Scalar>;
+    using scalar_type = Scalar;
+
+    vec_type lower;
+    vec_type upper;
+
+    constexpr bool operator==(const aabb<N, Scalar>& rhs) const { return lower == rhs.lower && upper == rhs.upper; }
+    constexpr bool operator!=(const aabb<N, Scalar>& rhs) const { return !(*this == rhs); }
+};
+
+// common aliases
+template <typename Scalar>
+using aabb2 = aabb<2, Scalar>;
+using aabb2f = aabb2<float>;
+using aabb2d = aabb2<double>;
+using aabb2l = aabb2<long double>;
+
+template <typename Scalar>
+using aabb3 = aabb<3, Scalar>;
+using aabb3f = aabb3<float>;
+using aabb3d = aabb3<double>;
+using aabb3l = aabb3<long double>;
+
+template <std::size_t N, typename Scalar>
+constexpr aabb<N, Scalar> bounding_box(const segment<N, Scalar>& seg) {
+    aabb<N, Scalar> result;
+    for (std::size_t dim = 0; dim < N; ++dim) {
+        result.lower[dim] = min_on_dim(seg, dim);
+        result.upper[dim] = max_on_dim(seg, dim);
+    }
+    return result;
+}
+
+template <std::size_t N, typename Scalar>
+constexpr const aabb<N, Scalar>& bounding_box(const aabb<N, Scalar>& box) {
+    return box;
+}
+
+/**
+ * The bounding box of the points in [first, last), e.g. the vertices of a polygon.  The range must not be empty.
+ */
+template<
+        typename ForwardIt,
+        typename Vec = typename std::iterator_traits<ForwardIt>::value_type
+>
+constexpr aabb<Vec::rank, typename Vec::scalar_type> bounding_box(ForwardIt first, ForwardIt last) {
+    assert(first != last);
+    aabb<Vec::rank, typename Vec::scalar_type> result {*first, *first};
+    for (++first; first != last; ++first) {
+        for (std::size_t dim = 0; dim < Vec::rank; ++dim) {
+            result.lower[dim] = std::min(result.lower[dim], (*first)[dim]);
+            result.upper[dim] = std::max(result.upper[dim], (*first)[dim]);
+        }
+    }
+    return result;
+}
+
+/**
+ * True if the boxes share at least one point, touching boxes overlap.
+ */
+template <std::size_t N, typename Scalar>
+constexpr bool overlap_aabb_aabb(const aabb<N, Scalar>& lhs, const aabb<N, Scalar>& rhs) {
+    for (std::size_t dim = 0; dim < N; ++dim) {
+        if (lhs.upper[dim] < rhs.lower[dim] || rhs.upper[dim] < lhs.lower[dim])
+            return false;
+    }
+    return true;
+}
+
+template <std::size_t N, typename Scalar>
+constexpr std::ostream& operator<<(std::ostream &out, const aabb<N, Scalar>& box) {
+    return out << "{ " << box.lower << ", " << box.upper << " }";
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_GEOMETRY_AABB_H_
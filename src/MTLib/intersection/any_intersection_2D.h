@@ -0,0 +1,136 @@
+#ifndef _MTLIB_ANY_INTERSECTION_2D_H_
+#define _MTLIB_ANY_INTERSECTION_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * Shamos-Hoey sweep that stops at the first pair of segments for which intersects(i, j) is true.
+ *
+ * segments must have their lexicographically smaller endpoint first.  intersects(i, j) is only asked about pairs that
+ * are neighbours on the sweep line or share an endpoint, and must be false for pairs that do not touch.  As long as it
+ * finds no intersection the sweep line order never changes between events, so no crossing events are scheduled.
+ *
+ * A zero-length segment has no end event: it is inserted at its point, compared with its neighbours and removed again.
+ */
+template <typename Scalar, typename Intersects>
+bool any_intersection_sweep_2D(const std::vector<segment2<Scalar>>& segments, Intersects&& intersects) {
+    assert(segments.size() <= std::numeric_limits<segment_index>::max());
+    const auto n_segments = static_cast<segment_index>(segments.size());
+
+    struct event_type {
+        vec2<Scalar> point;
+        segment_index segment;
+        bool end;
+
+        bool operator<(const event_type& rhs) const {
+            return point < rhs.point;
+        }
+    };
+
+    std::vector<event_type> events;
+    events.reserve(2 * n_segments);
+    for (segment_index i = 0; i < n_segments; ++i) {
+        events.push_back({segments[i][0], i, false});
+        if (segments[i][0] != segments[i][1])
+            events.push_back({segments[i][1], i, true});
+    }
+    std::sort(events.begin(), events.end());
+
+    // no segment is ever part of an event, the sweep line order only depends on the sweep point
+    const std::vector<bool> in_event(n_segments, false);
+    sweep_line_state_2D<Scalar> state;
+    state.segments = &segments;
+    state.in_event = &in_event;
+
+    using sweep_line_type = std::set<segment_index, segment_comparer<Scalar>>;
+    sweep_line_type sweep_line {segment_comparer<Scalar>(&state)};
+    std::vector<typename sweep_line_type::iterator> handles(n_segments, sweep_line.end());
+    std::vector<segment_index> at_point;
+
+    for (auto first = events.begin(); first != events.end();) {
+        const auto point = first->point;
+        const auto last = std::find_if(first, events.end(), [&](const event_type& e) { return e.point != point; });
+        state.point = point;
+
+        // the segments that end here leave first, their neighbours become adjacent
+        for (auto it = first; it != last; ++it) {
+            if (!it->end)
+                continue;
+
+            auto handle = handles[it->segment];
+            auto above = sweep_line.erase(handle);
+            if (above != sweep_line.begin() && above != sweep_line.end() && intersects(*std::prev(above), *above))
+                return true;
+        }
+
+        // the segments that end here have left, so pairs meeting at an endpoint are compared directly
+        at_point.clear();
+        for (auto it = first; it != last; ++it)
+            at_point.push_back(it->segment);
+        for (std::size_t i = 0; i < at_point.size(); ++i) {
+            for (std::size_t j = i + 1; j < at_point.size(); ++j) {
+                if (intersects(at_point[i], at_point[j]))
+                    return true;
+            }
+        }
+
+        for (auto it = first; it != last; ++it) {
+            if (it->end)
+                continue;
+
+            auto handle = sweep_line.insert(it->segment).first;
+            handles[it->segment] = handle;
+            if (handle != sweep_line.begin() && intersects(*std::prev(handle), *handle))
+                return true;
+            if (std::next(handle) != sweep_line.end() && intersects(*handle, *std::next(handle)))
+                return true;
+
+            // its neighbours were adjacent before it came
+            if (segments[it->segment][0] == segments[it->segment][1])
+                sweep_line.erase(handle);
+        }
+
+        first = last;
+    }
+
+    return false;
+}
+
+}   // namespace intersection
+
+/**
+ * True if any two segments in [first, last) touch, including at shared endpoints.
+ *
+ * O(n log n), stops at the first intersection found.
+ */
+template<
+        typename ForwardIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+bool any_intersection_2D(const ForwardIt &first, const ForwardIt &last) {
+    std::vector<segment2<Scalar>> segments;
+    for (auto it = first; it != last; ++it)
+        segments.emplace_back(min_endpoint(*it), max_endpoint(*it));
+
+    using intersection::segment_index;
+    return intersection::any_intersection_sweep_2D(segments, [&](segment_index lhs, segment_index rhs) {
+        return overlap_segment_segment_2D(segments[lhs], segments[rhs]);
+    });
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_ANY_INTERSECTION_2D_H_
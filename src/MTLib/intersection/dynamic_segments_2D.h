@@ -0,0 +1,290 @@
+#ifndef _MTLIB_DYNAMIC_SEGMENTS_2D_H_
+#define _MTLIB_DYNAMIC_SEGMENTS_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * A set of segments that keeps the intersecting pairs among them up to date as segments are inserted and erased.
+ *
+ * The segments are bucketed into an unbounded uniform grid kept in a hash map, so an edit only tests the segments
+ * sharing a cell with the edited one and costs time proportional to its neighbourhood, not to the size of the set.
+ * Each segment keeps the list of segments it touches together with a point they share, the intersection point of
+ * intersect_segment_segment_2D clamped to both bounding boxes.
+ *
+ * Segments are addressed by the segment_index returned from insert, the indices of erased segments are reused.  The
+ * cell size should be about the typical segment length, assign() picks the mean length of its input.
+ */
+template <typename Scalar>
+class dynamic_segments_2D {
+public:
+    using scalar_type = Scalar;
+    using segment_type = segment2<Scalar>;
+    using point_type = vec2<Scalar>;
+
+    struct hit_type {
+        segment_index other;
+        point_type point;
+    };
+
+    explicit dynamic_segments_2D(Scalar cell_size = (Scalar)1)
+        : cell_size_(cell_size)
+    {
+        assert(cell_size > (Scalar)0);
+    }
+
+    /**
+     * Replaces the set with the segments in [first, last), which get the indices 0, 1, ... in order, and sets the cell
+     * size to their mean length.  If every segment is a point the cell size is the larger side of their bounding box
+     * over the square root of their number, or 1 if the points coincide.
+     */
+    template <typename ForwardIt>
+    void assign(const ForwardIt& first, const ForwardIt& last) {
+        clear();
+
+        Scalar total_length = 0;
+        std::size_t n = 0;
+        point_type lo(std::numeric_limits<Scalar>::max(), std::numeric_limits<Scalar>::max());
+        point_type hi(std::numeric_limits<Scalar>::lowest(), std::numeric_limits<Scalar>::lowest());
+        for (auto it = first; it != last; ++it, ++n) {
+            const auto& seg = *it;
+            total_length += length(seg[1] - seg[0]);
+            for (std::size_t dim = 0; dim < 2; ++dim) {
+                lo[dim] = std::min(lo[dim], min_on_dim(seg, dim));
+                hi[dim] = std::max(hi[dim], max_on_dim(seg, dim));
+            }
+        }
+        if (n > 0) {
+            const auto n_real = static_cast<Scalar>(n);
+            cell_size_ = total_length / n_real;
+            // a cell size of zero would send every coordinate to an infinite cell
+            if (!(cell_size_ > (Scalar)0))
+                cell_size_ = std::max(hi[0] - lo[0], hi[1] - lo[1]) / std::sqrt(n_real);
+            if (!(cell_size_ > (Scalar)0))
+                cell_size_ = (Scalar)1;
+        }
+
+        segments_.reserve(n);
+        hits_.reserve(n);
+        for (auto it = first; it != last; ++it)
+            insert(*it);
+    }
+
+    void clear() {
+        segments_.clear();
+        hits_.clear();
+        live_.clear();
+        free_.clear();
+        cells_.clear();
+        visited_.clear();
+        n_live_ = 0;
+        n_intersections_ = 0;
+    }
+
+    /**
+     * Adds seg and the pairs it forms with the segments it touches, returns its index.
+     */
+    segment_index insert(const segment_type& seg) {
+        segment_index i;
+        if (!free_.empty()) {
+            i = free_.back();
+            free_.pop_back();
+            segments_[i] = segment_type(min_endpoint(seg), max_endpoint(seg));
+            live_[i] = true;
+        }
+        else {
+            assert(segments_.size() < std::numeric_limits<segment_index>::max());
+            i = static_cast<segment_index>(segments_.size());
+            segments_.emplace_back(min_endpoint(seg), max_endpoint(seg));
+            hits_.emplace_back();
+            live_.push_back(true);
+            visited_.push_back(0);
+        }
+        ++n_live_;
+
+        // the neighbours are tested before i joins its cells, so i never meets itself
+        if (++epoch_ == 0) {
+            std::fill(visited_.begin(), visited_.end(), 0);
+            epoch_ = 1;
+        }
+        visited_[i] = epoch_;
+        cover(segments_[i], [&](std::uint64_t key) {
+            auto& cell = cells_[key];
+            for (auto j : cell) {
+                if (visited_[j] == epoch_)
+                    continue;
+                visited_[j] = epoch_;
+                test_pair(i, j);
+            }
+            cell.push_back(i);
+        });
+
+        return i;
+    }
+
+    /**
+     * Removes segment i and every pair it is part of.
+     */
+    void erase(segment_index i) {
+        assert(contains(i));
+
+        for (const auto& hit : hits_[i]) {
+            auto& other = hits_[hit.other];
+            other.erase(std::find_if(other.begin(), other.end(), [&](const hit_type& h) { return h.other == i; }));
+        }
+        n_intersections_ -= hits_[i].size();
+        hits_[i].clear();
+
+        cover(segments_[i], [&](std::uint64_t key) {
+            auto cell = cells_.find(key);
+            if (cell == cells_.end())
+                return;
+            auto& members = cell->second;
+            auto it = std::find(members.begin(), members.end(), i);
+            if (it == members.end())
+                return;
+            *it = members.back();
+            members.pop_back();
+            if (members.empty())
+                cells_.erase(cell);
+        });
+
+        live_[i] = false;
+        free_.push_back(i);
+        --n_live_;
+    }
+
+    bool contains(segment_index i) const {
+        return i < live_.size() && live_[i];
+    }
+
+    /**
+     * Segment i with its lexicographically smaller endpoint first.
+     */
+    const segment_type& segment(segment_index i) const {
+        assert(contains(i));
+        return segments_[i];
+    }
+
+    /**
+     * The segments that touch segment i.
+     */
+    const std::vector<hit_type>& hits(segment_index i) const {
+        assert(contains(i));
+        return hits_[i];
+    }
+
+    /**
+     * Calls visit(i, j, point) once for every pair of touching segments, with i < j.
+     */
+    template <typename Visitor>
+    void visit(Visitor&& visit) const {
+        for (segment_index i = 0; i < hits_.size(); ++i) {
+            for (const auto& hit : hits_[i]) {
+                if (i < hit.other)
+                    visit(i, hit.other, hit.point);
+            }
+        }
+    }
+
+    std::size_t size() const { return n_live_; }
+    std::size_t n_intersections() const { return n_intersections_; }
+    Scalar cell_size() const { return cell_size_; }
+
+private:
+    // column and row are truncated to 32 bits each, cells that collide only add candidates
+    std::uint64_t key_of(std::int64_t col, std::int64_t row) const {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(col)) << 32) |
+            static_cast<std::uint32_t>(row);
+    }
+
+    std::int64_t cell_of(Scalar x) const {
+        return static_cast<std::int64_t>(std::floor(x / cell_size_));
+    }
+
+    // calls f with the key of every cell within a small margin of seg, column by column
+    template <typename F>
+    void cover(const segment_type& seg, F&& f) const {
+        const auto margin = cell_size_ * (Scalar)1e-6;
+
+        const auto first_col = cell_of(seg[0][0] - margin);
+        const auto last_col = cell_of(seg[1][0] + margin);
+        for (auto col = first_col; col <= last_col; ++col) {
+            const auto x_lo = std::max(seg[0][0], static_cast<Scalar>(col) * cell_size_);
+            const auto x_hi = std::min(seg[1][0], static_cast<Scalar>(col + 1) * cell_size_);
+
+            auto y_lo = min_on_dim(seg, 1);
+            auto y_hi = max_on_dim(seg, 1);
+            if (seg[0][0] != seg[1][0] && x_lo <= x_hi) {
+                const auto y1 = evaluate_at_x_2D(seg, x_lo);
+                const auto y2 = evaluate_at_x_2D(seg, x_hi);
+                y_lo = std::max(y_lo, std::min(y1, y2));
+                y_hi = std::min(y_hi, std::max(y1, y2));
+            }
+
+            const auto first_row = cell_of(y_lo - margin);
+            const auto last_row = cell_of(y_hi + margin);
+            for (auto row = first_row; row <= last_row; ++row)
+                f(key_of(col, row));
+        }
+    }
+
+    void test_pair(segment_index lhs, segment_index rhs) {
+        // the smaller index first, so a pair gets the same point whichever of the two was inserted last
+        if (rhs < lhs)
+            std::swap(lhs, rhs);
+
+        const auto& seg_lhs = segments_[lhs];
+        const auto& seg_rhs = segments_[rhs];
+        auto[result, success] = intersect_segment_segment_2D(seg_lhs, seg_rhs);
+        if (!success)
+            return;
+
+        for (std::size_t dim = 0; dim < 2; ++dim) {
+            result.point[dim] = std::clamp(
+                result.point[dim],
+                std::max(min_on_dim(seg_lhs, dim), min_on_dim(seg_rhs, dim)),
+                std::min(max_on_dim(seg_lhs, dim), max_on_dim(seg_rhs, dim))
+            );
+        }
+        hits_[lhs].push_back({rhs, result.point});
+        hits_[rhs].push_back({lhs, result.point});
+        ++n_intersections_;
+    }
+
+    Scalar cell_size_;
+
+    std::vector<segment_type> segments_;
+    std::vector<std::vector<hit_type>> hits_;
+    std::vector<bool> live_;
+    std::vector<segment_index> free_;
+    std::unordered_map<std::uint64_t, std::vector<segment_index>> cells_;
+
+    // visited_[j] == epoch_ once segment j was tested in the current insert
+    std::vector<std::uint32_t> visited_;
+    std::uint32_t epoch_ = 0;
+
+    std::size_t n_live_ = 0;
+    std::size_t n_intersections_ = 0;
+};
+
+}   // namespace intersection
+}   // namespace mtlib
+
+#endif // _MTLIB_DYNAMIC_SEGMENTS_2D_H_
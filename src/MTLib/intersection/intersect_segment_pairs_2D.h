@@ -0,0 +1,386 @@
+#ifndef _MTLIB_INTERSECT_SEGMENT_PAIRS_2D_H_
+#define _MTLIB_INTERSECT_SEGMENT_PAIRS_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
+#include "MTLib/util/span.h"
+
+#include <cassert>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, int32_t
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * Segment endpoints as structure of arrays, segment i runs from (x0[i], y0[i]) to (x1[i], y1[i]).
+ */
+template <typename Scalar>
+struct segments_soa_2D {
+    std::vector<Scalar> x0;
+    std::vector<Scalar> y0;
+    std::vector<Scalar> x1;
+    std::vector<Scalar> y1;
+
+    segments_soa_2D() = default;
+
+    template <typename ForwardIt>
+    segments_soa_2D(const ForwardIt& first, const ForwardIt& last) {
+        for (auto it = first; it != last; ++it)
+            push_back(*it);
+    }
+
+    void push_back(const segment2<Scalar>& seg) {
+        x0.push_back(seg[0][0]);
+        y0.push_back(seg[0][1]);
+        x1.push_back(seg[1][0]);
+        y1.push_back(seg[1][1]);
+    }
+
+    segment2<Scalar> operator[](std::size_t idx) const {
+        return segment2<Scalar>(vec2<Scalar>(x0[idx], y0[idx]), vec2<Scalar>(x1[idx], y1[idx]));
+    }
+
+    std::size_t size() const {
+        return x0.size();
+    }
+};
+
+/**
+ * A pair that intersects, by its position in the pair lists, with the parameters of the intersection point along the
+ * first and the second segment as intersect_segment_segment_2D reports them.
+ */
+template <typename Scalar>
+struct pair_hit_2D {
+    std::uint32_t pair;
+    Scalar t1;
+    Scalar t2;
+};
+
+/**
+ * The instruction set intersect_segment_pairs_2D was compiled for.
+ */
+constexpr const char* intersect_segment_pairs_isa() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+template <typename Scalar>
+void intersect_segment_pair_2D(
+    const segments_soa_2D<Scalar>& segments, std::uint32_t first, std::uint32_t second, std::uint32_t pair,
+    std::vector<pair_hit_2D<Scalar>>& hits
+) {
+    const auto[result, success] = intersect_segment_segment_2D(segments[first], segments[second]);
+    if (success)
+        hits.push_back({pair, result.t1, result.t2});
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+/**
+ * Keeps the lanes of a block of pairs whose orientations show a proper crossing, and passes the lanes that touch or
+ * may be colinear to intersect_segment_segment_2D.
+ */
+template <typename Scalar, std::size_t Lanes>
+void collect_block_hits_2D(
+    const segments_soa_2D<Scalar>& segments, const std::uint32_t* first, const std::uint32_t* second,
+    std::uint32_t pair, int crossing, int touching, const Scalar* t1, const Scalar* t2,
+    std::vector<pair_hit_2D<Scalar>>& hits
+) {
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        const auto lane_pair = pair + static_cast<std::uint32_t>(lane);
+        if (crossing & (1 << lane))
+            hits.push_back({lane_pair, t1[lane], t2[lane]});
+        else if (touching & (1 << lane))
+            intersect_segment_pair_2D(segments, first[lane], second[lane], lane_pair, hits);
+    }
+}
+#endif
+
+#if defined(__AVX2__)
+/**
+ * True if every index into segments fits the signed 32 bit lanes the AVX2 gathers take.
+ */
+template <typename Scalar>
+bool fits_gather_indices_2D(const segments_soa_2D<Scalar>& segments) {
+    return segments.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()) + 1;
+}
+
+inline std::size_t intersect_segment_pairs_simd_2D(
+    const segments_soa_2D<double>& s, const std::uint32_t* first, const std::uint32_t* second, std::size_t n_pairs,
+    std::vector<pair_hit_2D<double>>& hits
+) {
+    assert(fits_gather_indices_2D(s));
+    const auto zero = _mm256_setzero_pd();
+    // every lane masked in, with a zero source: GCC warns that the plain gather may read its source uninitialized
+    const auto all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    auto gather = [&](const std::vector<double>& v, __m128i idx) {
+        return _mm256_mask_i32gather_pd(zero, v.data(), idx, all_lanes, 8);
+    };
+    alignas(32) double t1[4];
+    alignas(32) double t2[4];
+
+    std::size_t k = 0;
+    for (; k + 4 <= n_pairs; k += 4) {
+        const auto i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + k));
+        const auto j = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + k));
+        const auto ax0 = gather(s.x0, i);
+        const auto ay0 = gather(s.y0, i);
+        const auto ax1 = gather(s.x1, i);
+        const auto ay1 = gather(s.y1, i);
+        const auto bx0 = gather(s.x0, j);
+        const auto by0 = gather(s.y0, j);
+        const auto bx1 = gather(s.x1, j);
+        const auto by1 = gather(s.y1, j);
+
+        // the four signed_area_2D orientations of intersect_segment_segment_2D
+        const auto bdx = _mm256_sub_pd(bx1, bx0);
+        const auto bdy = _mm256_sub_pd(by1, by0);
+        const auto o1 = _mm256_sub_pd(
+            _mm256_mul_pd(bdx, _mm256_sub_pd(ay0, by0)), _mm256_mul_pd(bdy, _mm256_sub_pd(ax0, bx0)));
+        const auto o2 = _mm256_sub_pd(
+            _mm256_mul_pd(bdx, _mm256_sub_pd(ay1, by0)), _mm256_mul_pd(bdy, _mm256_sub_pd(ax1, bx0)));
+        const auto o12 = _mm256_mul_pd(o1, o2);
+        // most candidates have both endpoints of the first segment on one side of the second
+        if (_mm256_movemask_pd(_mm256_cmp_pd(o12, zero, _CMP_LE_OQ)) == 0)
+            continue;
+
+        const auto adx = _mm256_sub_pd(ax1, ax0);
+        const auto ady = _mm256_sub_pd(ay1, ay0);
+        const auto o3 = _mm256_sub_pd(
+            _mm256_mul_pd(adx, _mm256_sub_pd(by0, ay0)), _mm256_mul_pd(ady, _mm256_sub_pd(bx0, ax0)));
+        const auto o4 = _mm256_sub_pd(
+            _mm256_mul_pd(adx, _mm256_sub_pd(by1, ay0)), _mm256_mul_pd(ady, _mm256_sub_pd(bx1, ax0)));
+
+        const auto o34 = _mm256_mul_pd(o3, o4);
+        const int maybe = _mm256_movemask_pd(_mm256_and_pd(
+            _mm256_cmp_pd(o12, zero, _CMP_LE_OQ), _mm256_cmp_pd(o34, zero, _CMP_LE_OQ)));
+        if (maybe == 0)
+            continue;
+
+        const int crossing = _mm256_movemask_pd(_mm256_and_pd(
+            _mm256_cmp_pd(o12, zero, _CMP_LT_OQ), _mm256_cmp_pd(o34, zero, _CMP_LT_OQ)));
+        _mm256_store_pd(t1, _mm256_div_pd(o1, _mm256_sub_pd(o1, o2)));
+        _mm256_store_pd(t2, _mm256_div_pd(o3, _mm256_sub_pd(o3, o4)));
+        collect_block_hits_2D<double, 4>(
+            s, first + k, second + k, static_cast<std::uint32_t>(k), crossing, maybe & ~crossing, t1, t2, hits);
+    }
+
+    return k;
+}
+
+inline std::size_t intersect_segment_pairs_simd_2D(
+    const segments_soa_2D<float>& s, const std::uint32_t* first, const std::uint32_t* second, std::size_t n_pairs,
+    std::vector<pair_hit_2D<float>>& hits
+) {
+    assert(fits_gather_indices_2D(s));
+    const auto zero = _mm256_setzero_ps();
+    // every lane masked in, with a zero source: GCC warns that the plain gather may read its source uninitialized
+    const auto all_lanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    auto gather = [&](const std::vector<float>& v, __m256i idx) {
+        return _mm256_mask_i32gather_ps(zero, v.data(), idx, all_lanes, 4);
+    };
+    alignas(32) float t1[8];
+    alignas(32) float t2[8];
+
+    std::size_t k = 0;
+    for (; k + 8 <= n_pairs; k += 8) {
+        const auto i = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + k));
+        const auto j = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + k));
+        const auto ax0 = gather(s.x0, i);
+        const auto ay0 = gather(s.y0, i);
+        const auto ax1 = gather(s.x1, i);
+        const auto ay1 = gather(s.y1, i);
+        const auto bx0 = gather(s.x0, j);
+        const auto by0 = gather(s.y0, j);
+        const auto bx1 = gather(s.x1, j);
+        const auto by1 = gather(s.y1, j);
+
+        const auto bdx = _mm256_sub_ps(bx1, bx0);
+        const auto bdy = _mm256_sub_ps(by1, by0);
+        const auto o1 = _mm256_sub_ps(
+            _mm256_mul_ps(bdx, _mm256_sub_ps(ay0, by0)), _mm256_mul_ps(bdy, _mm256_sub_ps(ax0, bx0)));
+        const auto o2 = _mm256_sub_ps(
+            _mm256_mul_ps(bdx, _mm256_sub_ps(ay1, by0)), _mm256_mul_ps(bdy, _mm256_sub_ps(ax1, bx0)));
+        const auto o12 = _mm256_mul_ps(o1, o2);
+        if (_mm256_movemask_ps(_mm256_cmp_ps(o12, zero, _CMP_LE_OQ)) == 0)
+            continue;
+
+        const auto adx = _mm256_sub_ps(ax1, ax0);
+        const auto ady = _mm256_sub_ps(ay1, ay0);
+        const auto o3 = _mm256_sub_ps(
+            _mm256_mul_ps(adx, _mm256_sub_ps(by0, ay0)), _mm256_mul_ps(ady, _mm256_sub_ps(bx0, ax0)));
+        const auto o4 = _mm256_sub_ps(
+            _mm256_mul_ps(adx, _mm256_sub_ps(by1, ay0)), _mm256_mul_ps(ady, _mm256_sub_ps(bx1, ax0)));
+
+        const auto o34 = _mm256_mul_ps(o3, o4);
+        const int maybe = _mm256_movemask_ps(_mm256_and_ps(
+            _mm256_cmp_ps(o12, zero, _CMP_LE_OQ), _mm256_cmp_ps(o34, zero, _CMP_LE_OQ)));
+        if (maybe == 0)
+            continue;
+
+        const int crossing = _mm256_movemask_ps(_mm256_and_ps(
+            _mm256_cmp_ps(o12, zero, _CMP_LT_OQ), _mm256_cmp_ps(o34, zero, _CMP_LT_OQ)));
+        _mm256_store_ps(t1, _mm256_div_ps(o1, _mm256_sub_ps(o1, o2)));
+        _mm256_store_ps(t2, _mm256_div_ps(o3, _mm256_sub_ps(o3, o4)));
+        collect_block_hits_2D<float, 8>(
+            s, first + k, second + k, static_cast<std::uint32_t>(k), crossing, maybe & ~crossing, t1, t2, hits);
+    }
+
+    return k;
+}
+#elif defined(__SSE2__)
+inline std::size_t intersect_segment_pairs_simd_2D(
+    const segments_soa_2D<double>& s, const std::uint32_t* first, const std::uint32_t* second, std::size_t n_pairs,
+    std::vector<pair_hit_2D<double>>& hits
+) {
+    const auto zero = _mm_setzero_pd();
+    alignas(16) double t1[2];
+    alignas(16) double t2[2];
+
+    std::size_t k = 0;
+    for (; k + 2 <= n_pairs; k += 2) {
+        const auto i0 = first[k];
+        const auto i1 = first[k + 1];
+        const auto j0 = second[k];
+        const auto j1 = second[k + 1];
+        const auto ax0 = _mm_set_pd(s.x0[i1], s.x0[i0]);
+        const auto ay0 = _mm_set_pd(s.y0[i1], s.y0[i0]);
+        const auto ax1 = _mm_set_pd(s.x1[i1], s.x1[i0]);
+        const auto ay1 = _mm_set_pd(s.y1[i1], s.y1[i0]);
+        const auto bx0 = _mm_set_pd(s.x0[j1], s.x0[j0]);
+        const auto by0 = _mm_set_pd(s.y0[j1], s.y0[j0]);
+        const auto bx1 = _mm_set_pd(s.x1[j1], s.x1[j0]);
+        const auto by1 = _mm_set_pd(s.y1[j1], s.y1[j0]);
+
+        const auto bdx = _mm_sub_pd(bx1, bx0);
+        const auto bdy = _mm_sub_pd(by1, by0);
+        const auto o1 = _mm_sub_pd(_mm_mul_pd(bdx, _mm_sub_pd(ay0, by0)), _mm_mul_pd(bdy, _mm_sub_pd(ax0, bx0)));
+        const auto o2 = _mm_sub_pd(_mm_mul_pd(bdx, _mm_sub_pd(ay1, by0)), _mm_mul_pd(bdy, _mm_sub_pd(ax1, bx0)));
+        const auto o12 = _mm_mul_pd(o1, o2);
+        if (_mm_movemask_pd(_mm_cmple_pd(o12, zero)) == 0)
+            continue;
+
+        const auto adx = _mm_sub_pd(ax1, ax0);
+        const auto ady = _mm_sub_pd(ay1, ay0);
+        const auto o3 = _mm_sub_pd(_mm_mul_pd(adx, _mm_sub_pd(by0, ay0)), _mm_mul_pd(ady, _mm_sub_pd(bx0, ax0)));
+        const auto o4 = _mm_sub_pd(_mm_mul_pd(adx, _mm_sub_pd(by1, ay0)), _mm_mul_pd(ady, _mm_sub_pd(bx1, ax0)));
+
+        const auto o34 = _mm_mul_pd(o3, o4);
+        const int maybe = _mm_movemask_pd(_mm_and_pd(_mm_cmple_pd(o12, zero), _mm_cmple_pd(o34, zero)));
+        if (maybe == 0)
+            continue;
+
+        const int crossing = _mm_movemask_pd(_mm_and_pd(_mm_cmplt_pd(o12, zero), _mm_cmplt_pd(o34, zero)));
+        _mm_store_pd(t1, _mm_div_pd(o1, _mm_sub_pd(o1, o2)));
+        _mm_store_pd(t2, _mm_div_pd(o3, _mm_sub_pd(o3, o4)));
+        collect_block_hits_2D<double, 2>(
+            s, first + k, second + k, static_cast<std::uint32_t>(k), crossing, maybe & ~crossing, t1, t2, hits);
+    }
+
+    return k;
+}
+
+inline std::size_t intersect_segment_pairs_simd_2D(
+    const segments_soa_2D<float>& s, const std::uint32_t* first, const std::uint32_t* second, std::size_t n_pairs,
+    std::vector<pair_hit_2D<float>>& hits
+) {
+    const auto zero = _mm_setzero_ps();
+    alignas(16) float t1[4];
+    alignas(16) float t2[4];
+
+    auto gather = [&](const std::vector<float>& v, const std::uint32_t* idx) {
+        return _mm_set_ps(v[idx[3]], v[idx[2]], v[idx[1]], v[idx[0]]);
+    };
+
+    std::size_t k = 0;
+    for (; k + 4 <= n_pairs; k += 4) {
+        const auto ax0 = gather(s.x0, first + k);
+        const auto ay0 = gather(s.y0, first + k);
+        const auto ax1 = gather(s.x1, first + k);
+        const auto ay1 = gather(s.y1, first + k);
+        const auto bx0 = gather(s.x0, second + k);
+        const auto by0 = gather(s.y0, second + k);
+        const auto bx1 = gather(s.x1, second + k);
+        const auto by1 = gather(s.y1, second + k);
+
+        const auto bdx = _mm_sub_ps(bx1, bx0);
+        const auto bdy = _mm_sub_ps(by1, by0);
+        const auto o1 = _mm_sub_ps(_mm_mul_ps(bdx, _mm_sub_ps(ay0, by0)), _mm_mul_ps(bdy, _mm_sub_ps(ax0, bx0)));
+        const auto o2 = _mm_sub_ps(_mm_mul_ps(bdx, _mm_sub_ps(ay1, by0)), _mm_mul_ps(bdy, _mm_sub_ps(ax1, bx0)));
+        const auto o12 = _mm_mul_ps(o1, o2);
+        if (_mm_movemask_ps(_mm_cmple_ps(o12, zero)) == 0)
+            continue;
+
+        const auto adx = _mm_sub_ps(ax1, ax0);
+        const auto ady = _mm_sub_ps(ay1, ay0);
+        const auto o3 = _mm_sub_ps(_mm_mul_ps(adx, _mm_sub_ps(by0, ay0)), _mm_mul_ps(ady, _mm_sub_ps(bx0, ax0)));
+        const auto o4 = _mm_sub_ps(_mm_mul_ps(adx, _mm_sub_ps(by1, ay0)), _mm_mul_ps(ady, _mm_sub_ps(bx1, ax0)));
+
+        const auto o34 = _mm_mul_ps(o3, o4);
+        const int maybe = _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(o12, zero), _mm_cmple_ps(o34, zero)));
+        if (maybe == 0)
+            continue;
+
+        const int crossing = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(o12, zero), _mm_cmplt_ps(o34, zero)));
+        _mm_store_ps(t1, _mm_div_ps(o1, _mm_sub_ps(o1, o2)));
+        _mm_store_ps(t2, _mm_div_ps(o3, _mm_sub_ps(o3, o4)));
+        collect_block_hits_2D<float, 4>(
+            s, first + k, second + k, static_cast<std::uint32_t>(k), crossing, maybe & ~crossing, t1, t2, hits);
+    }
+
+    return k;
+}
+#endif
+
+}   // namespace intersection
+
+/**
+ * Tests the pairs (segments[first[k]], segments[second[k]]) and appends a hit (k, t1, t2) to hits for every pair
+ * that intersects, in increasing order of k.  A pair intersects, and has the parameters, as reported by
+ * intersect_segment_segment_2D.
+ *
+ * The orientations of float and double pairs are evaluated in blocks of AVX2 or SSE2 lanes when the compiler targets
+ * them, see intersection::intersect_segment_pairs_isa().  Lanes whose orientations are not all non-zero are passed
+ * to intersect_segment_segment_2D, the rest of the pairs are tested one at a time.  The AVX2 gathers take signed 32
+ * bit indices, so more than 2^31 segments are tested one pair at a time.
+ */
+template <typename Scalar>
+void intersect_segment_pairs_2D(
+    const intersection::segments_soa_2D<Scalar>& segments,
+    span<const std::uint32_t> first, span<const std::uint32_t> second,
+    std::vector<intersection::pair_hit_2D<Scalar>>& hits
+) {
+    assert(first.size() == second.size());
+    const auto n_pairs = first.size();
+
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    if constexpr (std::is_same_v<Scalar, double> || std::is_same_v<Scalar, float>) {
+        if (intersection::fits_gather_indices_2D(segments))
+            k = intersection::intersect_segment_pairs_simd_2D(segments, first.data(), second.data(), n_pairs, hits);
+    }
+#elif defined(__SSE2__)
+    if constexpr (std::is_same_v<Scalar, double> || std::is_same_v<Scalar, float>)
+        k = intersection::intersect_segment_pairs_simd_2D(segments, first.data(), second.data(), n_pairs, hits);
+#endif
+
+    for (; k < n_pairs; ++k)
+        intersection::intersect_segment_pair_2D(segments, first[k], second[k], static_cast<std::uint32_t>(k), hits);
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_INTERSECT_SEGMENT_PAIRS_2D_H_
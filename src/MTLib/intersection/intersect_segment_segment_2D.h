@@ -1,31 +1,122 @@
 #ifndef _MTLIB_INTERSECT_SEGMENT_SEGMENT_2D_H_
 #define _MTLIB_INTERSECT_SEGMENT_SEGMENT_2D_H_
 
+#include "MTLib/algebra/linalg.h"
+#include "MTLib/algebra/predicates.h"
 #include "MTLib/algebra/vec.h"
 #include "MTLib/geometry/segment.h"
 #include "MTLib/intersection/result_segment_segment.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>  // uint64_t
+#include <type_traits>
 #include <utility>
 
 namespace mtlib {
 
-// FIXME: Should this be in separate header?
+/**
+ * a1 / (a1 - a2), the parameter at which a segment whose ends have the signed areas a1 and a2 with respect to another
+ * segment crosses it, clamped to [0, 1].
+ */
 template <typename Scalar>
-bool overlap_segment_segment_2D(const segment2<Scalar>& seg1, const segment2<Scalar>& seg2) {
-    auto o1 = signed_area_2D(seg2[0], seg2[1], seg1[0]);
-    auto o2 = signed_area_2D(seg2[0], seg2[1], seg1[1]);
-    auto o12 = o1 * o2;
+intersection::parameter_scalar_t<Scalar> crossing_parameter_2D(wide_scalar_t<Scalar> a1, wide_scalar_t<Scalar> a2) {
+    using Parameter = intersection::parameter_scalar_t<Scalar>;
+    const auto d = a1 - a2;
+    if (d == 0)
+        return (Parameter)0.5;
+    return std::clamp((Parameter)a1 / (Parameter)d, (Parameter)0, (Parameter)1);
+}
 
-    if (o12 <= (Scalar)0) {
-        auto o3 = signed_area_2D(seg1[0], seg1[1], seg2[0]);
-        auto o4 = signed_area_2D(seg1[0], seg1[1], seg2[1]);
-        // auto o4 = o1 + o2 - o3; // introduces rounding error
-        auto o34 = o3 * o4;
+/**
+ * The parameter of v, a point on seg, along seg.
+ */
+template <typename Scalar>
+intersection::parameter_scalar_t<Scalar> parameter_on_segment_2D(const segment2<Scalar>& seg, const vec2<Scalar>& v) {
+    using Parameter = intersection::parameter_scalar_t<Scalar>;
+    for (std::size_t i = 0; i < 2; ++i) {
+        if (seg[0][i] != seg[1][i])
+            return ((Parameter)v[i] - (Parameter)seg[0][i]) / ((Parameter)seg[1][i] - (Parameter)seg[0][i]);
+    }
+    return (Parameter)0;
+}
+
+/**
+ * round(d * num / den) for 0 <= num <= den and den > 0, halves rounded away from zero.  Exact for any d, num and den
+ * of a 32 or 64 bit integer kernel.
+ */
+template <typename Scalar>
+Scalar scaled_offset_2D(Scalar d, wide_scalar_t<Scalar> num, wide_scalar_t<Scalar> den) {
+    const bool negative = d < 0;
+    const std::uint64_t magnitude = negative ? -(std::uint64_t)d : (std::uint64_t)d;
+
+    const auto n = (uint128)num;
+    const auto m = (uint128)den;
+    uint128 q = 0;
+    uint128 r = 0;
+    if ((n >> 64) == 0) {
+        // |d| * num fits in 128 bits, always the case for 32 bit coordinates
+        const auto product = (uint128)magnitude * n;
+        q = product / m;
+        r = product % m;
+    }
+    else {
+        // long multiplication of num by the bits of |d|, keeping q * den + r == (bits so far) * num with r < den
+        for (int bit = magnitude == 0 ? -1 : 63 - __builtin_clzll(magnitude); bit >= 0; --bit) {
+            q <<= 1;
+            r <<= 1;
+            if (r >= m) {
+                r -= m;
+                ++q;
+            }
+            if ((magnitude >> bit) & 1) {
+                r += n;
+                if (r >= m) {
+                    r -= m;
+                    ++q;
+                }
+            }
+        }
+    }
+    if (r >= m - r)
+        ++q;
+    return negative ? -(Scalar)q : (Scalar)q;
+}
+
+/**
+ * The point where seg crosses the line of a segment with respect to which its ends have the signed areas a1 and a2,
+ * for integer coordinates rounded to the nearest integer point.  a1 and a2 may not both be zero.
+ */
+template <typename Scalar>
+vec2<Scalar> snapped_crossing_2D(const segment2<Scalar>& seg, wide_scalar_t<Scalar> a1, wide_scalar_t<Scalar> a2) {
+    if (a1 < 0) {
+        a1 = -a1;
+        a2 = -a2;
+    }
+    const auto den = a1 - a2;
+    return vec2<Scalar>(
+        seg[0][0] + scaled_offset_2D<Scalar>(seg[1][0] - seg[0][0], a1, den),
+        seg[0][1] + scaled_offset_2D<Scalar>(seg[1][1] - seg[0][1], a1, den)
+    );
+}
+
+// FIXME: Should this be in separate header?
+template <typename Scalar, typename Predicates = plain_predicates>
+bool overlap_segment_segment_2D(
+    const segment2<Scalar>& seg1, const segment2<Scalar>& seg2, Predicates = Predicates()
+) {
+    const int o1 = Predicates::orientation_2D(seg2[0], seg2[1], seg1[0]);
+    const int o2 = Predicates::orientation_2D(seg2[0], seg2[1], seg1[1]);
+    const int o12 = o1 * o2;
+
+    if (o12 <= 0) {
+        const int o3 = Predicates::orientation_2D(seg1[0], seg1[1], seg2[0]);
+        const int o4 = Predicates::orientation_2D(seg1[0], seg1[1], seg2[1]);
+        const int o34 = o3 * o4;
 
         // if o1 and o2 are opposing and o3 and o4 are opposing
-        if (o12 < (Scalar)0 && o34 < (Scalar)0)
+        if (o12 < 0 && o34 < 0)
             return true;
 
         // in the case that one or both of the endpoints of a segment are colinear with the other segment
@@ -35,35 +126,60 @@ bool overlap_segment_segment_2D(const segment2<Scalar>& seg1, const segment2<Sca
                 min_on_dim(seg, 1) <= v[1] && v[1] <= max_on_dim(seg, 1);
         };
 
-        return (o1 == (Scalar)0 && on_segment(seg2, seg1[0])) ||
-            (o2 == (Scalar)0 && on_segment(seg2, seg1[1])) ||
-            (o3 == (Scalar)0 && on_segment(seg1, seg2[0])) ||
-            (o4 == (Scalar)0 && on_segment(seg1, seg2[1]));
+        return (o1 == 0 && on_segment(seg2, seg1[0])) ||
+            (o2 == 0 && on_segment(seg2, seg1[1])) ||
+            (o3 == 0 && on_segment(seg1, seg2[0])) ||
+            (o4 == 0 && on_segment(seg1, seg2[1]));
     }
 
     return false;
 }
 
-template <typename Scalar>
+/**
+ * The Predicates decide whether and where on their ends the segments meet, the parameters of a crossing come from
+ * the floating point signed areas.
+ *
+ * For integer coordinates every predicate is exact, the point of a crossing is rounded to the nearest integer point
+ * and the parameters are doubles.
+ */
+template <typename Scalar, typename Predicates = plain_predicates>
 std::pair<intersection::result_segment_segment<2, Scalar>, bool>
-intersect_segment_segment_2D(const segment2<Scalar>& seg1, const segment2<Scalar>& seg2) {
+intersect_segment_segment_2D(const segment2<Scalar>& seg1, const segment2<Scalar>& seg2, Predicates = Predicates()) {
     intersection::result_segment_segment<2, Scalar> result(seg1, seg2);
 
-    auto o1 = signed_area_2D(seg2[0], seg2[1], seg1[0]);
-    auto o2 = signed_area_2D(seg2[0], seg2[1], seg1[1]);
-    auto o12 = o1 * o2;
+    const int o1 = Predicates::orientation_2D(seg2[0], seg2[1], seg1[0]);
+    const int o2 = Predicates::orientation_2D(seg2[0], seg2[1], seg1[1]);
+    const int o12 = o1 * o2;
+
+    if (o12 <= 0) {
+        const int o3 = Predicates::orientation_2D(seg1[0], seg1[1], seg2[0]);
+        const int o4 = Predicates::orientation_2D(seg1[0], seg1[1], seg2[1]);
+        const int o34 = o3 * o4;
 
-    if (o12 <= (Scalar)0) {
-        auto o3 = signed_area_2D(seg1[0], seg1[1], seg2[0]);
-        auto o4 = signed_area_2D(seg1[0], seg1[1], seg2[1]);
-        // auto o4 = o1 + o2 - o3; // introduces rounding error
-        auto o34 = o3 * o4;
+        // where along seg1 (seg2) the other segment crosses it, kept within the segment when the areas round badly
+        auto t1 = [&]() {
+            return crossing_parameter_2D<Scalar>(
+                signed_area_2D(seg2[0], seg2[1], seg1[0]), signed_area_2D(seg2[0], seg2[1], seg1[1])
+            );
+        };
+        auto t2 = [&]() {
+            return crossing_parameter_2D<Scalar>(
+                signed_area_2D(seg1[0], seg1[1], seg2[0]), signed_area_2D(seg1[0], seg1[1], seg2[1])
+            );
+        };
 
         // if o1 and o2 are opposing and o3 and o4 are opposing
-        if (o12 < (Scalar)0 && o34 < (Scalar)0) {
-            result.t1 = o1 / (o1 - o2);
-            result.t2 = o3 / (o3 - o4);
-            result.point = evaluate_at_t(result.segment1, result.t1);
+        if (o12 < 0 && o34 < 0) {
+            result.t1 = t1();
+            result.t2 = t2();
+            if constexpr (std::is_integral<Scalar>::value) {
+                result.point = snapped_crossing_2D(
+                    seg1, signed_area_2D(seg2[0], seg2[1], seg1[0]), signed_area_2D(seg2[0], seg2[1], seg1[1])
+                );
+            }
+            else {
+                result.point = evaluate_at_t(result.segment1, result.t1);
+            }
             return std::make_pair(result, true);
         }
 
@@ -75,45 +191,47 @@ intersect_segment_segment_2D(const segment2<Scalar>& seg1, const segment2<Scalar
                 min_on_dim(seg, 1) <= v[1] && v[1] <= max_on_dim(seg, 1);
         };
 
-        if (o1 == (Scalar)0) {
+        if (o1 == 0) {
             // colinear
-            if (o2 == (Scalar)0 && o3 == (Scalar)0 && o4 == (Scalar)0) {
+            if (o2 == 0 && o3 == 0 && o4 == 0) {
                 if (on_segment(seg1, seg2[0]))
                     result.point = seg2[0];
                 else if (on_segment(seg1, seg2[1]))
                     result.point = seg2[1];
+                else if (on_segment(seg2, seg1[0]))    // seg1 lies within seg2
+                    result.point = seg1[0];
                 else
                     return std::make_pair(result, false);
 
-                result.t1 = inv_lerp(seg1[0], seg1[1], result.point);
-                result.t2 = inv_lerp(seg2[0], seg2[1], result.point);
+                result.t1 = parameter_on_segment_2D(seg1, result.point);
+                result.t2 = parameter_on_segment_2D(seg2, result.point);
                 return std::make_pair(result, true);
             }
             else if (on_segment(seg2, seg1[0])) {
                 result.point = seg1[0];
                 result.t1 = 0;
-                result.t2 = o3 / (o3 - o4);
+                result.t2 = t2();
                 return std::make_pair(result, true);
             }
         }
 
-        if (o2 == (Scalar)0 && on_segment(seg2, seg1[1])) {
+        if (o2 == 0 && on_segment(seg2, seg1[1])) {
             result.point = seg1[1];
             result.t1 = 1;
-            result.t2 = o3 / (o3 - o4);
+            result.t2 = t2();
             return std::make_pair(result, true);
         }
 
-        if (o3 == (Scalar)0 && on_segment(seg1, seg2[0])) {
+        if (o3 == 0 && on_segment(seg1, seg2[0])) {
             result.point = seg2[0];
-            result.t1 = o1 / (o1 - o2);
+            result.t1 = t1();
             result.t2 = 0;
             return std::make_pair(result, true);
         }
 
-        if (o4 == (Scalar)0 && on_segment(seg1, seg2[1])) {
+        if (o4 == 0 && on_segment(seg1, seg2[1])) {
             result.point = seg2[1];
-            result.t1 = o1 / (o1 - o2);
+            result.t1 = t1();
             result.t2 = 1;
             return std::make_pair(result, true);
         }
@@ -1,251 +1,595 @@
 #ifndef _MTLIB_INTERSECT_SEGMENTS_2D_H_
 #define _MTLIB_INTERSECT_SEGMENTS_2D_H_
 
+#include "MTLib/algebra/predicates.h"
 #include "MTLib/algebra/vec.h"
-#include "MTLib/intersection/intersect_segment_vec_2D.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
 #include "MTLib/geometry/segment.h"
+#include "MTLib/util/pool_allocator.h"
+#include "MTLib/util/span.h"
 
 #include <algorithm>
-#include <array>
 #include <cassert>
-#include <functional>
+#include <cmath>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
 #include <iterator>
-#include <map>
+#include <limits>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace mtlib {
-namespace {
+namespace intersection {
+
+/**
+ * Position of a segment in the input of a sweep.
+ */
+using segment_index = std::uint32_t;
+
+/**
+ * True if lhs and rhs differ by no more than the rounding of an intersection point.
+ */
+template <typename Scalar>
+bool rounds_to_2D(const vec2<Scalar>& lhs, const vec2<Scalar>& rhs) {
+    const auto scale = std::max({(Scalar)1, std::abs(rhs[0]), std::abs(rhs[1])});
+    const auto tolerance = (Scalar)16 * std::numeric_limits<Scalar>::epsilon() * scale;
+    return std::abs(lhs[0] - rhs[0]) <= tolerance && std::abs(lhs[1] - rhs[1]) <= tolerance;
+}
 
-template<typename Scalar>
-struct segment_comparer;
-template<typename Scalar> vec2 <Scalar> segment_comparer_point;
-enum state_e {
-    LEXICOGRAPHIC,
-    SLOPE_BEFORE_POINT,
-    SLOPE_AFTER_POINT
-} segment_comparer_state = LEXICOGRAPHIC;
+/**
+ * The state that the sweep line comparison depends on.
+ *
+ * Owned by a segment_sweep_2D so that independent sweeps never share it.
+ */
+template <typename Scalar>
+struct sweep_line_state_2D {
+    // segments with their lexicographically smaller endpoint first
+    const std::vector<segment2<Scalar>>* segments = nullptr;
+    // flags the segments that pass through point
+    const std::vector<bool>* in_event = nullptr;
+    // the event point currently being processed
+    vec2<Scalar> point;
+    // the x the sweep started at, segments starting left of it were put on the sweep line there
+    Scalar start_x = std::numeric_limits<Scalar>::lowest();
+};
 
+/**
+ * Orders segment indices bottom to top along the sweep line through state->point.
+ *
+ * Segments that meet on the sweep line above the event point are ordered as they are before the meeting point,
+ * segments that meet at or below it are ordered as they are after it.  Vertical segments are treated as passing
+ * through the event point and are ordered above every other segment through it.
+ *
+ * Every comparison is an orientation test of Predicates against segment endpoints and the event point, which is exact
+ * with adaptive_predicates.  A segment through the event point is compared with the others at the event point.  Two
+ * segments apart from it are compared at the later of their left endpoints, where their order is the one at the
+ * sweep line as long as they do not cross in between, which the sweep guarantees for neighbours.  Two segments
+ * starting left of state->start_x are compared at start_x by their heights in floating point, and ordered as after
+ * start_x when they meet there.
+ */
+template <typename Scalar, typename Predicates = plain_predicates>
+struct segment_comparer {
+    using is_transparent = vec2<Scalar>;
 
-template<
-        typename ForwardIt, typename OutputIt,
-        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
->
-void intersect_segments_2D(const ForwardIt &first, const ForwardIt &last, OutputIt d_first) {
-    segment_comparer<Scalar> sweep_line_cmp;
-    std::set<
-        segment2<Scalar>, segment_comparer<Scalar>
-    > sweep_line_state(sweep_line_cmp);
-
-    std::map<
-        vec2<Scalar>, std::set<segment2<Scalar>>
-    > event_schedule;
-
-    std::for_each(
-        first, last,
-        [&](auto seg) {
-            event_schedule.insert({max_endpoint(seg), {}});
-
-            const auto[it, success] = event_schedule.insert(
-                    {min_endpoint(seg), {seg}}
-            );
-            if (!success)
-                it->second.insert(seg);
-        }
-    );
+    explicit segment_comparer(const sweep_line_state_2D<Scalar>* state)
+        : state_(state)
+    {}
+
+    bool operator()(segment_index lhs, segment_index rhs) const {
+        const auto& seg_lhs = (*state_->segments)[lhs];
+        const auto& seg_rhs = (*state_->segments)[rhs];
+
+        // sign of the height of lhs minus the height of rhs at the sweep line
+        int order;
+        if (at_point(lhs))
+            order = at_point(rhs) ? 0 : -side(rhs, state_->point);
+        else if (at_point(rhs))
+            order = side(lhs, state_->point);
+        else if (std::max(seg_lhs[0][0], seg_rhs[0][0]) < state_->start_x)
+            return less_at_start(lhs, rhs);
+        else if (seg_lhs[0] < seg_rhs[0])
+            order = side(lhs, seg_rhs[0]);
+        else
+            order = -side(rhs, seg_lhs[0]);
+
+        if (order != 0)
+            return order < 0;
+
+        // positive if rhs is steeper than lhs
+        const auto turn = Predicates::turn_2D(seg_lhs[0], seg_lhs[1], seg_rhs[0], seg_rhs[1]);
+        if (turn != 0)
+            return at_point(lhs) || side(lhs, state_->point) <= 0 ? turn > 0 : turn < 0;
 
-    while (!event_schedule.empty()) {
-        auto event = event_schedule.begin();
-        const auto point = event->first;
+        return lhs < rhs;
+    }
 
-        std::set<segment2<Scalar>> right;
-        std::set<segment2<Scalar>> contains;
-        std::set<segment2<Scalar>> &left = event->second;
+    bool operator()(segment_index lhs, const vec2<Scalar>& rhs) const {
+        return side(lhs, rhs) < 0;
+    }
 
-        segment_comparer_state = SLOPE_BEFORE_POINT;
-        segment_comparer_point<Scalar> = point;
+    bool operator()(const vec2<Scalar>& lhs, segment_index rhs) const {
+        return side(rhs, lhs) > 0;
+    }
 
-        const auto segments_touching_point = sweep_line_state.equal_range(point);
-        for (auto it = segments_touching_point.first; it != segments_touching_point.second; ++it) {
-            if (max_endpoint(*it) == point)
-                right.insert(*it);
-            else
-                contains.insert(*it);
+private:
+    // the order at start_x, segments meeting there are ordered as they are after it, as their crossing may have been
+    // rounded to the left of start_x and never become an event
+    bool less_at_start(segment_index lhs, segment_index rhs) const {
+        const auto& seg_lhs = (*state_->segments)[lhs];
+        const auto& seg_rhs = (*state_->segments)[rhs];
+        const auto x = state_->start_x;
+        const auto y_lhs = x == seg_lhs[1][0] ? seg_lhs[1][1] : evaluate_at_x_2D(seg_lhs, x);
+        const auto y_rhs = x == seg_rhs[1][0] ? seg_rhs[1][1] : evaluate_at_x_2D(seg_rhs, x);
+        if (y_lhs != y_rhs)
+            return y_lhs < y_rhs;
+
+        const auto turn = Predicates::turn_2D(seg_lhs[0], seg_lhs[1], seg_rhs[0], seg_rhs[1]);
+        if (turn != 0)
+            return turn > 0;
+        return lhs < rhs;
+    }
+
+    // whether the segment is taken to pass through the event point
+    bool at_point(segment_index idx) const {
+        const auto& seg = (*state_->segments)[idx];
+        return (*state_->in_event)[idx] || (seg[0][0] == seg[1][0] && side(idx, state_->point) == 0);
+    }
+
+    // sign of the height of the segment minus the height of point, at the x of point
+    int side(segment_index idx, const vec2<Scalar>& point) const {
+        // exact, even if point was rounded when computed as an intersection
+        if ((*state_->in_event)[idx])
+            return (state_->point[1] > point[1]) - (state_->point[1] < point[1]);
+
+        const auto& seg = (*state_->segments)[idx];
+        if (seg[0][0] == seg[1][0])
+            return (seg[0][1] > point[1]) - (seg[1][1] < point[1]);
+        return -Predicates::orientation_2D(seg[0], seg[1], point);
+    }
+
+    const sweep_line_state_2D<Scalar>* state_;
+};
+
+/**
+ * Bentley-Ottmann sweep over a set of 2d segments.
+ *
+ * Every instance owns its comparator state, so independent sweeps may run concurrently on separate threads.
+ * A single instance must not be shared between threads.
+ *
+ * The event queue is a flat binary heap, the sweep line allocates its nodes from a pool owned by the instance and
+ * all per event scratch space is kept between runs.  Reusing an instance therefore stops allocating once it has
+ * seen its largest input.
+ *
+ * Predicates is plain_predicates or adaptive_predicates, it decides which segments cross and the order of the sweep
+ * line.
+ */
+template <typename Scalar, typename Predicates = plain_predicates>
+class segment_sweep_2D {
+public:
+    using scalar_type = Scalar;
+    using segment_type = segment2<Scalar>;
+    using point_type = vec2<Scalar>;
+
+    segment_sweep_2D()
+        : sweep_line_(segment_comparer<Scalar, Predicates>(&state_), pool_allocator<segment_index>(&pool_))
+    {
+        state_.segments = &segments_;
+        state_.in_event = &in_event_;
+    }
+
+    // the comparator holds a pointer to state_
+    segment_sweep_2D(const segment_sweep_2D&) = delete;
+    segment_sweep_2D& operator=(const segment_sweep_2D&) = delete;
+
+    /**
+     * Reports every point where two or more segments meet to d_first as a
+     * std::pair<vec2<Scalar>, const std::vector<segment2<Scalar>>&>, in lexicographic order of the points.
+     * The pair converts to a std::pair<vec2<Scalar>, std::vector<segment2<Scalar>>>, the referenced vector is only
+     * valid during the assignment.
+     *
+     * The segments of an event are sorted lexicographically.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt operator()(const ForwardIt& first, const ForwardIt& last, OutputIt d_first) {
+        input_.assign(first, last);
+        load(input_.begin(), input_.end());
+        reset();
+
+        while (next()) {
+            report_.clear();
+            for (auto i : through_)
+                report_.push_back(input_[i]);
+            std::sort(report_.begin(), report_.end());
+            *d_first++ = std::pair<point_type, const std::vector<segment_type>&>(event_point_, report_);
         }
 
-        // if | right U contains U left | > 1, report event
+        return d_first;
+    }
 
-        segment_comparer_state = SLOPE_AFTER_POINT;
-        std::set<segment2<Scalar>, segment_comparer<Scalar>> cl(contains.begin(), contains.end(), sweep_line_cmp);
-        for (auto seg : left)
-            cl.insert(seg);
+    /**
+     * Reports every point where two or more segments meet to d_first as a
+     * std::pair<vec2<Scalar>, span<const segment_index>>, in lexicographic order of the points.
+     *
+     * The span lists the positions of the segments through the point in [first, last) in increasing order.  It
+     * views the elements appended to indices, and stays valid for as long as indices is not modified.  The events
+     * are written once the sweep is complete.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt operator()(
+        const ForwardIt& first, const ForwardIt& last, std::vector<segment_index>& indices, OutputIt d_first
+    ) {
+        start(first, last);
+
+        events_.clear();
+        while (next()) {
+            events_.push_back({event_point_, indices.size(), through_.size()});
+            indices.insert(indices.end(), through_.begin(), through_.end());
+        }
 
-        std::set<segment2<Scalar>> rcl(cl.begin(), cl.end());
-        for (auto seg : right)
-            rcl.insert(seg);
+        for (const auto& event : events_)
+            *d_first++ = std::make_pair(
+                event.point, span<const segment_index>(indices.data() + event.offset, event.size)
+            );
 
-        // report event
-        if (rcl.size() > 1) {
-            std::vector<segment2<Scalar>> out_segments(rcl.begin(), rcl.end());
-            d_first = std::make_pair(point, out_segments);
+        return d_first;
+    }
+
+    /**
+     * Calls visitor(point, span<const segment_index>) for every point where two or more segments meet, in
+     * lexicographic order of the points.  The span lists the positions of the segments through the point in
+     * [first, last) in increasing order, and is only valid during the call.
+     *
+     * A visitor that returns bool stops the sweep by returning false, no later events are computed.
+     *
+     * Returns false if the visitor stopped the sweep.
+     */
+    template <typename ForwardIt, typename Visitor>
+    bool visit(const ForwardIt& first, const ForwardIt& last, Visitor&& visitor) {
+        start(first, last);
+
+        while (next()) {
+            using result_type = std::invoke_result_t<Visitor&, const point_type&, span<const segment_index>>;
+            if constexpr (std::is_same_v<result_type, bool>) {
+                if (!visitor(point(), indices()))
+                    return false;
+            }
+            else {
+                visitor(point(), indices());
+            }
         }
 
-        segment_comparer_state = SLOPE_BEFORE_POINT;
-        for (auto seg : right)
-            sweep_line_state.erase(seg);
+        return true;
+    }
 
-        for (auto seg : contains)
-            sweep_line_state.erase(seg);
+    /**
+     * Starts a lazy sweep over [first, last).  Events are computed one at a time by next().
+     *
+     * The segments are copied, [first, last) need not outlive the sweep.
+     */
+    template <typename ForwardIt>
+    void start(const ForwardIt& first, const ForwardIt& last) {
+        input_.clear();
+        load(first, last);
+        reset();
+    }
 
+    /**
+     * Starts a lazy sweep over [first, last) at the vertical line through x.  Events left of x are never computed: the
+     * segments that start left of x and reach it are put on the sweep line in their order at x, their heights there
+     * compared in floating point, and the others left of x are dropped.
+     */
+    template <typename ForwardIt>
+    void start(const ForwardIt& first, const ForwardIt& last, const Scalar& x) {
+        input_.clear();
+        load(first, last);
+        reset(x);
+    }
 
-        {   // look for new intersection events
-            auto add_if_intersecting = [&](const segment2<Scalar> &lhs, const segment2<Scalar> &rhs) {
-                if (lhs != rhs) {
-                    const auto[result, success] = intersect_segment_segment_2D(lhs, rhs);
-                    if (success && result.point > point)
-                        event_schedule.insert({result.point, {}});
-                }
+    /**
+     * Sweeps to the next point where two or more segments meet.  Returns false when there are none left.
+     *
+     * Stopping before next() returns false leaves the rest of the input unswept.
+     */
+    bool next() {
+        while (!event_queue_.empty()) {
+            const auto point = event_queue_.front().point;
+            state_.point = point;
+
+            // every segment through point: starting, ending, or passing through it
+            through_.clear();
+            while (!event_queue_.empty() && event_queue_.front().point == point) {
+                const auto& entry = event_queue_.front();
+                if (entry.kind != event_kind_e::CROSSING || active_[entry.segment])
+                    through_.push_back(entry.segment);
+
+                std::pop_heap(event_queue_.begin(), event_queue_.end(), later);
+                event_queue_.pop_back();
+            }
+
+            const auto[lower, upper] = sweep_line_.equal_range(point);
+            for (auto it = lower; it != upper; ++it)
+                through_.push_back(*it);
+
+            std::sort(through_.begin(), through_.end());
+            through_.erase(std::unique(through_.begin(), through_.end()), through_.end());
+
+            for (auto i : through_)
+                in_event_[i] = true;
+
+            // a segment concurrent with the others at a point that is not representable may cross them at a rounded
+            // point that has already been swept.  Such crossings, and colinear overlaps, belong to this event.
+            auto meets_at_point = [&](segment_index lhs, segment_index rhs) {
+                const auto& seg_lhs = segments_[lhs];
+                const auto& seg_rhs = segments_[rhs];
+                if (Predicates::orientation_2D(seg_lhs[0], seg_lhs[1], seg_rhs[0]) == 0 &&
+                    Predicates::orientation_2D(seg_lhs[0], seg_lhs[1], seg_rhs[1]) == 0)
+                    return within_bounds(seg_lhs, point) && within_bounds(seg_rhs, point);
+
+                const auto[crossing, success] = intersection_point(lhs, rhs);
+                return success && !(point < crossing) && rounds_to_2D(crossing, point);
             };
 
-            if (sweep_line_state.size() > 1) {
-                const auto[lower_segment, upper_segment] = sweep_line_state.equal_range(point);
-                assert(lower_segment == upper_segment || upper_segment == sweep_line_state.end());
-                // if lower and upper are not equal
-                //  lower_segment contains point
-                //      - lower_segment should have been removed from sweep_line and added to contains
+            grouped_.clear();
+            for (auto i : through_) {
+                if (active_[i])
+                    grouped_.push_back(i);
+            }
 
-                if (lower_segment == sweep_line_state.end()) {
-                    if (!cl.empty())
-                        add_if_intersecting(*(--cl.end()), *std::prev(lower_segment));
-                }
-                else if (upper_segment == sweep_line_state.begin()) {
-                    if (!cl.empty())
-                        add_if_intersecting(*upper_segment, *cl.begin());
-                }
-                else {
-                    if (cl.empty()) {
-                        add_if_intersecting(*std::prev(lower_segment), *upper_segment);
+            for (std::size_t g = 0; g < grouped_.size(); ++g) {
+                auto it = handles_[grouped_[g]];
+                if (it != sweep_line_.begin()) {
+                    const auto below = *std::prev(it);
+                    if (!in_event_[below] && meets_at_point(below, *it)) {
+                        in_event_[below] = true;
+                        through_.push_back(below);
+                        grouped_.push_back(below);
                     }
-                    else {
-                        add_if_intersecting(*std::prev(lower_segment), *cl.begin());
-                        add_if_intersecting(*std::prev(cl.end()), *upper_segment);
+                }
+                if (std::next(it) != sweep_line_.end()) {
+                    const auto above = *std::next(it);
+                    if (!in_event_[above] && meets_at_point(*it, above)) {
+                        in_event_[above] = true;
+                        through_.push_back(above);
+                        grouped_.push_back(above);
                     }
                 }
             }
-            else if (sweep_line_state.size() == 1 && !cl.empty()) {
-                const auto &sweep_segment = *sweep_line_state.begin();
-                add_if_intersecting(sweep_segment, *cl.begin());
-                add_if_intersecting(*(--cl.end()), sweep_segment);
+
+            std::sort(through_.begin(), through_.end());
+
+            // remove the segments that end at or pass through point
+            reinsert_.clear();
+            for (auto i : through_) {
+                if (active_[i]) {
+                    sweep_line_.erase(handles_[i]);
+                    active_[i] = false;
+                }
+                if (segments_[i][1] != point)
+                    reinsert_.push_back(i);
             }
-        }
 
-        segment_comparer_state = SLOPE_AFTER_POINT;
-        for (auto seg : cl)
-            sweep_line_state.insert(seg);
+            // reinsert the segments that continue past point in their order after it
+            for (auto i : reinsert_) {
+                handles_[i] = sweep_line_.insert(i).first;
+                active_[i] = true;
+            }
 
-        event_schedule.erase(event);
-    }
-}
+            if (reinsert_.empty()) {
+                auto upper_it = sweep_line_.lower_bound(point);
+                if (upper_it != sweep_line_.begin() && upper_it != sweep_line_.end())
+                    find_new_event(*std::prev(upper_it), *upper_it, point);
+            }
+            else {
+                auto lowest = handles_[reinsert_.front()];
+                while (lowest != sweep_line_.begin() && in_event_[*std::prev(lowest)])
+                    --lowest;
+
+                auto highest = handles_[reinsert_.front()];
+                while (std::next(highest) != sweep_line_.end() && in_event_[*std::next(highest)])
+                    ++highest;
+
+                if (lowest != sweep_line_.begin())
+                    find_new_event(*std::prev(lowest), *lowest, point);
+                if (std::next(highest) != sweep_line_.end())
+                    find_new_event(*highest, *std::next(highest), point);
+            }
 
-template<typename Scalar>
-struct segment_comparer {
-    using is_transparent = vec2<Scalar>;
+            for (auto i : through_)
+                in_event_[i] = false;
 
-    bool operator()(const segment2 <Scalar> &lhs, const segment2 <Scalar> &rhs) const {
-        switch (segment_comparer_state) {
-            case LEXICOGRAPHIC:
-                return lexicographic(lhs, rhs);
-            case SLOPE_BEFORE_POINT:
-                return slope_before_point(lhs, rhs);
-            case SLOPE_AFTER_POINT:
-                return slope_after_point(lhs, rhs);
+            if (through_.size() > 1) {
+                event_point_ = point;
+                return true;
+            }
         }
 
+        through_.clear();
         return false;
     }
 
-    bool operator()(const segment2 <Scalar> &lhs, const vec2 <Scalar> &rhs) const {
-        if (lhs[0][0] == lhs[1][0])
-            return !overlap_segment_vec_2D(lhs, rhs);   // two failures
-        return evaluate_at_x_2D(lhs, rhs[0]) < rhs[1];
+    /**
+     * The point of the current event.
+     */
+    const point_type& point() const {
+        return event_point_;
     }
 
-    bool operator()(const vec2 <Scalar> &lhs, const segment2 <Scalar> &rhs) const {
-        if (rhs[0][0] == rhs[1][0])
-            return !overlap_segment_vec_2D(rhs, lhs);   // make an equals
-        return lhs[1] < evaluate_at_x_2D(rhs, lhs[0]);
+    /**
+     * The positions in the input of the segments through the current event's point, in increasing order.  Valid
+     * until the next call to next() or start().
+     */
+    span<const segment_index> indices() const {
+        return span<const segment_index>(through_.data(), through_.size());
     }
 
 private:
-    constexpr bool lexicographic(const segment2 <Scalar> &lhs, const segment2 <Scalar> &rhs) const {
-        return lhs < rhs;
+    template <typename ForwardIt>
+    void load(const ForwardIt& first, const ForwardIt& last) {
+        segments_.clear();
+        for (auto it = first; it != last; ++it)
+            segments_.emplace_back(min_endpoint(*it), max_endpoint(*it));
+        assert(segments_.size() <= std::numeric_limits<segment_index>::max());
     }
 
-    constexpr bool slope_before_point(const segment2 <Scalar> &lhs, const segment2 <Scalar> &rhs) const {
-        bool overlap_lhs = overlap_segment_vec_2D(lhs, segment_comparer_point<Scalar>);
-        bool overlap_rhs = overlap_segment_vec_2D(rhs, segment_comparer_point<Scalar>);
-        const auto[slope_lhs, slope_lhs_exists] = slope_2D(lhs);
-        const auto[slope_rhs, slope_rhs_exists] = slope_2D(rhs);
-
-        if (overlap_lhs && overlap_rhs) {
-            if (slope_lhs_exists && slope_rhs_exists) {
-                return slope_lhs > slope_rhs || (slope_lhs == slope_rhs && lhs < rhs);
-            } else if (!slope_lhs_exists && !slope_rhs_exists) {
-                return lhs < rhs;
-            }
-
-            return slope_rhs_exists;
+    void reset(Scalar start_x = std::numeric_limits<Scalar>::lowest()) {
+        const auto n_segments = static_cast<segment_index>(segments_.size());
+
+        sweep_line_.clear();
+        handles_.assign(n_segments, sweep_line_.end());
+        active_.assign(n_segments, false);
+        in_event_.assign(n_segments, false);
+        through_.clear();
+        state_.start_x = start_x;
+
+        event_queue_.clear();
+        reinsert_.clear();
+        for (segment_index i = 0; i < n_segments; ++i) {
+            if (segments_[i][1][0] < start_x)
+                continue;
+            if (segments_[i][0][0] < start_x)
+                reinsert_.push_back(i);
+            else
+                event_queue_.push_back({segments_[i][0], i, event_kind_e::START});
+            event_queue_.push_back({segments_[i][1], i, event_kind_e::END});
         }
+        std::make_heap(event_queue_.begin(), event_queue_.end(), later);
 
-        if (slope_lhs_exists && slope_rhs_exists) {
-            return evaluate_at_x_2D(lhs, segment_comparer_point<Scalar>[0]) <
-                   evaluate_at_x_2D(rhs, segment_comparer_point<Scalar>[0]);
-        }
-        else if (!slope_lhs_exists && !slope_rhs_exists) {
-            return max_on_dim(lhs, 1) < max_on_dim(rhs, 1);
-        }
-        else if (slope_lhs_exists) {
-            return evaluate_at_x_2D(lhs, segment_comparer_point<Scalar>[0]) < segment_comparer_point<Scalar>[1];
+        // the segments across start_x, every neighbouring pair may cross from there on
+        state_.point = point_type(start_x, std::numeric_limits<Scalar>::lowest());
+        for (auto i : reinsert_) {
+            handles_[i] = sweep_line_.insert(i).first;
+            active_[i] = true;
         }
-
-        // slope_rhs_exists
-        return segment_comparer_point<Scalar>[1] < evaluate_at_x_2D(rhs, segment_comparer_point<Scalar>[0]);
+        for (auto it = sweep_line_.begin(); it != sweep_line_.end() && std::next(it) != sweep_line_.end(); ++it)
+            find_new_event(*it, *std::next(it), state_.point);
     }
 
-    constexpr bool slope_after_point(const segment2 <Scalar> &lhs, const segment2 <Scalar> &rhs) const {
-        bool overlap_lhs = overlap_segment_vec_2D(lhs, segment_comparer_point<Scalar>);
-        bool overlap_rhs = overlap_segment_vec_2D(rhs, segment_comparer_point<Scalar>);
-        const auto[slope_lhs, slope_lhs_exists] = slope_2D(lhs);
-        const auto[slope_rhs, slope_rhs_exists] = slope_2D(rhs);
 
-        if (overlap_lhs && overlap_rhs) {
-            if (slope_lhs_exists && slope_rhs_exists) {
-                return slope_lhs < slope_rhs || (slope_lhs == slope_rhs && lhs > rhs);
-            } else if (!slope_lhs_exists && !slope_rhs_exists) {
-                return lhs > rhs;
-            }
+    using sweep_line_type =
+        std::set<segment_index, segment_comparer<Scalar, Predicates>, pool_allocator<segment_index>>;
+
+    enum class event_kind_e {
+        START,
+        END,
+        // the segment was found to pass through the point by an intersection test
+        CROSSING
+    };
+
+    struct event_type {
+        point_type point;
+        segment_index segment;
+        event_kind_e kind;
+    };
+
+    // an event of the index overload, a range of the caller's indices
+    struct index_event_type {
+        point_type point;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    // heap order, the lexicographically smallest point is on top
+    static bool later(const event_type& lhs, const event_type& rhs) {
+        return rhs.point < lhs.point;
+    }
 
-            return slope_lhs_exists;
-        }
+    static bool within_bounds(const segment_type& seg, const point_type& point) {
+        return seg[0][0] <= point[0] && point[0] <= seg[1][0] &&
+            min_on_dim(seg, 1) <= point[1] && point[1] <= max_on_dim(seg, 1);
+    }
 
-        if (slope_lhs_exists && slope_rhs_exists) {
-            return evaluate_at_x_2D(lhs, segment_comparer_point<Scalar>[0]) <
-                   evaluate_at_x_2D(rhs, segment_comparer_point<Scalar>[0]);
-        }
-        else if (!slope_lhs_exists && !slope_rhs_exists) {
-            return max_on_dim(lhs, 1) < max_on_dim(rhs, 1);
-        }
-        else if (slope_lhs_exists) {
-            return evaluate_at_x_2D(lhs, segment_comparer_point<Scalar>[0]) < segment_comparer_point<Scalar>[1];
+    std::pair<point_type, bool> intersection_point(segment_index lhs, segment_index rhs) const {
+        // a fixed argument order keeps the rounding of a pair's intersection point the same every time it is tested
+        if (rhs < lhs)
+            std::swap(lhs, rhs);
+
+        const auto& seg_lhs = segments_[lhs];
+        const auto& seg_rhs = segments_[rhs];
+        auto[result, success] = intersect_segment_segment_2D(seg_lhs, seg_rhs, Predicates());
+
+        // the point lies in both bounding boxes, which keeps it exact on vertical and horizontal segments
+        for (std::size_t dim = 0; dim < 2; ++dim) {
+            result.point[dim] = std::clamp(
+                result.point[dim],
+                std::max(min_on_dim(seg_lhs, dim), min_on_dim(seg_rhs, dim)),
+                std::min(max_on_dim(seg_lhs, dim), max_on_dim(seg_rhs, dim))
+            );
         }
 
-        // slope_rhs_exists
-        return segment_comparer_point<Scalar>[1] < evaluate_at_x_2D(rhs, segment_comparer_point<Scalar>[0]);
+        return std::make_pair(result.point, success);
+    }
+
+    void find_new_event(segment_index lhs, segment_index rhs, const point_type& point) {
+        const auto[crossing, success] = intersection_point(lhs, rhs);
+        if (success && crossing > point) {
+            event_queue_.push_back({crossing, lhs, event_kind_e::CROSSING});
+            std::push_heap(event_queue_.begin(), event_queue_.end(), later);
+            event_queue_.push_back({crossing, rhs, event_kind_e::CROSSING});
+            std::push_heap(event_queue_.begin(), event_queue_.end(), later);
+        }
     }
+
+    sweep_line_state_2D<Scalar> state_;
+    point_type event_point_;
+    node_pool pool_;
+    sweep_line_type sweep_line_;
+    std::vector<event_type> event_queue_;
+
+    std::vector<segment_type> input_;
+    std::vector<segment_type> segments_;
+    std::vector<typename sweep_line_type::iterator> handles_;
+    std::vector<bool> active_;
+    std::vector<bool> in_event_;
+
+    // per event scratch
+    std::vector<segment_index> through_;
+    std::vector<segment_index> reinsert_;
+    std::vector<segment_index> grouped_;
+    std::vector<segment_type> report_;
+    std::vector<index_event_type> events_;
 };
 
+}   // namespace intersection
+
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+void intersect_segments_2D(const ForwardIt &first, const ForwardIt &last, OutputIt d_first) {
+    intersection::segment_sweep_2D<Scalar> sweep;
+    sweep(first, last, d_first);
+}
+
+/**
+ * Reports every point where two or more segments meet as a std::pair<vec2<Scalar>, span<const uint32_t>> of the
+ * positions in [first, last) of the segments through it.  The spans view the indices appended to indices.
+ */
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+void intersect_segments_2D(
+    const ForwardIt &first, const ForwardIt &last, std::vector<intersection::segment_index>& indices, OutputIt d_first
+) {
+    intersection::segment_sweep_2D<Scalar> sweep;
+    sweep(first, last, indices, d_first);
+}
+
+/**
+ * Calls visitor(point, span<const uint32_t>) for every point where two or more segments meet, see
+ * segment_sweep_2D::visit.  Returns false if the visitor stopped the sweep.
+ */
+template<
+        typename ForwardIt, typename Visitor,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+bool visit_intersections_2D(const ForwardIt &first, const ForwardIt &last, Visitor&& visitor) {
+    intersection::segment_sweep_2D<Scalar> sweep;
+    return sweep.visit(first, last, std::forward<Visitor>(visitor));
 }
+
 }   // namespace mtlib
 
-#endif // _MTLIB_INTERSECT_SEGMENTS_2D_H_
\ No newline at end of file
+#endif // _MTLIB_INTERSECT_SEGMENTS_2D_H_
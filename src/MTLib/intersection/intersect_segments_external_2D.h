@@ -0,0 +1,215 @@
+#ifndef _MTLIB_INTERSECT_SEGMENTS_EXTERNAL_2D_H_
+#define _MTLIB_INTERSECT_SEGMENTS_EXTERNAL_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+#include "MTLib/intersection/intersect_segments_parallel_2D.h"
+#include "MTLib/util/external_sort.h"
+#include "MTLib/util/mapped_file.h"
+#include "MTLib/util/span.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+#include <cstdio>
+#include <cstring>  // memcpy
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * A segment in the out-of-core sweep, lexicographically smaller endpoint first, with its position in the input.
+ */
+template <typename Scalar>
+struct external_segment_2D {
+    segment2<Scalar> seg;
+    segment_index index;
+};
+
+template <typename Scalar>
+struct external_segment_less_2D {
+    bool operator()(const external_segment_2D<Scalar>& lhs, const external_segment_2D<Scalar>& rhs) const {
+        return lhs.seg[0][0] < rhs.seg[0][0] || (lhs.seg[0][0] == rhs.seg[0][0] && lhs.index < rhs.index);
+    }
+};
+
+/**
+ * Estimate of the bytes segment_sweep_2D and the slab bookkeeping hold per swept segment, used to turn the memory
+ * budget into a number of segments per slab.
+ */
+constexpr std::size_t swept_segment_bytes = 256;
+
+}   // namespace intersection
+
+/**
+ * Writes the segments in [first, last) to path in the format read by intersect_segments_external_2D: four Scalars
+ * x0, y0, x1, y1 per segment in native byte order.  Returns false on an I/O error.
+ */
+template<
+        typename ForwardIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+bool write_segments_2D(const std::string& path, const ForwardIt& first, const ForwardIt& last) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(std::fopen(path.c_str(), "wb"), &std::fclose);
+    if (!file)
+        return false;
+
+    for (auto it = first; it != last; ++it) {
+        const Scalar record[4] = {(*it)[0][0], (*it)[0][1], (*it)[1][0], (*it)[1][1]};
+        if (std::fwrite(record, sizeof(Scalar), 4, file.get()) != 4)
+            return false;
+    }
+    return std::fclose(file.release()) == 0;
+}
+
+/**
+ * Calls visit(point, span<const uint32_t>) for every report in a file written by intersect_segments_external_2D.
+ * Returns false on an I/O error or a truncated file.
+ */
+template <typename Scalar, typename Visitor>
+bool visit_intersection_reports_2D(const std::string& path, Visitor&& visit) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (!file)
+        return false;
+
+    std::vector<intersection::segment_index> indices;
+    Scalar point[2];
+    while (std::fread(point, sizeof(Scalar), 2, file.get()) == 2) {
+        std::uint32_t size;
+        if (std::fread(&size, sizeof(size), 1, file.get()) != 1)
+            return false;
+        indices.resize(size);
+        if (std::fread(indices.data(), sizeof(intersection::segment_index), size, file.get()) != size)
+            return false;
+        visit(vec2<Scalar>(point[0], point[1]), span<const intersection::segment_index>(indices));
+    }
+    return !std::ferror(file.get());
+}
+
+/**
+ * Out-of-core intersect_segments_2D over a file of segments written by write_segments_2D.
+ *
+ * The segments are read once through a memory mapping and sorted by their left x with an external merge sort.  The
+ * sorted stream is then cut into x-slabs of about memory_budget / 2 bytes of segments, each swept with segment_sweep_2D
+ * together with the segments carried over from earlier slabs, as in intersect_segments_parallel_2D.  Every point where
+ * two or more segments meet is appended to report_path as the point's two Scalars, a uint32_t count and the uint32_t
+ * positions of the segments in the input, in the order of the sequential sweep.
+ *
+ * memory_budget bounds the segments held at any time.  It is exceeded when the segments crossing one x, or starting
+ * at the same x, do not fit in it, and the sweep of a slab also holds the intersections inside it.  Rounding of
+ * points where three or more segments meet follows intersect_segments_parallel_2D.  Returns false on an I/O error.
+ */
+template <typename Scalar>
+bool intersect_segments_external_2D(
+    const std::string& segment_path, const std::string& report_path, std::size_t memory_budget = std::size_t(256) << 20
+) {
+    using namespace intersection;
+    using record_type = external_segment_2D<Scalar>;
+    constexpr std::size_t segment_bytes = 4 * sizeof(Scalar);
+
+    mapped_file input;
+    if (!input.open(segment_path) || input.size() % segment_bytes != 0)
+        return false;
+    const auto n_segments = input.size() / segment_bytes;
+    if (n_segments > std::numeric_limits<segment_index>::max())
+        return false;
+
+    // sorted runs take half the budget, mapped pages are released as soon as they are copied into a run
+    external_sorter<record_type, external_segment_less_2D<Scalar>> sorter(memory_budget / 2);
+    const auto release_every = std::max<std::size_t>(memory_budget / 8 / segment_bytes, 1);
+    for (std::size_t i = 0; i < n_segments; ++i) {
+        Scalar values[4];
+        std::memcpy(values, input.data() + i * segment_bytes, segment_bytes);
+        const vec2<Scalar> p(values[0], values[1]);
+        const vec2<Scalar> q(values[2], values[3]);
+        if (!sorter.push({segment2<Scalar>(std::min(p, q), std::max(p, q)), static_cast<segment_index>(i)}))
+            return false;
+        if ((i + 1) % release_every == 0)
+            input.release((i + 1 - release_every) * segment_bytes, release_every * segment_bytes);
+    }
+    input.close();
+    if (!sorter.finish())
+        return false;
+
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> output(std::fopen(report_path.c_str(), "wb"), &std::fclose);
+    if (!output)
+        return false;
+
+    const auto capacity = std::max<std::size_t>(memory_budget / 2 / swept_segment_bytes, 2);
+    std::vector<record_type> members;
+    std::vector<segment2<Scalar>> subset;
+    std::vector<Scalar> boundaries;
+    slab_events_2D<Scalar> events;
+    std::vector<segment_index> report;
+
+    bool first_slab = true;
+    Scalar lo = 0;
+    while (!sorter.empty()) {
+        // take segments up to the capacity, but never split the segments that start at the same x
+        bool taken = false;
+        Scalar last_x = 0;
+        while (!sorter.empty()) {
+            const auto& record = sorter.front();
+            if (taken && members.size() >= capacity && record.seg[0][0] != last_x)
+                break;
+            last_x = record.seg[0][0];
+            taken = true;
+            members.push_back(record);
+            if (!sorter.pop())
+                return false;
+        }
+        const bool last_slab = sorter.empty();
+        const Scalar hi = last_slab ? last_x : sorter.front().seg[0][0];
+
+        // the slab is [lo, hi), swept with its members in input order as the sequential sweep would
+        std::sort(members.begin(), members.end(), [](const record_type& lhs, const record_type& rhs) {
+            return lhs.index < rhs.index;
+        });
+        subset.clear();
+        for (const auto& member : members)
+            subset.push_back(member.seg);
+
+        boundaries.clear();
+        if (!first_slab)
+            boundaries.push_back(lo);
+        if (!last_slab)
+            boundaries.push_back(hi);
+
+        events.indices.clear();
+        events.events.clear();
+        sweep_slab_2D(subset, boundaries, first_slab ? 0 : 1, events);
+
+        for (const auto& event : events.events) {
+            report.clear();
+            for (auto k = event.offset; k < event.offset + event.size; ++k)
+                report.push_back(members[events.indices[k]].index);
+
+            const Scalar point[2] = {event.point[0], event.point[1]};
+            const auto size = static_cast<std::uint32_t>(report.size());
+            if (std::fwrite(point, sizeof(Scalar), 2, output.get()) != 2 ||
+                std::fwrite(&size, sizeof(size), 1, output.get()) != 1 ||
+                std::fwrite(report.data(), sizeof(segment_index), size, output.get()) != size)
+                return false;
+        }
+
+        // the segments reaching past the slab are carried into the next one
+        members.erase(
+            std::remove_if(members.begin(), members.end(), [&](const record_type& r) { return r.seg[1][0] < hi; }),
+            members.end()
+        );
+        lo = hi;
+        first_slab = false;
+    }
+
+    return std::fclose(output.release()) == 0;
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_INTERSECT_SEGMENTS_EXTERNAL_2D_H_
@@ -0,0 +1,511 @@
+#ifndef _MTLIB_INTERSECT_SEGMENTS_GRID_2D_H_
+#define _MTLIB_INTERSECT_SEGMENTS_GRID_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+#include "MTLib/util/span.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * Segment intersection by bucketing the segments into a uniform grid and testing the pairs that share a cell.
+ *
+ * The cell size is the mean segment length, or larger if that would make more than a few cells per segment.  A pair
+ * is tested in every cell it shares but only reported from the cell that holds its intersection point, so each pair
+ * is reported once.  Pairs are tested with intersect_segment_segment_2D and their points are rounded exactly as in
+ * segment_sweep_2D.
+ *
+ * Fast for many short segments, quadratic when long segments pile up in the same cells.  The events are the points
+ * where two or more segments meet, as reported by segment_sweep_2D.  Like the sweep, segments whose pairwise
+ * intersections round to nearly the same point are reported at the smallest of those points, whichever cells the
+ * points fall in, but where three or more segments meet at a point that is not representable the two may still group
+ * them differently.
+ *
+ * Reusing an instance reuses its buffers.
+ */
+template <typename Scalar>
+class segment_grid_2D {
+public:
+    using scalar_type = Scalar;
+    using segment_type = segment2<Scalar>;
+    using point_type = vec2<Scalar>;
+
+    /**
+     * Reports every point where two or more segments meet to d_first as a
+     * std::pair<vec2<Scalar>, const std::vector<segment2<Scalar>>&>, like segment_sweep_2D.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt operator()(const ForwardIt& first, const ForwardIt& last, OutputIt d_first) {
+        input_.assign(first, last);
+        run(input_.begin(), input_.end());
+
+        for (const auto& event : events_) {
+            report_.clear();
+            for (auto it = hits_.begin() + event.offset; it != hits_.begin() + event.offset + event.size; ++it)
+                report_.push_back(input_[it->index]);
+            std::sort(report_.begin(), report_.end());
+            *d_first++ = std::pair<point_type, const std::vector<segment_type>&>(event.point, report_);
+        }
+
+        return d_first;
+    }
+
+    /**
+     * Reports every point where two or more segments meet to d_first as a
+     * std::pair<vec2<Scalar>, span<const segment_index>>, like segment_sweep_2D.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt operator()(
+        const ForwardIt& first, const ForwardIt& last, std::vector<segment_index>& indices, OutputIt d_first
+    ) {
+        run(first, last);
+
+        const auto offset = indices.size();
+        for (const auto& hit : hits_)
+            indices.push_back(hit.index);
+
+        for (const auto& event : events_)
+            *d_first++ = std::make_pair(
+                event.point, span<const segment_index>(indices.data() + offset + event.offset, event.size)
+            );
+
+        return d_first;
+    }
+
+    /**
+     * The cell size chosen for the last input.
+     */
+    Scalar cell_size() const {
+        return cell_size_;
+    }
+
+private:
+    struct hit_type {
+        point_type point;
+        segment_index index;
+
+        bool operator<(const hit_type& rhs) const {
+            return point < rhs.point || (point == rhs.point && index < rhs.index);
+        }
+
+        bool operator==(const hit_type& rhs) const {
+            return point == rhs.point && index == rhs.index;
+        }
+    };
+
+    struct event_type {
+        point_type point;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    template <typename ForwardIt>
+    void run(const ForwardIt& first, const ForwardIt& last) {
+        segments_.clear();
+        for (auto it = first; it != last; ++it)
+            segments_.emplace_back(min_endpoint(*it), max_endpoint(*it));
+        assert(segments_.size() <= std::numeric_limits<segment_index>::max());
+
+        hits_.clear();
+        events_.clear();
+        if (segments_.empty())
+            return;
+
+        build_grid();
+        test_cells();
+
+        // hits at the same point form an event
+        group_hits();
+
+        // like the sweep, segments whose intersections round to nearly the same point meet at the smallest of them.
+        // The events are sorted by x, then y, so the preceding events that may round to events_[e] form runs of one
+        // x within the rounding in x, and only the part of each run within the rounding in y is visited.  Merges
+        // chain, so they go through a union-find.
+        const auto near = [&](const event_type& event, const point_type& point, std::size_t dim) {
+            auto projected = point;
+            projected[dim] = event.point[dim];
+            return rounds_to_2D(projected, point);
+        };
+        representative_.resize(events_.size());
+        for (std::size_t e = 0; e < events_.size(); ++e) {
+            representative_[e] = e;
+            const auto& point = events_[e].point;
+            for (auto run_end = events_.begin() + e;
+                 run_end != events_.begin() && near(*std::prev(run_end), point, 0);) {
+                const auto x = std::prev(run_end)->point[0];
+                const auto run_begin = std::partition_point(events_.begin(), run_end, [&](const event_type& event) {
+                    return event.point[0] < x;
+                });
+                auto it = std::partition_point(run_begin, run_end, [&](const event_type& event) {
+                    return event.point[1] < point[1] && !near(event, point, 1);
+                });
+                for (; it != run_end && near(*it, point, 1); ++it) {
+                    const auto k = static_cast<std::size_t>(it - events_.begin());
+                    if (rounds_to_2D(it->point, point) && share_segment(*it, events_[e])) {
+                        const auto root_k = find_representative(k);
+                        const auto root_e = find_representative(e);
+                        representative_[std::max(root_k, root_e)] = std::min(root_k, root_e);
+                    }
+                }
+                run_end = run_begin;
+            }
+        }
+
+        bool merged = false;
+        for (std::size_t e = 0; e < events_.size(); ++e) {
+            const auto root = find_representative(e);
+            if (root == e)
+                continue;
+            merged = true;
+            for (auto h = events_[e].offset; h < events_[e].offset + events_[e].size; ++h)
+                hits_[h].point = events_[root].point;
+        }
+        if (merged)
+            group_hits();
+    }
+
+    std::size_t find_representative(std::size_t e) {
+        while (representative_[e] != e) {
+            representative_[e] = representative_[representative_[e]];
+            e = representative_[e];
+        }
+        return e;
+    }
+
+    void group_hits() {
+        std::sort(hits_.begin(), hits_.end());
+        hits_.erase(std::unique(hits_.begin(), hits_.end()), hits_.end());
+
+        events_.clear();
+        for (std::size_t first_hit = 0; first_hit < hits_.size();) {
+            auto last_hit = first_hit + 1;
+            while (last_hit < hits_.size() && hits_[last_hit].point == hits_[first_hit].point)
+                ++last_hit;
+            events_.push_back({hits_[first_hit].point, first_hit, last_hit - first_hit});
+            first_hit = last_hit;
+        }
+    }
+
+    bool share_segment(const event_type& lhs, const event_type& rhs) const {
+        auto l = hits_.begin() + lhs.offset;
+        auto r = hits_.begin() + rhs.offset;
+        const auto l_end = l + lhs.size;
+        const auto r_end = r + rhs.size;
+        while (l != l_end && r != r_end) {
+            if (l->index == r->index)
+                return true;
+            if (l->index < r->index)
+                ++l;
+            else
+                ++r;
+        }
+        return false;
+    }
+
+    void build_grid() {
+        origin_ = segments_[0][0];
+        auto extent = origin_;
+        Scalar total_length = 0;
+        for (const auto& seg : segments_) {
+            for (std::size_t dim = 0; dim < 2; ++dim) {
+                origin_[dim] = std::min(origin_[dim], min_on_dim(seg, dim));
+                extent[dim] = std::max(extent[dim], max_on_dim(seg, dim));
+            }
+            total_length += length(seg[1] - seg[0]);
+        }
+        extent = extent - origin_;
+
+        // no more cells than a few per segment
+        const auto n = static_cast<Scalar>(segments_.size());
+        const auto max_cells = (Scalar)4 * n;
+        cell_size_ = std::max({
+            total_length / n,
+            std::sqrt(extent[0] * extent[1] / max_cells),
+            std::max(extent[0], extent[1]) / max_cells,
+            std::numeric_limits<Scalar>::min()
+        });
+
+        // half a cell of border, so that endpoints on a lattice of the cell size fall inside cells, not on their edges
+        origin_ = origin_ - point_type((Scalar)0.5 * cell_size_, (Scalar)0.5 * cell_size_);
+        n_cols_ = static_cast<std::size_t>(extent[0] / cell_size_) + 2;
+        n_rows_ = static_cast<std::size_t>(extent[1] / cell_size_) + 2;
+
+        // (cell, segment) for every cell a segment may touch, bucketed by cell
+        entries_.clear();
+        for (segment_index i = 0; i < segments_.size(); ++i)
+            cover(i);
+
+        cell_offsets_.assign(n_cols_ * n_rows_ + 1, 0);
+        for (const auto& entry : entries_)
+            ++cell_offsets_[entry.first + 1];
+        for (std::size_t c = 1; c < cell_offsets_.size(); ++c)
+            cell_offsets_[c] += cell_offsets_[c - 1];
+
+        cell_segments_.resize(entries_.size());
+        cursor_.assign(cell_offsets_.begin(), cell_offsets_.end() - 1);
+        for (const auto& entry : entries_)
+            cell_segments_[cursor_[entry.first]++] = entry.second;
+    }
+
+    std::size_t col_of(Scalar x) const {
+        const auto col = std::floor((x - origin_[0]) / cell_size_);
+        return static_cast<std::size_t>(std::clamp(col, (Scalar)0, static_cast<Scalar>(n_cols_ - 1)));
+    }
+
+    std::size_t row_of(Scalar y) const {
+        const auto row = std::floor((y - origin_[1]) / cell_size_);
+        return static_cast<std::size_t>(std::clamp(row, (Scalar)0, static_cast<Scalar>(n_rows_ - 1)));
+    }
+
+    std::size_t cell_of(const point_type& point) const {
+        return row_of(point[1]) * n_cols_ + col_of(point[0]);
+    }
+
+    // adds the cells within a small margin of segment i, column by column
+    void cover(segment_index i) {
+        const auto& seg = segments_[i];
+        const auto margin = cell_size_ * (Scalar)1e-6;
+
+        const auto first_col = col_of(seg[0][0] - margin);
+        const auto last_col = col_of(seg[1][0] + margin);
+        for (auto col = first_col; col <= last_col; ++col) {
+            const auto x_lo = std::max(seg[0][0], origin_[0] + static_cast<Scalar>(col) * cell_size_);
+            const auto x_hi = std::min(seg[1][0], origin_[0] + static_cast<Scalar>(col + 1) * cell_size_);
+
+            auto y_lo = min_on_dim(seg, 1);
+            auto y_hi = max_on_dim(seg, 1);
+            if (seg[0][0] != seg[1][0] && x_lo <= x_hi) {
+                const auto y1 = evaluate_at_x_2D(seg, x_lo);
+                const auto y2 = evaluate_at_x_2D(seg, x_hi);
+                y_lo = std::max(y_lo, std::min(y1, y2));
+                y_hi = std::min(y_hi, std::max(y1, y2));
+            }
+
+            const auto first_row = row_of(y_lo - margin);
+            const auto last_row = row_of(y_hi + margin);
+            for (auto row = first_row; row <= last_row; ++row)
+                entries_.emplace_back(static_cast<std::uint32_t>(row * n_cols_ + col), i);
+        }
+    }
+
+    void test_cells() {
+        for (std::size_t cell = 0; cell + 1 < cell_offsets_.size(); ++cell) {
+            const auto first = cell_offsets_[cell];
+            const auto last = cell_offsets_[cell + 1];
+            for (auto a = first; a < last; ++a) {
+                for (auto b = a + 1; b < last; ++b)
+                    test_pair(cell, cell_segments_[a], cell_segments_[b]);
+            }
+        }
+    }
+
+    void test_pair(std::size_t cell, segment_index lhs, segment_index rhs) {
+        // the same argument order and clamping as segment_sweep_2D, so a pair's point rounds the same way
+        if (rhs < lhs)
+            std::swap(lhs, rhs);
+
+        const auto& seg_lhs = segments_[lhs];
+        const auto& seg_rhs = segments_[rhs];
+        auto[result, success] = intersect_segment_segment_2D(seg_lhs, seg_rhs);
+        if (!success)
+            return;
+
+        auto add = [&](const point_type& point) {
+            if (cell_of(point) == cell) {
+                hits_.push_back({point, lhs});
+                hits_.push_back({point, rhs});
+            }
+        };
+
+        // colinear segments meet at both ends of their overlap
+        if (signed_area_2D(seg_lhs[0], seg_lhs[1], seg_rhs[0]) == (Scalar)0 &&
+            signed_area_2D(seg_lhs[0], seg_lhs[1], seg_rhs[1]) == (Scalar)0) {
+            const auto overlap_first = std::max(seg_lhs[0], seg_rhs[0]);
+            const auto overlap_last = std::min(seg_lhs[1], seg_rhs[1]);
+            add(overlap_first);
+            if (overlap_last != overlap_first)
+                add(overlap_last);
+            return;
+        }
+
+        for (std::size_t dim = 0; dim < 2; ++dim) {
+            result.point[dim] = std::clamp(
+                result.point[dim],
+                std::max(min_on_dim(seg_lhs, dim), min_on_dim(seg_rhs, dim)),
+                std::min(max_on_dim(seg_lhs, dim), max_on_dim(seg_rhs, dim))
+            );
+        }
+        add(result.point);
+    }
+
+    std::vector<segment_type> input_;
+    std::vector<segment_type> segments_;
+
+    point_type origin_;
+    Scalar cell_size_ = 0;
+    std::size_t n_cols_ = 0;
+    std::size_t n_rows_ = 0;
+
+    std::vector<std::pair<std::uint32_t, segment_index>> entries_;
+    std::vector<std::size_t> cell_offsets_;
+    std::vector<std::size_t> cursor_;
+    std::vector<segment_index> cell_segments_;
+
+    std::vector<hit_type> hits_;
+    std::vector<event_type> events_;
+    std::vector<std::size_t> representative_;
+    std::vector<segment_type> report_;
+};
+
+/**
+ * Chooses between segment_grid_2D and segment_sweep_2D for [first, last) from a sample of the segments.
+ *
+ * The sample gives the grid's cell size and occupancy, and so the number of pairs it tests, and the fraction of pairs
+ * that intersect.  The grid handles every intersecting pair, the sweep every point where segments meet, so a few of
+ * the sampled intersections are checked against all the segments to see how many pairs share a point.  The weight of
+ * a sweep step against a grid pair test was measured with the intersect_segments_crossover example: on 20000 segments
+ * with random directions the grid was 3 to 6 times faster at every length up to 64 times the mean spacing, on
+ * horizontal hatch lines it stops paying off between 8 and 16 times the mean spacing, and on crossing axis-aligned
+ * segments with integer endpoints, where dozens of segments meet at each point, the two break even on short segments
+ * and the sweep wins from 4 times the mean spacing on.
+ */
+template <typename ForwardIt>
+bool prefer_grid_2D(const ForwardIt& first, const ForwardIt& last) {
+    using Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type;
+    constexpr std::size_t n_samples = 256;
+    constexpr std::size_t n_probes = 16;
+    constexpr double sweep_step_weight = 16.0;
+
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    if (n < 64)
+        return false;
+
+    std::vector<segment2<Scalar>> sample;
+    const auto stride = std::max<std::size_t>(1, n / n_samples);
+    auto it = first;
+    for (std::size_t i = 0; i < n; i += stride) {
+        sample.emplace_back(min_endpoint(*it), max_endpoint(*it));
+        if (n - i > stride)
+            std::advance(it, stride);
+    }
+
+    auto lo = sample[0][0];
+    auto hi = sample[0][1];
+    double total_length = 0;
+    for (const auto& seg : sample) {
+        for (std::size_t dim = 0; dim < 2; ++dim) {
+            lo[dim] = std::min(lo[dim], min_on_dim(seg, dim));
+            hi[dim] = std::max(hi[dim], max_on_dim(seg, dim));
+        }
+        total_length += static_cast<double>(length(seg[1] - seg[0]));
+    }
+
+    // the cell size segment_grid_2D would pick
+    const auto width = static_cast<double>(hi[0] - lo[0]);
+    const auto height = static_cast<double>(hi[1] - lo[1]);
+    const auto n_real = static_cast<double>(n);
+    const auto cell_size = std::max({
+        total_length / static_cast<double>(sample.size()),
+        std::sqrt(width * height / (4.0 * n_real)),
+        std::max(width, height) / (4.0 * n_real),
+        std::numeric_limits<double>::min()
+    });
+    const auto n_cells = (std::floor(width / cell_size) + 2.0) * (std::floor(height / cell_size) + 2.0);
+
+    double cells_per_segment = 0;
+    std::size_t sample_hits = 0;
+    std::size_t sample_hit_points = 0;
+    std::vector<vec2<Scalar>> probes;
+    for (std::size_t i = 0; i < sample.size(); ++i) {
+        const auto& seg = sample[i];
+        cells_per_segment += 1.0 + static_cast<double>(seg[1][0] - seg[0][0]) / cell_size +
+            static_cast<double>(max_on_dim(seg, 1) - min_on_dim(seg, 1)) / cell_size;
+        for (std::size_t j = i + 1; j < sample.size(); ++j) {
+            if (!overlap_segment_segment_2D(seg, sample[j]))
+                continue;
+            ++sample_hits;
+            // colinear segments meet at both ends of their overlap
+            const bool colinear = signed_area_2D(seg[0], seg[1], sample[j][0]) == (Scalar)0 &&
+                signed_area_2D(seg[0], seg[1], sample[j][1]) == (Scalar)0;
+            sample_hit_points += colinear ? 2 : 1;
+            if (probes.size() < n_probes)
+                probes.push_back(intersect_segment_segment_2D(seg, sample[j]).first.point);
+        }
+    }
+    cells_per_segment /= static_cast<double>(sample.size());
+
+    const auto sample_pairs = static_cast<double>(sample.size() * (sample.size() - 1) / 2);
+    const auto n_pairs = n_real * (n_real - 1.0) / 2.0;
+    const auto pair_hits = n_pairs * static_cast<double>(sample_hits) / sample_pairs;
+    const auto hits = 2.0 * n_pairs * static_cast<double>(sample_hit_points) / sample_pairs;
+
+    // a pair is sampled in proportion to the pairs at its point, so one over those pairs, averaged, is the number of
+    // points per pair.  A rounded point may lie on none of the segments, which counts as a point of two.
+    std::vector<std::size_t> through(probes.size(), 0);
+    for (auto seg_it = first; seg_it != last; ++seg_it) {
+        const auto& seg = *seg_it;
+        for (std::size_t k = 0; k < probes.size(); ++k) {
+            const auto& p = probes[k];
+            through[k] += p[0] >= min_on_dim(seg, 0) && p[0] <= max_on_dim(seg, 0) &&
+                p[1] >= min_on_dim(seg, 1) && p[1] <= max_on_dim(seg, 1) &&
+                signed_area_2D(seg[0], seg[1], p) == (Scalar)0;
+        }
+    }
+    double points_per_pair = 0;
+    for (auto m : through) {
+        const auto m_real = static_cast<double>(std::max<std::size_t>(m, 2));
+        points_per_pair += 2.0 / (m_real * (m_real - 1.0));
+    }
+    const auto points = probes.empty() ? 0.0 : pair_hits * points_per_pair / static_cast<double>(probes.size());
+
+    const auto entries = n_real * cells_per_segment;
+    // every intersecting pair adds two hits for each point where it meets, which are sorted into events
+    const auto grid_cost = entries * entries / (2.0 * n_cells) + hits * std::log2(hits + 1.0);
+    const auto sweep_cost = sweep_step_weight * (n_real + points) * std::log2(n_real);
+    return grid_cost < sweep_cost;
+}
+
+}   // namespace intersection
+
+/**
+ * intersect_segments_2D on a uniform grid, see intersection::segment_grid_2D.
+ */
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+void intersect_segments_grid_2D(const ForwardIt &first, const ForwardIt &last, OutputIt d_first) {
+    intersection::segment_grid_2D<Scalar> grid;
+    grid(first, last, d_first);
+}
+
+/**
+ * intersect_segments_2D on a uniform grid or by sweeping, whichever intersection::prefer_grid_2D picks.
+ */
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+void intersect_segments_auto_2D(const ForwardIt &first, const ForwardIt &last, OutputIt d_first) {
+    if (intersection::prefer_grid_2D(first, last))
+        intersect_segments_grid_2D(first, last, d_first);
+    else
+        intersect_segments_2D(first, last, d_first);
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_INTERSECT_SEGMENTS_GRID_2D_H_
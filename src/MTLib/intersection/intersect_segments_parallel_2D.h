@@ -0,0 +1,249 @@
+#ifndef _MTLIB_INTERSECT_SEGMENTS_PARALLEL_2D_H_
+#define _MTLIB_INTERSECT_SEGMENTS_PARALLEL_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segment_segment_2D.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+#include "MTLib/util/span.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * Splits the plane into x-slabs holding roughly equal numbers of events, the segment endpoints and the crossings.
+ * Both are estimated from an evenly strided sample of n_samples segments, whose endpoints stand for n / n_samples
+ * endpoints and whose crossings for (n / n_samples)^2 crossings of the whole input.
+ *
+ * Returns the increasing x-coordinates between the slabs, at most n_slabs - 1 of them.  Slab s covers
+ * [boundaries[s - 1], boundaries[s]), the first and last slabs are unbounded.
+ */
+template <typename Scalar>
+std::vector<Scalar> slab_boundaries_2D(
+    const std::vector<segment2<Scalar>>& segments, std::size_t n_slabs, std::size_t n_samples = 512
+) {
+    std::vector<Scalar> boundaries;
+    if (n_slabs < 2 || segments.empty())
+        return boundaries;
+
+    // the x-coordinates of the events with their weights
+    struct event_x {
+        Scalar x;
+        double weight;
+        bool endpoint;
+
+        bool operator<(const event_x& rhs) const {
+            return x < rhs.x;
+        }
+    };
+
+    const auto n = segments.size();
+    n_samples = std::min(n_samples, n);
+    const double weight = (double)n / n_samples;
+    std::vector<event_x> xs;
+    for (std::size_t i = 0; i < n_samples; ++i) {
+        const auto& seg = segments[i * n / n_samples];
+        xs.push_back({seg[0][0], weight, true});
+        xs.push_back({seg[1][0], weight, true});
+        for (std::size_t j = 0; j < i; ++j) {
+            const auto[result, success] = intersect_segment_segment_2D(seg, segments[j * n / n_samples]);
+            if (success)
+                xs.push_back({result.point[0], weight * weight, false});
+        }
+    }
+
+    std::sort(xs.begin(), xs.end());
+    double total = 0;
+    for (const auto& x : xs)
+        total += x.weight;
+
+    // boundaries only at endpoints, the sweep line of a slab is seeded in floating point, which is least exact at a
+    // crossing
+    double sum = 0;
+    std::size_t s = 1;
+    for (const auto& x : xs) {
+        sum += x.weight;
+        if (!x.endpoint)
+            continue;
+        for (; s < n_slabs && sum > total * s / n_slabs; ++s)
+            boundaries.push_back(x.x);
+    }
+
+    // quantiles repeat when many events share an x-coordinate
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    if (!boundaries.empty() && boundaries.front() == xs.front().x)
+        boundaries.erase(boundaries.begin());
+
+    return boundaries;
+}
+
+/**
+ * The events of one x-slab, with the segments of each event as positions in the whole input.
+ */
+template <typename Scalar>
+struct slab_events_2D {
+    struct event_type {
+        vec2<Scalar> point;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::vector<segment_index> indices;
+    std::vector<event_type> events;
+};
+
+/**
+ * Sweeps slab s of segments, which have their lexicographically smaller endpoint first.
+ *
+ * The sweep starts at the left boundary of the slab with the segments across it already on the sweep line, see
+ * segment_sweep_2D::start, so the sweep line inside the slab holds exactly the segments the sequential sweep holds
+ * there and no event left of the slab is computed.  The members keep their input order, which keeps the rounding of
+ * every intersection point the same as in the sequential sweep.
+ */
+template <typename Scalar>
+void sweep_slab_2D(
+    const std::vector<segment2<Scalar>>& segments, const std::vector<Scalar>& boundaries, std::size_t s,
+    slab_events_2D<Scalar>& result
+) {
+    auto before_slab = [&](Scalar x) { return s > 0 && x < boundaries[s - 1]; };
+    auto after_slab = [&](Scalar x) { return s < boundaries.size() && x >= boundaries[s]; };
+
+    std::vector<segment_index> members;
+    std::vector<segment2<Scalar>> subset;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        if (!after_slab(segments[i][0][0]) && !before_slab(segments[i][1][0])) {
+            members.push_back(static_cast<segment_index>(i));
+            subset.push_back(segments[i]);
+        }
+    }
+
+    segment_sweep_2D<Scalar> sweep;
+    if (s > 0)
+        sweep.start(subset.begin(), subset.end(), boundaries[s - 1]);
+    else
+        sweep.start(subset.begin(), subset.end());
+    while (sweep.next()) {
+        const auto& point = sweep.point();
+        if (after_slab(point[0]))
+            break;
+
+        result.events.push_back({point, result.indices.size(), sweep.indices().size()});
+        for (auto i : sweep.indices())
+            result.indices.push_back(members[i]);
+    }
+}
+
+/**
+ * Sweeps segments in x-slabs on up to n_threads threads and calls visit(point, span<const segment_index>) for every
+ * point where two or more segments meet, in the order of the sequential sweep.
+ *
+ * segments must have their lexicographically smaller endpoint first.
+ */
+template <typename Scalar, typename Visitor>
+void parallel_sweep_2D(const std::vector<segment2<Scalar>>& segments, std::size_t n_threads, Visitor visit) {
+    assert(segments.size() <= std::numeric_limits<segment_index>::max());
+
+    const auto boundaries = slab_boundaries_2D(segments, std::max<std::size_t>(1, n_threads));
+    const auto n_slabs = boundaries.size() + 1;
+
+    std::vector<slab_events_2D<Scalar>> slabs(n_slabs);
+    auto sweep_slab = [&](std::size_t s) {
+        sweep_slab_2D(segments, boundaries, s, slabs[s]);
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t s = 1; s < n_slabs; ++s)
+        threads.emplace_back(sweep_slab, s);
+    sweep_slab(0);
+    for (auto& t : threads)
+        t.join();
+
+    // the slabs are ordered by x and each event belongs to exactly one of them
+    for (const auto& slab : slabs) {
+        for (const auto& event : slab.events)
+            visit(event.point, span<const segment_index>(slab.indices.data() + event.offset, event.size));
+    }
+}
+
+}   // namespace intersection
+
+/**
+ * Parallel intersect_segments_2D.  The plane is split into x-slabs of roughly equal event counts that are swept on
+ * up to n_threads threads, segments crossing a slab boundary are swept in every slab they overlap.
+ *
+ * The events reported, their order, and their points are the same as those of the sequential sweep.  The one
+ * exception is rounding: where three or more segments meet at a point that is not representable, the sequential
+ * sweep's grouping of them depends on the order in which it met them, and a slab may group them differently.  The
+ * same holds for segments that meet within rounding of a slab boundary, whose order there is taken in floating
+ * point.
+ */
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+void intersect_segments_parallel_2D(
+    const ForwardIt &first, const ForwardIt &last, OutputIt d_first,
+    std::size_t n_threads = std::thread::hardware_concurrency()
+) {
+    const std::vector<segment2<Scalar>> input(first, last);
+    std::vector<segment2<Scalar>> segments;
+    segments.reserve(input.size());
+    for (const auto& seg : input)
+        segments.emplace_back(min_endpoint(seg), max_endpoint(seg));
+
+    std::vector<segment2<Scalar>> report;
+    intersection::parallel_sweep_2D(segments, n_threads,
+        [&](const vec2<Scalar>& point, span<const intersection::segment_index> through) {
+            report.clear();
+            for (auto i : through)
+                report.push_back(input[i]);
+            std::sort(report.begin(), report.end());
+            *d_first++ = std::pair<vec2<Scalar>, const std::vector<segment2<Scalar>>&>(point, report);
+        }
+    );
+}
+
+/**
+ * Parallel intersect_segments_2D reporting std::pair<vec2<Scalar>, span<const uint32_t>> of the positions in
+ * [first, last) of the segments through each point.  The spans view the indices appended to indices.
+ */
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+void intersect_segments_parallel_2D(
+    const ForwardIt &first, const ForwardIt &last, std::vector<intersection::segment_index>& indices,
+    OutputIt d_first, std::size_t n_threads = std::thread::hardware_concurrency()
+) {
+    std::vector<segment2<Scalar>> segments;
+    for (auto it = first; it != last; ++it)
+        segments.emplace_back(min_endpoint(*it), max_endpoint(*it));
+
+    std::vector<std::pair<vec2<Scalar>, std::size_t>> events;
+    const auto offset = indices.size();
+    intersection::parallel_sweep_2D(segments, n_threads,
+        [&](const vec2<Scalar>& point, span<const intersection::segment_index> through) {
+            events.emplace_back(point, through.size());
+            indices.insert(indices.end(), through.begin(), through.end());
+        }
+    );
+
+    auto data = indices.data() + offset;
+    for (const auto& [point, size] : events) {
+        *d_first++ = std::make_pair(point, span<const intersection::segment_index>(data, size));
+        data += size;
+    }
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_INTERSECT_SEGMENTS_PARALLEL_2D_H_
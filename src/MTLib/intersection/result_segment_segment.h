@@ -5,10 +5,17 @@
 #include "MTLib/geometry/segment.h"
 
 #include <cstddef> // size_t
+#include <type_traits>
 
 namespace mtlib {
 namespace intersection {
 
+/**
+ * The type of the parameters along the segments, double for integer coordinates.
+ */
+template <typename Scalar>
+using parameter_scalar_t = typename std::conditional<std::is_integral<Scalar>::value, double, Scalar>::type;
+
 template <std::size_t N, typename Scalar>
 struct result_segment_segment {
     constexpr result_segment_segment() = default;
@@ -20,8 +27,8 @@ struct result_segment_segment {
     vec<N, Scalar> point;
     segment<N, Scalar> segment1;
     segment<N, Scalar> segment2;
-    Scalar t1;
-    Scalar t2;
+    parameter_scalar_t<Scalar> t1;
+    parameter_scalar_t<Scalar> t2;
 };
 
 }   // namespace intersection
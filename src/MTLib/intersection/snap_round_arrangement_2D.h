@@ -0,0 +1,287 @@
+#ifndef _MTLIB_SNAP_ROUND_ARRANGEMENT_2D_H_
+#define _MTLIB_SNAP_ROUND_ARRANGEMENT_2D_H_
+
+#include "MTLib/algebra/linalg.h"
+#include "MTLib/algebra/predicates.h"
+#include "MTLib/algebra/vec.h"
+#include "MTLib/ds/dcel.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+#include "MTLib/util/span.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t, uint32_t
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+
+/**
+ * A planar arrangement as a DCEL with the position of every vertex.  points[i] is the position of the vertex
+ * vertices[i], the vertices are listed in the order they were created.
+ */
+template <typename Scalar, typename Traits = ds::dcel_list_Traits>
+struct arrangement_2D {
+    ds::dcel<Traits> dcel;
+    std::vector<typename Traits::vertex_handle> vertices;
+    std::vector<vec2<Scalar>> points;
+};
+
+namespace intersection {
+
+/**
+ * The pixel of a snap rounding grid holding a point, pixel (i, j) is the square of side pixel_size around the grid
+ * point (i, j) * pixel_size.
+ */
+template <typename Scalar>
+vec2<std::int64_t> snap_pixel_2D(const vec2<Scalar>& point, Scalar pixel_size) {
+    return vec2<std::int64_t>(std::llround(point[0] / pixel_size), std::llround(point[1] / pixel_size));
+}
+
+/**
+ * Parameter along seg at which it enters the closed square of half side half around center, seg must touch it.
+ */
+template <typename Scalar>
+Scalar snap_entry_2D(const segment2<Scalar>& seg, const vec2<Scalar>& center, Scalar half) {
+    Scalar t = 0;
+    for (std::size_t i = 0; i < 2; ++i) {
+        const Scalar d = seg[1][i] - seg[0][i];
+        if (d == (Scalar)0)
+            continue;
+        const Scalar ta = (center[i] - half - seg[0][i]) / d;
+        const Scalar tb = (center[i] + half - seg[0][i]) / d;
+        t = std::max(t, std::min(ta, tb));
+    }
+    return std::min(t, (Scalar)1);
+}
+
+/**
+ * Orders directions on the integer grid counter-clockwise, starting from the positive x axis.  Exact.
+ */
+struct snap_direction_less_2D {
+    static bool upper(const vec2<std::int64_t>& d) {
+        return d[1] > 0 || (d[1] == 0 && d[0] > 0);
+    }
+
+    bool operator()(const vec2<std::int64_t>& lhs, const vec2<std::int64_t>& rhs) const {
+        const bool lhs_upper = upper(lhs);
+        if (lhs_upper != upper(rhs))
+            return lhs_upper;
+        return plain_predicates::turn_2D(vec2<std::int64_t>(0, 0), lhs, vec2<std::int64_t>(0, 0), rhs) > 0;
+    }
+};
+
+}   // namespace intersection
+
+/**
+ * The arrangement of the segments in [first, last) after snap rounding to a grid of spacing pixel_size.
+ *
+ * Every pixel of the grid that holds an endpoint or an intersection point is hot, and every segment is replaced by
+ * the path through the centres of the hot pixels it passes through, in the order it enters them.  By Hobby's theorem
+ * the paths only meet at hot pixel centres, so their edges, without duplicates, form a planar graph whose vertices
+ * are grid points.  The hot pixels are found with two sweeps of segment_sweep_2D, one over the segments for the
+ * intersection points and one over the segments together with the diagonals of the hot pixels for the pixels every
+ * segment passes through, so the builder runs in O((n + k) log n) for k the size of the output and holds O(n + k)
+ * memory.  A segment passes through a hot pixel when it meets one of the pixel's closed diagonals or snaps an
+ * endpoint into it.  So a segment that touches the pixel only at a corner, or runs along one of its sides, passes
+ * through it, and one that stops on a side from outside does not.
+ *
+ * In the DCEL every edge is a pair of twin half-edges, next and prev follow the boundary of the face to the left of a
+ * half-edge counter-clockwise, and every vertex's incident half-edge leaves it.  Every boundary cycle is a face, since
+ * the DCEL has no holes the outer boundary of each connected component is a face of its own, with a clockwise
+ * boundary.  Hot pixels no edge passes through do not become vertices.
+ *
+ * The grid coordinates of the vertices must fit in an int64_t with room for their differences, and the Predicates
+ * decide where the segments meet the pixel boundaries.
+ */
+template<
+        typename Traits = ds::dcel_list_Traits, typename ForwardIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type,
+        typename Predicates = adaptive_predicates
+>
+arrangement_2D<Scalar, Traits> snap_round_arrangement_2D(
+    const ForwardIt& first, const ForwardIt& last,
+    typename std::iterator_traits<ForwardIt>::value_type::scalar_type pixel_size, Predicates = Predicates()
+) {
+    using namespace intersection;
+    using pixel_type = vec2<std::int64_t>;
+    static_assert(std::is_floating_point<Scalar>::value, "the segments are snapped to a grid of Scalars");
+    assert(pixel_size > (Scalar)0);
+
+    std::vector<segment2<Scalar>> segments(first, last);
+    const auto n = static_cast<segment_index>(segments.size());
+    const Scalar half = pixel_size / 2;
+    auto center_of = [&](const pixel_type& pixel) {
+        return vec2<Scalar>((Scalar)pixel[0] * pixel_size, (Scalar)pixel[1] * pixel_size);
+    };
+
+    // (segment, pixel) for every hot pixel a segment touches, starting with those of its endpoints
+    std::vector<std::pair<segment_index, pixel_type>> touches;
+    std::vector<pixel_type> hot;
+    for (segment_index i = 0; i < n; ++i) {
+        for (const auto& end : segments[i]) {
+            hot.push_back(snap_pixel_2D(end, pixel_size));
+            touches.emplace_back(i, hot.back());
+        }
+    }
+
+    // and those of the points where it meets other segments
+    segment_sweep_2D<Scalar, Predicates> sweep;
+    sweep.visit(segments.begin(), segments.end(), [&](const vec2<Scalar>& point, span<const segment_index> through) {
+        hot.push_back(snap_pixel_2D(point, pixel_size));
+        for (auto i : through)
+            touches.emplace_back(i, hot.back());
+    });
+    std::sort(hot.begin(), hot.end());
+    hot.erase(std::unique(hot.begin(), hot.end()), hot.end());
+
+    // a segment that enters the open square of a pixel either crosses one of its diagonals or ends inside it, one that
+    // meets the closed square at a corner meets a diagonal at its end
+    for (const auto& pixel : hot) {
+        const auto center = center_of(pixel);
+        segments.emplace_back(center - vec2<Scalar>(half, half), center + vec2<Scalar>(half, half));
+        segments.emplace_back(center - vec2<Scalar>(half, -half), center + vec2<Scalar>(half, -half));
+    }
+    sweep.visit(segments.begin(), segments.end(), [&](const vec2<Scalar>&, span<const segment_index> through) {
+        if (through[0] >= n)
+            return;
+        const auto first_diagonal = std::lower_bound(through.begin(), through.end(), n);
+        for (auto it = first_diagonal; it != through.end(); ++it) {
+            for (auto jt = through.begin(); jt != first_diagonal; ++jt)
+                touches.emplace_back(*jt, hot[(*it - n) / 2]);
+        }
+    });
+    segments.resize(n);
+
+    // every segment's path through its hot pixels, in the order it enters them
+    struct stop_type {
+        segment_index segment;
+        Scalar entry;
+        Scalar along;
+        std::uint32_t pixel;
+    };
+    std::vector<stop_type> stops;
+    stops.reserve(touches.size());
+    for (const auto& [i, pixel] : touches) {
+        const auto& seg = segments[i];
+        const auto center = center_of(pixel);
+        const Scalar along = (center[0] - seg[0][0]) * (seg[1][0] - seg[0][0]) +
+            (center[1] - seg[0][1]) * (seg[1][1] - seg[0][1]);
+        const auto id = std::lower_bound(hot.begin(), hot.end(), pixel) - hot.begin();
+        stops.push_back({i, snap_entry_2D(seg, center, half), along, static_cast<std::uint32_t>(id)});
+    }
+    std::vector<std::pair<segment_index, pixel_type>>().swap(touches);
+    std::sort(stops.begin(), stops.end(), [](const stop_type& lhs, const stop_type& rhs) {
+        if (lhs.segment != rhs.segment)
+            return lhs.segment < rhs.segment;
+        if (lhs.entry != rhs.entry)
+            return lhs.entry < rhs.entry;
+        return lhs.along < rhs.along;
+    });
+
+    // the edges of the paths, as pairs of hot pixels without duplicates
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> links;
+    for (std::size_t s = 1; s < stops.size(); ++s) {
+        const auto& prev = stops[s - 1];
+        const auto& stop = stops[s];
+        if (prev.segment == stop.segment && prev.pixel != stop.pixel)
+            links.emplace_back(std::min(prev.pixel, stop.pixel), std::max(prev.pixel, stop.pixel));
+    }
+    std::vector<stop_type>().swap(stops);
+    std::sort(links.begin(), links.end());
+    links.erase(std::unique(links.begin(), links.end()), links.end());
+
+    // the hot pixels on an edge become the vertices
+    arrangement_2D<Scalar, Traits> result;
+    auto& dcel = result.dcel;
+    constexpr auto unused = ~std::uint32_t(0);
+    std::vector<std::uint32_t> vertex_of(hot.size(), unused);
+    for (const auto& link : links)
+        vertex_of[link.first] = vertex_of[link.second] = 0;
+    dcel.reserve(std::count(vertex_of.begin(), vertex_of.end(), 0), 2 * links.size(), links.size());
+    for (std::size_t p = 0; p < hot.size(); ++p) {
+        if (vertex_of[p] == unused)
+            continue;
+        vertex_of[p] = static_cast<std::uint32_t>(result.vertices.size());
+        result.vertices.push_back(dcel.create_vertex());
+        result.points.push_back(center_of(hot[p]));
+    }
+
+    // half-edges 2e and 2e + 1 are the two sides of edge e, grouped by origin in counter-clockwise order
+    const auto n_vertices = result.vertices.size();
+    std::vector<typename Traits::half_edge_handle> half_edges(2 * links.size());
+    std::vector<std::uint32_t> origin(half_edges.size());
+    std::vector<std::uint32_t> offsets(n_vertices + 1, 0);
+    for (std::size_t e = 0; e < links.size(); ++e) {
+        origin[2 * e] = vertex_of[links[e].first];
+        origin[2 * e + 1] = vertex_of[links[e].second];
+        ++offsets[origin[2 * e] + 1];
+        ++offsets[origin[2 * e + 1] + 1];
+    }
+    for (std::size_t v = 0; v < n_vertices; ++v)
+        offsets[v + 1] += offsets[v];
+
+    std::vector<std::uint32_t> around(half_edges.size());
+    std::vector<std::uint32_t> position(half_edges.size());
+    {
+        std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::uint32_t h = 0; h < half_edges.size(); ++h)
+            around[fill[origin[h]]++] = h;
+    }
+    auto direction = [&](std::uint32_t h) {
+        const auto& link = links[h / 2];
+        const auto& from = hot[h % 2 == 0 ? link.first : link.second];
+        const auto& to = hot[h % 2 == 0 ? link.second : link.first];
+        return pixel_type(to[0] - from[0], to[1] - from[1]);
+    };
+    for (std::size_t v = 0; v < n_vertices; ++v) {
+        std::sort(around.begin() + offsets[v], around.begin() + offsets[v + 1], [&](std::uint32_t l, std::uint32_t r) {
+            return snap_direction_less_2D()(direction(l), direction(r));
+        });
+    }
+    for (std::uint32_t k = 0; k < around.size(); ++k)
+        position[around[k]] = k;
+
+    for (auto& h : half_edges)
+        h = dcel.create_half_edge();
+    for (std::uint32_t h = 0; h < half_edges.size(); ++h) {
+        auto& he = dcel[half_edges[h]];
+        he.origin = result.vertices[origin[h]];
+        he.twin = half_edges[h ^ 1];
+        auto& vertex = dcel[he.origin];
+        if (vertex.incident == dcel.null_half_edge)
+            vertex.incident = half_edges[h];
+
+        // the face on the left continues along the half-edge clockwise from the twin around the vertex it reaches
+        const auto twin = h ^ 1;
+        const auto v = origin[twin];
+        const auto k = position[twin];
+        const auto next = around[k == offsets[v] ? offsets[v + 1] - 1 : k - 1];
+        he.next = half_edges[next];
+        dcel[half_edges[next]].prev = half_edges[h];
+    }
+
+    // every cycle of next is the boundary of a face
+    for (const auto& he : half_edges) {
+        if (dcel[he].face != dcel.null_face)
+            continue;
+        const auto face = dcel.create_face();
+        dcel[face].incident = he;
+        auto it = he;
+        do {
+            dcel[it].face = face;
+            it = dcel[it].next;
+        } while (it != he);
+    }
+
+    return result;
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_SNAP_ROUND_ARRANGEMENT_2D_H_
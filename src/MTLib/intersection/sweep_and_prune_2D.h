@@ -0,0 +1,160 @@
+#ifndef _MTLIB_SWEEP_AND_PRUNE_2D_H_
+#define _MTLIB_SWEEP_AND_PRUNE_2D_H_
+
+#include "MTLib/algebra/vec.h"
+#include "MTLib/geometry/aabb.h"
+#include "MTLib/geometry/segment.h"
+#include "MTLib/intersection/intersect_segments_2D.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+namespace intersection {
+
+/**
+ * Sweep-and-prune broad phase over a set of 2D bounding boxes.
+ *
+ * The boxes are kept sorted by their lower bound on the axis along which their centres vary most, and overlapping
+ * pairs are found by scanning forward from each box until the lower bounds pass its upper bound.  The input may be
+ * segments, which are boxed with min_on_dim / max_on_dim, or boxes, e.g. the bounding_box of each polygon.
+ *
+ * For objects that move a little between frames, update() keeps the previous order and repairs it with insertion
+ * sort, which is close to linear when few boxes change places.
+ */
+template <typename Scalar>
+class sweep_and_prune_2D {
+public:
+    using box_type = aabb2<Scalar>;
+    using pair_type = std::pair<segment_index, segment_index>;
+
+    /**
+     * Boxes [first, last), picks the sweep axis and sorts the boxes along it.
+     */
+    template <typename ForwardIt>
+    void build(ForwardIt first, ForwardIt last) {
+        boxes_.clear();
+        for (auto it = first; it != last; ++it)
+            boxes_.push_back(bounding_box(*it));
+        assert(boxes_.size() <= std::numeric_limits<segment_index>::max());
+
+        axis_ = select_axis();
+        entries_.resize(boxes_.size());
+        for (std::size_t i = 0; i < boxes_.size(); ++i)
+            entries_[i] = make_entry(static_cast<segment_index>(i));
+        std::sort(entries_.begin(), entries_.end(), [](const entry_type& lhs, const entry_type& rhs) {
+            return lhs.lower < rhs.lower;
+        });
+    }
+
+    /**
+     * Replaces the boxes with those of [first, last), which must hold as many objects as the last build().
+     *
+     * The sweep axis is kept and the previous order is repaired with insertion sort.  Returns the number of places
+     * boxes moved, call build() instead when that grows towards n log n.
+     */
+    template <typename ForwardIt>
+    std::size_t update(ForwardIt first, ForwardIt last) {
+        std::size_t i = 0;
+        for (auto it = first; it != last; ++it, ++i)
+            boxes_[i] = bounding_box(*it);
+        assert(i == boxes_.size());
+
+        for (auto& entry : entries_)
+            entry = make_entry(entry.index);
+
+        std::size_t moves = 0;
+        for (std::size_t j = 1; j < entries_.size(); ++j) {
+            const auto entry = entries_[j];
+            auto k = j;
+            for (; k > 0 && entry.lower < entries_[k - 1].lower; --k)
+                entries_[k] = entries_[k - 1];
+            entries_[k] = entry;
+            moves += j - k;
+        }
+        return moves;
+    }
+
+    /**
+     * Writes a pair_type (i, j) with i < j for every two boxes that overlap, touching boxes included.
+     */
+    template <typename OutputIt>
+    OutputIt pairs(OutputIt d_first) const {
+        for (std::size_t j = 0; j < entries_.size(); ++j) {
+            const auto& lhs = entries_[j];
+            for (std::size_t k = j + 1; k < entries_.size() && entries_[k].lower <= lhs.upper; ++k) {
+                const auto& rhs = entries_[k];
+                if (rhs.other_upper < lhs.other_lower || lhs.other_upper < rhs.other_lower)
+                    continue;
+                *d_first++ = std::minmax(lhs.index, rhs.index);
+            }
+        }
+        return d_first;
+    }
+
+    std::size_t axis() const { return axis_; }
+    std::size_t size() const { return boxes_.size(); }
+    const std::vector<box_type>& boxes() const { return boxes_; }
+
+private:
+    // both axes are copied into the sorted entries, so the pair scan never leaves them
+    struct entry_type {
+        Scalar lower;
+        Scalar upper;
+        Scalar other_lower;
+        Scalar other_upper;
+        segment_index index;
+    };
+
+    entry_type make_entry(segment_index i) const {
+        const auto& box = boxes_[i];
+        return {box.lower[axis_], box.upper[axis_], box.lower[1 - axis_], box.upper[1 - axis_], i};
+    }
+
+    std::size_t select_axis() const {
+        if (boxes_.empty())
+            return 0;
+
+        vec2<Scalar> mean((Scalar)0, (Scalar)0);
+        for (const auto& box : boxes_)
+            mean = mean + (box.lower + box.upper);
+        mean = mean / (Scalar)(2 * boxes_.size());
+
+        vec2<Scalar> variance((Scalar)0, (Scalar)0);
+        for (const auto& box : boxes_) {
+            const auto d = (box.lower + box.upper) / (Scalar)2 - mean;
+            variance[0] += d[0] * d[0];
+            variance[1] += d[1] * d[1];
+        }
+        return variance[1] > variance[0] ? 1 : 0;
+    }
+
+    std::vector<box_type> boxes_;
+    std::vector<entry_type> entries_;
+    std::size_t axis_ = 0;
+};
+
+}   // namespace intersection
+
+/**
+ * Writes std::pair<uint32_t, uint32_t> (i, j), i < j, of the positions in [first, last) of every two objects whose
+ * bounding boxes overlap.  The objects may be segments or boxes.
+ */
+template<
+        typename ForwardIt, typename OutputIt,
+        typename Scalar = typename std::iterator_traits<ForwardIt>::value_type::scalar_type
+>
+OutputIt overlapping_boxes_2D(const ForwardIt &first, const ForwardIt &last, OutputIt d_first) {
+    intersection::sweep_and_prune_2D<Scalar> sap;
+    sap.build(first, last);
+    return sap.pairs(d_first);
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_SWEEP_AND_PRUNE_2D_H_
@@ -3,20 +3,42 @@
 
 #include "algebra/common.h"
 #include "algebra/linalg.h"
+#include "algebra/predicates.h"
 #include "algebra/vec.h"
 
 #include "comp_geo/convex_hull_2d.h"
+#include "comp_geo/convex_hull_parallel_2d.h"
+#include "comp_geo/convex_hull_quickhull_2d.h"
+#include "comp_geo/incremental_hull_2d.h"
 #include "comp_geo/is_convex_2d.h"
+#include "comp_geo/is_simple_polygon_2d.h"
 #include "comp_geo/overlap_convex_point_2d.h"
 
 #include "ds/dcel.h"
+#include "ds/dcel_from_polygons.h"
+#include "ds/frozen_dcel.h"
+#include "ds/slot_vector.h"
 
+#include "geometry/aabb.h"
 #include "geometry/segment.h"
 
+#include "intersection/any_intersection_2D.h"
+#include "intersection/dynamic_segments_2D.h"
+#include "intersection/intersect_segment_pairs_2D.h"
 #include "intersection/intersect_segment_segment_2D.h"
 #include "intersection/intersect_segment_vec_2D.h"
 #include "intersection/intersect_segments_2D.h"
+#include "intersection/intersect_segments_external_2D.h"
+#include "intersection/intersect_segments_grid_2D.h"
+#include "intersection/intersect_segments_parallel_2D.h"
+#include "intersection/snap_round_arrangement_2D.h"
+#include "intersection/sweep_and_prune_2D.h"
 
+#include "util/external_sort.h"
+#include "util/mapped_file.h"
+#include "util/parallel_sort.h"
+#include "util/pool_allocator.h"
+#include "util/span.h"
 #include "util/svg.h"
 
 #endif // _MTLIB_H_
\ No newline at end of file
@@ -0,0 +1,159 @@
+#ifndef _MTLIB_EXTERNAL_SORT_H_
+#define _MTLIB_EXTERNAL_SORT_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <cstdio>
+#include <functional>   // less
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+namespace mtlib {
+
+/**
+ * External merge sort of trivially copyable records in a bounded amount of memory.
+ *
+ * push() collects records into a buffer of memory_budget bytes and writes every full buffer out, sorted, as a run
+ * in a temporary file.  After finish() the records are read back in order with front() / pop() by merging the runs,
+ * each through its own share of memory_budget.  Functions that touch the files return false on an I/O error.
+ */
+template <typename T, typename Compare = std::less<T>>
+class external_sorter {
+    static_assert(std::is_trivially_copyable<T>::value, "records are written to disk as bytes");
+
+public:
+    explicit external_sorter(std::size_t memory_budget, Compare comp = Compare())
+        : budget_(std::max<std::size_t>(memory_budget / sizeof(T), 2)), comp_(comp),
+          heap_(run_greater{&runs_, comp})
+    {}
+
+    external_sorter(const external_sorter&) = delete;
+    external_sorter& operator=(const external_sorter&) = delete;
+
+    ~external_sorter() {
+        for (auto& run : runs_)
+            std::fclose(run.file);
+    }
+
+    bool push(const T& record) {
+        assert(!finished_);
+        if (buffer_.empty())
+            buffer_.reserve(budget_);
+        buffer_.push_back(record);
+        return buffer_.size() < budget_ || spill();
+    }
+
+    /**
+     * Writes the last run and starts the merge.
+     */
+    bool finish() {
+        assert(!finished_);
+        finished_ = true;
+
+        // everything fit in memory, no files needed
+        if (runs_.empty()) {
+            std::sort(buffer_.begin(), buffer_.end(), comp_);
+            in_memory_ = true;
+            return true;
+        }
+
+        if (!buffer_.empty() && !spill())
+            return false;
+        std::vector<T>().swap(buffer_);
+
+        const auto share = std::max<std::size_t>(budget_ / runs_.size(), 1);
+        for (std::size_t r = 0; r < runs_.size(); ++r) {
+            std::rewind(runs_[r].file);
+            runs_[r].buffer.resize(share);
+            if (!refill(runs_[r]))
+                return false;
+            if (runs_[r].pos < runs_[r].end)
+                heap_.push(r);
+        }
+        return true;
+    }
+
+    bool empty() const {
+        return in_memory_ ? next_ == buffer_.size() : heap_.empty();
+    }
+
+    const T& front() const {
+        assert(!empty());
+        if (in_memory_)
+            return buffer_[next_];
+        const auto& run = runs_[heap_.top()];
+        return run.buffer[run.pos];
+    }
+
+    bool pop() {
+        assert(!empty());
+        if (in_memory_) {
+            ++next_;
+            return true;
+        }
+
+        const auto r = heap_.top();
+        heap_.pop();
+        auto& run = runs_[r];
+        if (++run.pos == run.end && !refill(run))
+            return false;
+        if (run.pos < run.end)
+            heap_.push(r);
+        return true;
+    }
+
+    std::size_t n_runs() const { return runs_.size(); }
+
+private:
+    struct run_type {
+        std::FILE* file;
+        std::vector<T> buffer;
+        std::size_t pos;
+        std::size_t end;
+    };
+
+    // orders run indices by their front record, smallest on top of the heap
+    struct run_greater {
+        const std::vector<run_type>* runs;
+        Compare comp;
+
+        bool operator()(std::size_t lhs, std::size_t rhs) const {
+            const auto& l = (*runs)[lhs];
+            const auto& r = (*runs)[rhs];
+            return comp(r.buffer[r.pos], l.buffer[l.pos]);
+        }
+    };
+
+    bool spill() {
+        std::sort(buffer_.begin(), buffer_.end(), comp_);
+        std::FILE* file = std::tmpfile();
+        if (file == nullptr)
+            return false;
+        runs_.push_back({file, {}, 0, 0});
+        const bool written = std::fwrite(buffer_.data(), sizeof(T), buffer_.size(), file) == buffer_.size();
+        buffer_.clear();
+        return written;
+    }
+
+    bool refill(run_type& run) {
+        run.pos = 0;
+        run.end = std::fread(run.buffer.data(), sizeof(T), run.buffer.size(), run.file);
+        return run.end > 0 || !std::ferror(run.file);
+    }
+
+    std::size_t budget_;
+    Compare comp_;
+    std::vector<T> buffer_;
+    std::vector<run_type> runs_;
+    std::priority_queue<std::size_t, std::vector<std::size_t>, run_greater> heap_;
+
+    bool finished_ = false;
+    bool in_memory_ = false;
+    std::size_t next_ = 0;
+};
+
+}   // namespace mtlib
+
+#endif // _MTLIB_EXTERNAL_SORT_H_
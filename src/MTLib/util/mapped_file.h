@@ -0,0 +1,117 @@
+#ifndef _MTLIB_MAPPED_FILE_H_
+#define _MTLIB_MAPPED_FILE_H_
+
+#include <algorithm>
+#include <cstddef>  // size_t
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mtlib {
+
+/**
+ * Read-only memory mapping of a whole file.  POSIX only.
+ *
+ * The pages are read in on first access and stay resident until release() hands back a range that will not be read
+ * again, which keeps the resident set of a single pass over a large file small.
+ */
+class mapped_file {
+public:
+    mapped_file() = default;
+
+    explicit mapped_file(const std::string& path) {
+        open(path);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& rhs) noexcept
+        : data_(std::exchange(rhs.data_, nullptr)), size_(std::exchange(rhs.size_, 0)),
+          open_(std::exchange(rhs.open_, false))
+    {}
+
+    mapped_file& operator=(mapped_file&& rhs) noexcept {
+        if (this != &rhs) {
+            close();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+            open_ = std::exchange(rhs.open_, false);
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        close();
+    }
+
+    /**
+     * Maps the file at path, returns false if it cannot be opened or mapped.  An empty file maps to no data.
+     */
+    bool open(const std::string& path) {
+        close();
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            data_ = static_cast<const char*>(data);
+            ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+        }
+
+        // the mapping keeps the file alive
+        ::close(fd);
+        open_ = true;
+        return true;
+    }
+
+    void close() {
+        if (data_ != nullptr)
+            ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    /**
+     * Drops the pages wholly inside [offset, offset + size) from memory, they are read again if accessed.
+     */
+    void release(std::size_t offset, std::size_t size) {
+        const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const auto first = (offset + page - 1) / page * page;
+        const auto last = std::min(offset + size, size_) / page * page;
+        if (data_ != nullptr && first < last)
+            ::madvise(const_cast<char*>(data_) + first, last - first, MADV_DONTNEED);
+    }
+
+    bool is_open() const { return open_; }
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_ = false;
+};
+
+}   // namespace mtlib
+
+#endif // _MTLIB_MAPPED_FILE_H_
@@ -0,0 +1,114 @@
+#ifndef _MTLIB_PARALLEL_SORT_H_
+#define _MTLIB_PARALLEL_SORT_H_
+
+#include <algorithm>
+#include <cstddef>  // size_t
+#include <functional>   // less
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mtlib {
+
+/**
+ * Sorts [first, last) with n_threads threads: every thread sorts a run of its own, then the runs are merged pairwise
+ * through a buffer of the same size.  Every merge is split at a quantile of its left run, and the matching position of
+ * its right run, into parts that are merged by separate threads, so the last merges use all threads too.
+ *
+ * Not stable.  Small inputs are sorted with std::sort.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(
+    RandomIt first, RandomIt last, Compare comp = Compare(),
+    std::size_t n_threads = std::thread::hardware_concurrency()
+) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    n_threads = std::max<std::size_t>(1, std::min(n_threads, n >> 14));
+    if (n_threads == 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // calls work(i) for i in [0, n_work), on one thread each
+    const auto run = [](std::size_t n_work, auto work) {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < n_work; ++i)
+            threads.emplace_back(work, i);
+        work(0);
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    std::vector<std::size_t> runs(n_threads + 1);
+    for (std::size_t t = 0; t <= n_threads; ++t)
+        runs[t] = n * t / n_threads;
+    run(n_threads, [&](std::size_t t) {
+        std::sort(first + runs[t], first + runs[t + 1], comp);
+    });
+
+    // a part of a merge: [a, a_end) and [b, b_end) of the source go to to of the destination
+    struct part {
+        std::size_t a, a_end, b, b_end, to;
+    };
+
+    std::vector<value_type> buffer(n);
+    bool in_buffer = false;
+    const auto merge_round = [&](auto source, auto destination) {
+        std::vector<std::size_t> merged(1, 0);
+        std::vector<part> parts;
+        for (std::size_t r = 0; r + 1 < runs.size(); r += 2) {
+            const auto a = runs[r];
+            const auto b = runs[r + 1];
+            const auto b_end = r + 2 < runs.size() ? runs[r + 2] : b;
+            merged.push_back(b_end);
+
+            // as many parts as the merge's share of the threads, cut where the left run reaches its quantiles
+            const auto n_parts = std::max<std::size_t>(1, n_threads * (b_end - a) / n);
+            auto a_split = a;
+            auto b_split = b;
+            for (std::size_t p = 1; p <= n_parts; ++p) {
+                const auto a_next = p == n_parts ? b : a + (b - a) * p / n_parts;
+                auto b_next = b_end;
+                if (p < n_parts)
+                    b_next = static_cast<std::size_t>(
+                        std::lower_bound(source + b_split, source + b_end, source[a_next], comp) - source
+                    );
+                parts.push_back({a_split, a_next, b_split, b_next, a_split + b_split - b});
+                a_split = a_next;
+                b_split = b_next;
+            }
+        }
+        run(parts.size(), [&](std::size_t p) {
+            const auto& s = parts[p];
+            std::merge(
+                std::make_move_iterator(source + s.a), std::make_move_iterator(source + s.a_end),
+                std::make_move_iterator(source + s.b), std::make_move_iterator(source + s.b_end),
+                destination + s.to, comp
+            );
+        });
+        runs = std::move(merged);
+    };
+
+    while (runs.size() > 2) {
+        if (in_buffer)
+            merge_round(buffer.begin(), first);
+        else
+            merge_round(first, buffer.begin());
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer) {
+        run(n_threads, [&](std::size_t t) {
+            const auto begin = n * t / n_threads;
+            const auto end = n * (t + 1) / n_threads;
+            std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+        });
+    }
+}
+
+}   // namespace mtlib
+
+#endif // _MTLIB_PARALLEL_SORT_H_
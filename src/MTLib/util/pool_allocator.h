@@ -0,0 +1,134 @@
+#ifndef _MTLIB_POOL_ALLOCATOR_H_
+#define _MTLIB_POOL_ALLOCATOR_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>  // size_t, max_align_t
+#include <memory>   // unique_ptr
+#include <new>
+#include <vector>
+
+namespace mtlib {
+
+/**
+ * Hands out small nodes carved from large blocks and keeps freed nodes on per size free lists.
+ *
+ * Blocks are only returned to the system when the pool is destroyed, so a container that is cleared and refilled
+ * through a pool_allocator stops allocating once the pool has grown to its peak size.  A block_size smaller than the
+ * largest pooled node is raised to it.
+ */
+class node_pool {
+public:
+    explicit node_pool(std::size_t block_size = 64 * 1024)
+        : block_size_(std::max(block_size, max_node_size))
+    {}
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    void* allocate(std::size_t bytes) {
+        const auto size_class = size_class_of(bytes);
+        if (size_class >= free_lists_.size())
+            return ::operator new(bytes);
+
+        if (free_lists_[size_class] != nullptr) {
+            auto node = free_lists_[size_class];
+            free_lists_[size_class] = node->next;
+            return node;
+        }
+
+        return carve((size_class + 1) * granularity);
+    }
+
+    void deallocate(void* p, std::size_t bytes) {
+        const auto size_class = size_class_of(bytes);
+        if (size_class >= free_lists_.size()) {
+            ::operator delete(p);
+            return;
+        }
+
+        auto node = static_cast<free_node*>(p);
+        node->next = free_lists_[size_class];
+        free_lists_[size_class] = node;
+    }
+
+    std::size_t blocks() const { return blocks_.size(); }
+
+private:
+    struct free_node {
+        free_node* next;
+    };
+
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t n_size_classes = 16;
+    static constexpr std::size_t max_node_size = n_size_classes * granularity;
+
+    // nodes are carved at multiples of granularity from blocks that new char[] aligns for any fundamental type, and a
+    // freed node must hold its free list link
+    static_assert((granularity & (granularity - 1)) == 0, "node_pool needs a power of two granularity");
+    static_assert(sizeof(free_node) <= granularity && alignof(free_node) <= granularity,
+                  "node_pool nodes must hold a free list link");
+
+    static constexpr std::size_t size_class_of(std::size_t bytes) {
+        return bytes == 0 ? 0 : (bytes - 1) / granularity;
+    }
+
+    void* carve(std::size_t bytes) {
+        assert(bytes % granularity == 0 && bytes <= block_size_);
+        if (blocks_.empty() || offset_ + bytes > block_size_) {
+            blocks_.emplace_back(new char[block_size_]);
+            offset_ = 0;
+        }
+
+        void* p = blocks_.back().get() + offset_;
+        offset_ += bytes;
+        return p;
+    }
+
+    std::size_t block_size_;
+    std::size_t offset_ = 0;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::array<free_node*, n_size_classes> free_lists_ {};
+};
+
+/**
+ * Standard allocator adaptor over a node_pool.  Copies and rebinds share the pool.
+ */
+template <typename T>
+class pool_allocator {
+public:
+    using value_type = T;
+
+    explicit pool_allocator(node_pool* pool) noexcept
+        : pool_(pool)
+    {}
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U>& other) noexcept
+        : pool_(other.pool())
+    {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        pool_->deallocate(p, n * sizeof(T));
+    }
+
+    node_pool* pool() const noexcept { return pool_; }
+
+    template <typename U>
+    bool operator==(const pool_allocator<U>& other) const noexcept { return pool_ == other.pool(); }
+
+    template <typename U>
+    bool operator!=(const pool_allocator<U>& other) const noexcept { return pool_ != other.pool(); }
+
+private:
+    node_pool* pool_;
+};
+
+}   // namespace mtlib
+
+#endif // _MTLIB_POOL_ALLOCATOR_H_
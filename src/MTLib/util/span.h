@@ -0,0 +1,53 @@
+#ifndef _MTLIB_SPAN_H_
+#define _MTLIB_SPAN_H_
+
+#include <cstddef>  // size_t
+#include <type_traits>
+
+namespace mtlib {
+
+/**
+ * Non-owning view of a contiguous range of T.
+ *
+ * Stands in for std::span until the library moves past C++17.
+ */
+template <typename T>
+class span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr span() noexcept = default;
+
+    constexpr span(T* data, size_type size) noexcept
+        : data_(data), size_(size)
+    {}
+
+    template <typename Container>
+    constexpr span(Container& c) noexcept
+        : data_(c.data()), size_(c.size())
+    {}
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    constexpr reference operator[](size_type idx) const { return data_[idx]; }
+    constexpr reference front() const { return data_[0]; }
+    constexpr reference back() const { return data_[size_ - 1]; }
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+private:
+    T* data_ = nullptr;
+    size_type size_ = 0;
+};
+
+}   // namespace mtlib
+
+#endif // _MTLIB_SPAN_H_
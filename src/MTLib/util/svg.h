@@ -73,12 +73,12 @@ private:
     static std::stringstream _ss;
 };
 
-float svg::stroke_width = 0.5f;
-float svg::point_size = 1.3f;
-std::string svg::fill_color = "#00695C11";
-std::string svg::stroke_color = "black";
-std::string svg::point_color = "black";
-std::stringstream svg::_ss;
+inline float svg::stroke_width = 0.5f;
+inline float svg::point_size = 1.3f;
+inline std::string svg::fill_color = "#00695C11";
+inline std::string svg::stroke_color = "black";
+inline std::string svg::point_color = "black";
+inline std::stringstream svg::_ss;
 
 }
 
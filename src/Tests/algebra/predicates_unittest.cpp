@@ -0,0 +1,171 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+// the orientation of points on a 2^-53 grid, exactly in 128-bit integers
+int reference_orientation(const vec2d& v1, const vec2d& v2, const vec2d& v3) {
+    auto fixed = [](double x) { return static_cast<int128>(ldexp(x, 53)); };
+    const auto det = (fixed(v2[0]) - fixed(v1[0])) * (fixed(v3[1]) - fixed(v1[1])) -
+        (fixed(v2[1]) - fixed(v1[1])) * (fixed(v3[0]) - fixed(v1[0]));
+    return (det > 0) - (det < 0);
+}
+
+// Kettner et al., "Classroom Examples of Robustness Problems in Geometric Computations": points within a few ulps of
+// the line through q and r
+TEST(Predicates2DTest, NearlyColinear) {
+    const vec2d q(12, 12);
+    const vec2d r(24, 24);
+    const double ulp = ldexp(1.0, -53);
+
+    int plain_wrong = 0;
+    for (int x = 0; x < 64; ++x) {
+        for (int y = 0; y < 64; ++y) {
+            const vec2d p(0.5 + x * ulp, 0.5 + y * ulp);
+            const auto expected = reference_orientation(p, q, r);
+            EXPECT_EQ(expected, adaptive_predicates::orientation_2D(p, q, r));
+            EXPECT_EQ(expected, adaptive_predicates::orientation_2D(q, r, p));
+            EXPECT_EQ(-expected, adaptive_predicates::orientation_2D(q, p, r));
+            plain_wrong += plain_predicates::orientation_2D(p, q, r) != expected;
+        }
+    }
+
+    // the reason for the adaptive predicates
+    EXPECT_GT(plain_wrong, 0);
+}
+
+TEST(Predicates2DTest, MatchesPlainOnRandomInput) {
+    mt19937 gen(0);
+    uniform_real_distribution<double> dis(-100, 100);
+    for (int i = 0; i < 10000; ++i) {
+        const vec2d v1(dis(gen), dis(gen));
+        const vec2d v2(dis(gen), dis(gen));
+        const vec2d v3(dis(gen), dis(gen));
+        EXPECT_EQ(plain_predicates::orientation_2D(v1, v2, v3), adaptive_predicates::orientation_2D(v1, v2, v3));
+    }
+}
+
+TEST(Predicates2DTest, ExactFallback) {
+    mt19937 gen(1);
+    uniform_int_distribution<int> dis(-1000, 1000);
+    const double ulp = ldexp(1.0, -53);
+
+    // the exact path on its own, including inputs the filter would decide
+    for (int i = 0; i < 10000; ++i) {
+        const vec2d v1(dis(gen) * ulp + 0.5, dis(gen) * ulp + 0.5);
+        const vec2d v2(dis(gen) / 64.0, dis(gen) / 64.0);
+        const vec2d v3(dis(gen) / 64.0, dis(gen) / 64.0);
+        EXPECT_EQ(reference_orientation(v1, v2, v3), exact::turn_2D(v1, v2, v1, v3));
+    }
+
+    EXPECT_EQ(0, exact::turn_2D(vec2d(0, 0), vec2d(1, 1), vec2d(3, 3), vec2d(5, 5)));
+    EXPECT_EQ(1, exact::turn_2D(vec2d(0, 0), vec2d(1, 0), vec2d(0, 0), vec2d(0, 1)));
+    EXPECT_EQ(-1, exact::turn_2D(vec2d(0, 0), vec2d(0, 1), vec2d(0, 0), vec2d(1, 0)));
+}
+
+TEST(Predicates2DTest, Float) {
+    const vec2f q(12, 12);
+    const vec2f r(24, 24);
+    const float ulp = ldexp(1.0f, -24);
+
+    for (int x = 0; x < 32; ++x) {
+        for (int y = 0; y < 32; ++y) {
+            const vec2f p(0.5f + x * ulp, 0.5f + y * ulp);
+            const vec2d pd(p[0], p[1]);
+            const auto expected = reference_orientation(pd, vec2d(12, 12), vec2d(24, 24));
+            EXPECT_EQ(expected, adaptive_predicates::orientation_2D(p, q, r));
+        }
+    }
+}
+
+TEST(Predicates2DTest, Overlap) {
+    // the probe points away from the line and only touches it if p lies on it
+    const double ulp = ldexp(1.0, -53);
+    const segment2d line(vec2d(-12, -12), vec2d(24, 24));
+    for (int x = 0; x < 64; ++x) {
+        const vec2d p(0.5 + x * ulp, 0.5);
+        const segment2d probe(p, vec2d(1, 0));
+        const bool expected = reference_orientation(line[0], line[1], p) == 0;
+        EXPECT_EQ(expected, overlap_segment_segment_2D(line, probe, adaptive_predicates()));
+        EXPECT_EQ(expected, intersect_segment_segment_2D(line, probe, adaptive_predicates()).second);
+    }
+}
+
+TEST(Predicates2DTest, SweepOrder) {
+    // a segment starting a few ulps off a line, compared at its start with a segment along the line
+    const double ulp = ldexp(1.0, -53);
+    vector<segment2d> segments(2);
+    segments[0] = segment2d(vec2d(-12, -12), vec2d(24, 24));
+    vector<bool> in_event {false, true};
+    intersection::sweep_line_state_2D<double> state;
+    state.segments = &segments;
+    state.in_event = &in_event;
+    const intersection::segment_comparer<double, plain_predicates> plain(&state);
+    const intersection::segment_comparer<double, adaptive_predicates> adaptive(&state);
+
+    int plain_wrong = 0;
+    for (int x = 0; x < 64; ++x) {
+        for (int y = 0; y < 64; ++y) {
+            const vec2d p(0.5 + x * ulp, 0.5 + y * ulp);
+            const auto expected = reference_orientation(segments[0][0], segments[0][1], p);
+            if (expected == 0)
+                continue;
+
+            segments[1] = segment2d(p, vec2d(1, 0));
+            state.point = p;
+            EXPECT_EQ(expected > 0, adaptive(0, 1));
+            EXPECT_EQ(expected < 0, adaptive(1, 0));
+            EXPECT_EQ(expected > 0, adaptive(0, p));
+            plain_wrong += plain(0, 1) != (expected > 0);
+        }
+    }
+
+    // the plain order at the sweep line differs
+    EXPECT_GT(plain_wrong, 0);
+}
+
+TEST(Predicates2DTest, ConvexHull) {
+    // points a few ulps around a line, the hull must turn left at every vertex
+    const double ulp = ldexp(1.0, -53);
+    mt19937 gen(2);
+    uniform_int_distribution<int> dis(0, 63);
+
+    vector<vec2d> points;
+    for (int i = 0; i < 200; ++i)
+        points.emplace_back(0.5 + dis(gen) * ulp, 0.5 + dis(gen) * ulp);
+    points.emplace_back(12, 12);
+    points.emplace_back(24, 24);
+
+    vector<vec2d> hull;
+    chull_graham_2d(points.begin(), points.end(), back_inserter(hull), adaptive_predicates());
+    ASSERT_GE(hull.size(), 3u);
+    for (size_t i = 0; i < hull.size(); ++i)
+        EXPECT_EQ(1, reference_orientation(hull[i], hull[(i + 1) % hull.size()], hull[(i + 2) % hull.size()]));
+}
+
+TEST(Predicates2DTest, Integer) {
+    // one unit off a line across the whole coordinate range, the products need every widened bit
+    const int32_t big = (1 << 30) - 1;
+    const vec2<int32_t> a(-big, -big), b(big, big - 1);
+    EXPECT_EQ(1, plain_predicates::orientation_2D(a, b, vec2<int32_t>(big - 2, big - 2)));
+    EXPECT_EQ(-1, plain_predicates::orientation_2D(a, b, vec2<int32_t>(big, big - 2)));
+    EXPECT_EQ(0, plain_predicates::orientation_2D(vec2<int32_t>(-big, -big), vec2<int32_t>(0, 0),
+        vec2<int32_t>(big, big)));
+    EXPECT_EQ(-(int64_t)2 * big * (2 * big - 1), signed_area_2D(a, b, vec2<int32_t>(big, -big)));
+
+    const int64_t huge = ((int64_t)1 << 62) - 1;
+    const vec2<int64_t> c(-huge, -huge), d(huge, huge - 1);
+    EXPECT_EQ(1, adaptive_predicates::orientation_2D(c, d, vec2<int64_t>(huge - 2, huge - 2)));
+    EXPECT_EQ(-1, adaptive_predicates::orientation_2D(c, d, vec2<int64_t>(huge, huge - 2)));
+    EXPECT_EQ(1, plain_predicates::turn_2D(c, d, c, vec2<int64_t>(-huge, huge)));
+}
+
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <random>
 #include <vector>
 
 using namespace std;
@@ -84,4 +85,132 @@ TEST_F(CHullGraham2dTest, Grid3x3) {
     EXPECT_TRUE(is_convex_2d(chull.begin(), chull.end()));
 }
 
+TEST_F(CHullGraham2dTest, Integer) {
+    // points one unit either side of a long diagonal, only the exact predicate keeps the hull convex
+    const int64_t big = ((int64_t)1 << 62) - 1;
+    vector<vec2<int64_t>> points;
+    for (int64_t i = 0; i < 100; ++i) {
+        const int64_t x = -big + i * (big / 50);
+        points.emplace_back(x, x + (i % 3) - 1);
+    }
+
+    vector<vec2<int64_t>> hull;
+    chull_graham_2d(points.begin(), points.end(), back_inserter(hull));
+    ASSERT_GE(hull.size(), 3u);
+    EXPECT_TRUE(is_convex_2d(hull.begin(), hull.end()));
+    for (size_t i = 0; i < hull.size(); ++i)
+        EXPECT_TRUE(is_ccw(hull[i], hull[(i + 1) % hull.size()], hull[(i + 2) % hull.size()]));
+}
+
+TEST_F(CHullGraham2dTest, Indices) {
+    vector<vec2d> grid;
+    grid.emplace_back(-1, 1); grid.emplace_back(0, 1); grid.emplace_back(1, 1);
+    grid.emplace_back(-1, 0); grid.emplace_back(0, 0); grid.emplace_back(1, 0);
+    grid.emplace_back(-1, -1); grid.emplace_back(0, -1); grid.emplace_back(1, -1);
+
+    chull_scratch_2d<double> scratch;
+    vector<uint32_t> indices;
+    chull_graham_2d_indices(grid.begin(), grid.end(), back_inserter(indices), scratch);
+    EXPECT_EQ((vector<uint32_t>{6, 8, 2, 0}), indices);
+
+    // triples start at their smallest point too
+    indices.clear();
+    chull_graham_2d_indices(grid.begin() + 2, grid.begin() + 5, back_inserter(indices), scratch);
+    EXPECT_EQ((vector<uint32_t>{1, 2, 0}), indices);
+    indices.clear();
+    chull_graham_2d_indices(grid.begin() + 1, grid.begin() + 4, back_inserter(indices), scratch);
+    EXPECT_EQ((vector<uint32_t>{2, 1, 0}), indices);
+
+    // colinear points leave their extremes, a repeated point leaves itself
+    indices.clear();
+    chull_graham_2d_indices(grid.begin(), grid.begin() + 3, back_inserter(indices), scratch);
+    EXPECT_EQ((vector<uint32_t>{0, 2}), indices);
+    const vector<vec2d> repeated(5, vec2d(2, 3));
+    for (size_t n = 1; n <= repeated.size(); ++n) {
+        chull.clear();
+        chull_graham_2d(repeated.begin(), repeated.begin() + n, back_inserter(chull), scratch);
+        EXPECT_EQ(vector<vec2d>(1, repeated[0]), chull);
+    }
+}
+
+TEST_F(CHullGraham2dTest, ScratchMatchesPlain) {
+    mt19937 gen(7);
+    uniform_int_distribution<int> coordinate(-20, 20);
+    uniform_int_distribution<int> size(1, 40);
+
+    chull_scratch_2d<double> scratch;
+    vector<vec2d> with_scratch;
+    for (int round = 0; round < 200; ++round) {
+        vector<vec2d> points(size(gen));
+        for (auto& p : points)
+            p = vec2d(coordinate(gen), coordinate(gen));
+
+        chull.clear();
+        with_scratch.clear();
+        chull_graham_2d(points.begin(), points.end(), back_inserter(chull));
+        chull_graham_2d(points.begin(), points.end(), back_inserter(with_scratch), scratch);
+        ASSERT_EQ(chull, with_scratch);
+
+        const auto size = chull_monotone_chain_2d(points.begin(), points.end(), scratch, adaptive_predicates());
+        ASSERT_EQ(chull.size(), size);
+        for (size_t i = 0; i < size; ++i)
+            EXPECT_EQ(chull[i], points[scratch.stack[i]]);
+    }
+}
+
+TEST_F(CHullGraham2dTest, AklToussaintFilter) {
+    vector<vec2d> points;
+    for (int x = -5; x <= 5; ++x) {
+        for (int y = -5; y <= 5; ++y)
+            points.emplace_back(x, y);
+    }
+
+    // only the square's boundary is not strictly inside the octagon, which is the square itself
+    vector<vec2d> kept;
+    akl_toussaint_filter_2d(points.begin(), points.end(), back_inserter(kept));
+    EXPECT_EQ(40u, kept.size());
+    for (const auto& p : kept)
+        EXPECT_TRUE(abs(p[0]) == 5 || abs(p[1]) == 5);
+
+    // colinear points keep everything
+    vector<vec2<int32_t>> line;
+    for (int32_t i = 0; i < 10; ++i)
+        line.emplace_back(i, 2 * i);
+    vector<vec2<int32_t>> kept_line;
+    akl_toussaint_filter_2d(line.begin(), line.end(), back_inserter(kept_line));
+    EXPECT_EQ(line, kept_line);
+}
+
+TEST_F(CHullGraham2dTest, AklToussaintMatchesPlain) {
+    mt19937 gen(11);
+    uniform_int_distribution<int> coordinate(-1000, 1000);
+    uniform_int_distribution<int> size(1, 300);
+
+    chull_akl_toussaint_scratch_2d<double> scratch;
+    vector<vec2d> filtered;
+    for (int round = 0; round < 200; ++round) {
+        vector<vec2d> points(size(gen));
+        for (auto& p : points) {
+            // every fourth set inside a disc, whose octagon culls less
+            p = vec2d(coordinate(gen), coordinate(gen));
+            while (round % 4 == 0 && p[0] * p[0] + p[1] * p[1] > 1e6)
+                p = vec2d(coordinate(gen), coordinate(gen));
+        }
+
+        chull.clear();
+        filtered.clear();
+        chull_graham_2d(points.begin(), points.end(), back_inserter(chull));
+        chull_akl_toussaint_2d(points.begin(), points.end(), back_inserter(filtered), scratch);
+        ASSERT_EQ(chull, filtered);
+    }
+
+    // a triangle with points inside it is left with three points
+    vector<vec2d> triangle = {{0, 0}, {4, 1}, {1, 1}, {1, 4}, {1, 2}};
+    chull.clear();
+    filtered.clear();
+    chull_graham_2d(triangle.begin(), triangle.end(), back_inserter(chull));
+    chull_akl_toussaint_2d(triangle.begin(), triangle.end(), back_inserter(filtered), scratch);
+    EXPECT_EQ(chull, filtered);
+}
+
 }   // namespace
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+namespace {
+
+class CHullParallel2dTest : public ::testing::Test {
+protected:
+    // both parallel hulls equal the sequential one for any number of threads
+    void expect_same_hull(const vector<vec2d>& points) {
+        vector<vec2d> expected;
+        chull_graham_2d(points.begin(), points.end(), back_inserter(expected));
+
+        for (size_t n_threads : {1, 2, 3, 7}) {
+            vector<vec2d> hull;
+            chull_parallel_2d(points.begin(), points.end(), back_inserter(hull), n_threads, plain_predicates(), 16);
+            EXPECT_EQ(expected, hull) << n_threads << " threads";
+
+            hull.clear();
+            chull_parallel_sorted_2d(
+                points.begin(), points.end(), back_inserter(hull), n_threads, plain_predicates(), 16
+            );
+            EXPECT_EQ(expected, hull) << n_threads << " threads, sorted";
+        }
+    }
+};
+
+TEST_F(CHullParallel2dTest, Small) {
+    vector<vec2d> points;
+    points.emplace_back(0, 0);
+    expect_same_hull(points);
+    points.emplace_back(0, 1);
+    points.emplace_back(1, 1);
+    expect_same_hull(points);
+    points.emplace_back(1, 0);
+    expect_same_hull(points);
+}
+
+TEST_F(CHullParallel2dTest, Grid) {
+    // colinear hull points and duplicates
+    vector<vec2d> points;
+    mt19937 gen(3);
+    uniform_int_distribution<int> coordinate(-10, 10);
+    for (int i = 0; i < 2000; ++i)
+        points.emplace_back(coordinate(gen), coordinate(gen));
+    expect_same_hull(points);
+}
+
+TEST_F(CHullParallel2dTest, Degenerate) {
+    vector<vec2d> points(500, vec2d(1, 2));
+    expect_same_hull(points);
+
+    for (int i = 0; i < 500; ++i)
+        points[i] = vec2d(i % 17, 2 * (i % 17));
+    expect_same_hull(points);
+}
+
+TEST_F(CHullParallel2dTest, Circle) {
+    // every point is a hull vertex
+    vector<vec2d> points;
+    for (int i = 0; i < 1000; ++i)
+        points.emplace_back(cos(i * 0.0061), sin(i * 0.0061));
+    expect_same_hull(points);
+}
+
+}   // namespace
@@ -0,0 +1,80 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+namespace {
+
+class CHullQuickhull2dTest : public ::testing::Test {
+protected:
+    // quickhull and the dispatcher give chull_graham_2d's hull in its order
+    void expect_same_hull(const vector<vec2d>& points) {
+        vector<vec2d> expected, hull;
+        chull_graham_2d(points.begin(), points.end(), back_inserter(expected));
+
+        chull_quickhull_2d(points.begin(), points.end(), back_inserter(hull), scratch);
+        EXPECT_EQ(expected, hull);
+
+        hull.clear();
+        chull_auto_2d(points.begin(), points.end(), back_inserter(hull), scratch);
+        EXPECT_EQ(expected, hull);
+    }
+
+    chull_quickhull_scratch_2d<double> scratch;
+};
+
+TEST_F(CHullQuickhull2dTest, Small) {
+    vector<vec2d> points;
+    points.emplace_back(0, 0);
+    expect_same_hull(points);
+    points.emplace_back(1, 1);
+    points.emplace_back(0, 1);
+    expect_same_hull(points);
+    points.emplace_back(1, 0);
+    expect_same_hull(points);
+
+    // repeated and colinear points, as few as the culling before quickhull may leave
+    expect_same_hull(vector<vec2d>(2, vec2d(1, 1)));
+    expect_same_hull(vector<vec2d>(5, vec2d(1, 1)));
+    expect_same_hull({{2, 2}, {0, 0}, {1, 1}});
+    expect_same_hull({{2, 2}, {0, 0}, {2, 2}, {0, 0}});
+}
+
+TEST_F(CHullQuickhull2dTest, Degenerate) {
+    vector<vec2d> points(100, vec2d(3, -1));
+    expect_same_hull(points);
+
+    for (int i = 0; i < 100; ++i)
+        points[i] = vec2d(i % 13, -(i % 13));
+    expect_same_hull(points);
+}
+
+TEST_F(CHullQuickhull2dTest, Grids) {
+    // colinear points on the hull edges, ties for the furthest point and duplicates
+    mt19937 gen(5);
+    for (int extent : {1, 2, 5, 100}) {
+        uniform_int_distribution<int> coordinate(-extent, extent);
+        for (int round = 0; round < 50; ++round) {
+            vector<vec2d> points(1 + round * 40);
+            for (auto& p : points)
+                p = vec2d(coordinate(gen), coordinate(gen));
+            expect_same_hull(points);
+        }
+    }
+}
+
+TEST_F(CHullQuickhull2dTest, Circle) {
+    vector<vec2d> points;
+    for (int i = 0; i < 2000; ++i)
+        points.emplace_back(round(1e6 * cos(i * 0.00314)), round(1e6 * sin(i * 0.00314)));
+    expect_same_hull(points);
+    EXPECT_EQ(points.size(), estimate_hull_size_2d(points.begin(), points.end(), scratch, 1000));
+}
+
+}   // namespace
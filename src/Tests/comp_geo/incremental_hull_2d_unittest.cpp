@@ -0,0 +1,108 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace mtlib;
+
+namespace {
+
+class IncrementalHull2dTest : public ::testing::Test {
+protected:
+    vector<vec2d> snapshot() const {
+        vector<vec2d> result;
+        hull.snapshot(back_inserter(result));
+        return result;
+    }
+
+    incremental_hull_2d<double> hull;
+};
+
+TEST_F(IncrementalHull2dTest, Growing) {
+    EXPECT_TRUE(hull.empty());
+    EXPECT_TRUE(hull.insert(vec2d(0, 0)));
+    EXPECT_FALSE(hull.insert(vec2d(0, 0)));
+    EXPECT_EQ(vector<vec2d>({{0, 0}}), snapshot());
+    EXPECT_TRUE(hull.contains(vec2d(0, 0)));
+    EXPECT_FALSE(hull.contains(vec2d(0, 1)));
+
+    EXPECT_TRUE(hull.insert(vec2d(2, 0)));
+    EXPECT_TRUE(hull.contains(vec2d(1, 0)));
+    EXPECT_FALSE(hull.contains(vec2d(1, 1)));
+
+    // colinear points extend the segment or fall on it
+    EXPECT_FALSE(hull.insert(vec2d(1, 0)));
+    EXPECT_TRUE(hull.insert(vec2d(4, 0)));
+    EXPECT_EQ(vector<vec2d>({{0, 0}, {4, 0}}), snapshot());
+
+    EXPECT_TRUE(hull.insert(vec2d(0, 4)));
+    EXPECT_TRUE(hull.insert(vec2d(4, 4)));
+    EXPECT_FALSE(hull.insert(vec2d(2, 2)));
+    EXPECT_FALSE(hull.insert(vec2d(2, 4)));
+    EXPECT_EQ(vector<vec2d>({{0, 0}, {4, 0}, {4, 4}, {0, 4}}), snapshot());
+    EXPECT_EQ(4u, hull.size());
+
+    EXPECT_TRUE(hull.contains(vec2d(4, 2)));
+    EXPECT_TRUE(hull.contains(vec2d(0, 2)));
+    EXPECT_FALSE(hull.contains(vec2d(4, 5)));
+    EXPECT_FALSE(hull.contains(vec2d(-1, 2)));
+
+    EXPECT_EQ(vec2d(4, 4), hull.extreme(vec2d(1, 1)));
+    EXPECT_EQ(vec2d(0, 0), hull.extreme(vec2d(-1, -1)));
+    EXPECT_EQ(vec2d(4, 0), hull.extreme(vec2d(1, -1)));
+    EXPECT_EQ(vec2d(0, 4), hull.extreme(vec2d(-1, 1)));
+
+    // a point outside a corner replaces it
+    EXPECT_TRUE(hull.insert(vec2d(5, 5)));
+    EXPECT_EQ(vector<vec2d>({{0, 0}, {4, 0}, {5, 5}, {0, 4}}), snapshot());
+
+    hull.clear();
+    EXPECT_TRUE(hull.empty());
+    EXPECT_FALSE(hull.contains(vec2d(0, 0)));
+}
+
+TEST_F(IncrementalHull2dTest, MatchesRebuild) {
+    mt19937 gen(9);
+    for (int extent : {3, 50, 100000}) {
+        uniform_int_distribution<int> coordinate(-extent, extent);
+        hull.clear();
+        vector<vec2d> points;
+        for (int i = 0; i < 400; ++i) {
+            points.emplace_back(coordinate(gen), coordinate(gen));
+            hull.insert(points.back());
+
+            vector<vec2d> expected;
+            chull_graham_2d(points.begin(), points.end(), back_inserter(expected));
+            ASSERT_EQ(expected, snapshot()) << i;
+            ASSERT_EQ(expected.size(), hull.size());
+
+            const vec2d q(coordinate(gen), coordinate(gen));
+            // a segment holds the points between its ends on its line
+            const auto between = [&](const vec2d& a, const vec2d& b) {
+                return min(a[0], b[0]) <= q[0] && q[0] <= max(a[0], b[0]) &&
+                    min(a[1], b[1]) <= q[1] && q[1] <= max(a[1], b[1]);
+            };
+            bool inside = expected.size() > 2 || q == expected.front() ||
+                (expected.size() == 2 && is_colinear(expected[0], expected[1], q) && between(expected[0], expected[1]));
+            if (expected.size() > 2) {
+                for (size_t j = 0; j < expected.size(); ++j)
+                    inside &= !is_cw(expected[j], expected[(j + 1) % expected.size()], q);
+            }
+            ASSERT_EQ(inside, hull.contains(q)) << i;
+
+            const vec2d d(coordinate(gen), coordinate(gen));
+            if (d[0] != 0 || d[1] != 0) {
+                double best = dot(d, expected.front());
+                for (const auto& v : expected)
+                    best = max(best, dot(d, v));
+                ASSERT_EQ(best, dot(d, hull.extreme(d))) << i;
+            }
+        }
+    }
+}
+
+}   // namespace
@@ -0,0 +1,97 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+TEST(IsSimplePolygon2dTest, Degenerate) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(1, 0);
+
+    EXPECT_FALSE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, Triangle) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(1, 0);
+    polygon.emplace_back(0, 1);
+
+    EXPECT_TRUE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, Concave) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(4, 0);
+    polygon.emplace_back(4, 4);
+    polygon.emplace_back(2, 1);
+    polygon.emplace_back(0, 4);
+
+    EXPECT_TRUE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, Bowtie) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(2, 2);
+    polygon.emplace_back(2, 0);
+    polygon.emplace_back(0, 2);
+
+    EXPECT_FALSE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, TouchingVertex) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(4, 0);
+    polygon.emplace_back(4, 4);
+    polygon.emplace_back(2, 0);
+    polygon.emplace_back(0, 4);
+
+    EXPECT_FALSE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, FoldBack) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(4, 0);
+    polygon.emplace_back(2, 0);
+    polygon.emplace_back(2, 3);
+
+    EXPECT_FALSE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, RepeatedVertex) {
+    vector<vec2d> polygon;
+    polygon.emplace_back(0, 0);
+    polygon.emplace_back(1, 0);
+    polygon.emplace_back(1, 0);
+    polygon.emplace_back(0, 1);
+
+    EXPECT_FALSE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+TEST(IsSimplePolygon2dTest, Star) {
+    const double pi = std::acos(-1.0);
+    vector<vec2d> polygon;
+    for (int i = 0; i < 100; ++i) {
+        const double angle = 2.0 * pi * i / 100;
+        const double radius = i % 2 == 0 ? 10.0 : 3.0;
+        polygon.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    EXPECT_TRUE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+
+    std::swap(polygon[10], polygon[60]);
+    EXPECT_FALSE(is_simple_polygon_2d(polygon.begin(), polygon.end()));
+}
+
+}
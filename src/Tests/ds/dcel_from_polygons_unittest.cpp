@@ -0,0 +1,144 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace mtlib;
+using namespace mtlib::ds;
+using namespace std;
+
+namespace {
+
+// checks the links of every half-edge, returns the number of half-edges on the outer face
+template <typename Traits>
+size_t check_links(polygon_mesh<Traits>& mesh) {
+    auto& d = mesh.dcel;
+    size_t n_outer = 0;
+    for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h) {
+        const auto handle = d.handle_of(*h);
+        EXPECT_TRUE(d.is_consistent(handle));
+        EXPECT_NE(handle, h->twin);
+        EXPECT_EQ(handle, d[h->twin].twin);
+        EXPECT_EQ(handle, d[h->next].prev);
+        EXPECT_EQ(handle, d[h->prev].next);
+        EXPECT_EQ(d[h->twin].origin, d[h->next].origin);
+        EXPECT_EQ(h->face, d[h->next].face);
+        n_outer += h->face == mesh.outer_face;
+    }
+    for (auto v = d.vertices_begin(); v != d.vertices_end(); ++v) {
+        if (v->incident != d.null_half_edge) {
+            EXPECT_EQ(d.handle_of(*v), d[v->incident].origin);
+        }
+    }
+    return n_outer;
+}
+
+// k x k quads, counter-clockwise
+void grid(size_t k, vector<vec2d>& points, vector<vector<uint32_t>>& polygons) {
+    for (size_t j = 0; j <= k; ++j) {
+        for (size_t i = 0; i <= k; ++i)
+            points.emplace_back(static_cast<double>(i), static_cast<double>(j));
+    }
+    const auto vertex = [&](size_t i, size_t j) { return static_cast<uint32_t>(j * (k + 1) + i); };
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t i = 0; i < k; ++i)
+            polygons.push_back({ vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1), vertex(i, j + 1) });
+    }
+}
+
+}   // namespace
+
+TEST(DCELFromPolygonsTest, Empty) {
+    auto mesh = dcel_from_polygons(vector<vec2d>(), vector<vector<uint32_t>>());
+    EXPECT_TRUE(mesh.dcel.vertices_empty());
+    EXPECT_TRUE(mesh.dcel.half_edges_empty());
+    EXPECT_EQ(1, mesh.dcel.faces_size());
+    EXPECT_FALSE(mesh.dcel.is_consistent(mesh.outer_face));
+}
+
+TEST(DCELFromPolygonsTest, Triangle) {
+    vector<vec2d> points = { {0, 0}, {1, 0}, {0, 1}, {5, 5} };
+    auto mesh = dcel_from_polygons(points, vector<vector<int>>{ {0, 1, 2} });
+    auto& d = mesh.dcel;
+    EXPECT_EQ(4, d.vertices_size());
+    EXPECT_EQ(6, d.half_edges_size());
+    EXPECT_EQ(2, d.faces_size());
+    EXPECT_EQ(3, check_links(mesh));
+    EXPECT_TRUE(mesh.non_manifold.empty());
+    EXPECT_FALSE(d.is_consistent(mesh.vertices[3]));
+
+    // the polygon runs through its corners in order, the outer face the other way round
+    const auto inner = d[mesh.faces[0]].incident;
+    EXPECT_EQ(mesh.vertices[0], d[inner].origin);
+    EXPECT_EQ(mesh.vertices[1], d[d[inner].next].origin);
+    EXPECT_EQ(mesh.vertices[2], d[d[inner].prev].origin);
+    const auto outer = d[mesh.outer_face].incident;
+    EXPECT_EQ(mesh.outer_face, d[outer].face);
+    EXPECT_EQ(mesh.vertices[1], d[outer].origin);
+    EXPECT_EQ(mesh.vertices[0], d[d[outer].next].origin);
+    EXPECT_EQ(mesh.vertices[2], d[d[outer].prev].origin);
+
+    // boundary vertices start at their outer half-edge
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(mesh.outer_face, d[d[mesh.vertices[i]].incident].face);
+}
+
+TEST(DCELFromPolygonsTest, Grid) {
+    vector<vec2d> points;
+    vector<vector<uint32_t>> polygons;
+    grid(7, points, polygons);
+
+    for (size_t n_threads : {1, 3, 8}) {
+        auto mesh = dcel_from_polygons(points, polygons, n_threads);
+        auto& d = mesh.dcel;
+        EXPECT_EQ(points.size(), d.vertices_size());
+        EXPECT_EQ(2 * (2 * 7 * 8), d.half_edges_size());
+        EXPECT_EQ(7 * 7 + 1, d.faces_size());
+        EXPECT_EQ(4 * 7, check_links(mesh));
+        EXPECT_TRUE(mesh.non_manifold.empty());
+
+        // a single boundary, clockwise
+        size_t n = 0;
+        double area = 0;
+        const auto outer = d[mesh.outer_face].incident;
+        for (auto h = d.half_edge_loop_begin(outer); h != d.half_edge_loop_end(outer); ++h, ++n)
+            area += dot_perp(points[h->origin.index], points[d[h->twin].origin.index]);
+        EXPECT_EQ(4 * 7, n);
+        EXPECT_EQ(-2 * 49, area);
+    }
+}
+
+TEST(DCELFromPolygonsTest, Closed) {
+    // a tetrahedron has no boundary
+    vector<vec2d> points(4);
+    auto mesh = dcel_from_polygons<dcel_list_Traits>(points,
+        vector<vector<int>>{ {0, 2, 1}, {0, 1, 3}, {1, 2, 3}, {2, 0, 3} }, 2);
+    EXPECT_EQ(12, mesh.dcel.half_edges_size());
+    EXPECT_EQ(0, check_links(mesh));
+    EXPECT_TRUE(mesh.non_manifold.empty());
+    EXPECT_FALSE(mesh.dcel.is_consistent(mesh.outer_face));
+}
+
+TEST(DCELFromPolygonsTest, NonManifold) {
+    // three triangles on the edge 0-1, and a fourth using the edge 1-3 in the same direction as its neighbour
+    vector<vec2d> points(6);
+    vector<vector<uint32_t>> polygons = { {0, 1, 2}, {1, 0, 3}, {0, 1, 4}, {3, 1, 5} };
+    auto mesh = dcel_from_polygons(points, polygons, 2);
+    auto& d = mesh.dcel;
+    check_links(mesh);
+
+    // the flagged edges are cut, every one of their polygon half-edges has a twin on the outer face
+    ASSERT_EQ(5, mesh.non_manifold.size());
+    for (auto h : mesh.non_manifold) {
+        EXPECT_NE(mesh.outer_face, d[h].face);
+        EXPECT_EQ(mesh.outer_face, d[d[h].twin].face);
+    }
+    EXPECT_EQ(mesh.vertices[0], d[mesh.non_manifold[0]].origin);
+    EXPECT_EQ(mesh.vertices[1], d[mesh.non_manifold[1]].origin);
+    EXPECT_EQ(mesh.vertices[3], d[mesh.non_manifold[2]].origin);
+    EXPECT_EQ(mesh.vertices[0], d[mesh.non_manifold[3]].origin);
+    EXPECT_EQ(mesh.vertices[3], d[mesh.non_manifold[4]].origin);
+    EXPECT_EQ(2 * 12, d.half_edges_size());
+}
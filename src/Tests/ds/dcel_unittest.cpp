@@ -8,6 +8,7 @@
 
 #include <array>
 #include <functional>
+#include <vector>
 
 using namespace mtlib;
 using namespace mtlib::ds;
@@ -183,4 +184,290 @@ TEST_F(DCELIteratorsTest, VertexIncidientReverseIterator) {
     EXPECT_EQ(*inner_half_edges[1], *(++it));
     EXPECT_EQ(it_end, ++it);
     EXPECT_NE(it_begin, it);
-}
\ No newline at end of file
+}
+
+TEST(DCELVectorTest, CreateAndErase) {
+    dcel_vector d;
+    auto v0 = d.create_vertex();
+    auto v1 = d.create_vertex();
+    auto h = d.create_half_edge();
+    auto f = d.create_face();
+
+    ASSERT_EQ(2, d.vertices_size());
+    ASSERT_FALSE(d.is_consistent(v0));
+    ASSERT_FALSE(d.is_consistent(h));
+    ASSERT_FALSE(d.is_consistent(f));
+    ASSERT_EQ(d.null_half_edge, d[v0].incident);
+    ASSERT_EQ(d.null_vertex, d[h].origin);
+    ASSERT_EQ(v0, d.handle_of(d[v0]));
+    ASSERT_EQ(h, d.handle_of(*d.half_edges_begin()));
+
+    // erasing leaves the other handles valid and the slot is reused
+    d[v1].incident = h;
+    d.erase_vertex(v0);
+    ASSERT_EQ(1, d.vertices_size());
+    ASSERT_EQ(h, d[v1].incident);
+    ASSERT_EQ(v1, d.handle_of(*d.vertices_begin()));
+
+    auto v2 = d.create_vertex();
+    ASSERT_EQ(v0, v2);
+    ASSERT_EQ(d.null_half_edge, d[v2].incident);
+    ASSERT_EQ(2, std::distance(d.vertices_begin(), d.vertices_end()));
+}
+
+TEST(DCELVectorTest, Iterators) {
+    // the triangle of DCELIteratorsTest with index handles
+    dcel_vector d;
+    std::array<dcel_vector::vertex_handle, 3> v;
+    std::array<dcel_vector::half_edge_handle, 3> inner;
+    std::array<dcel_vector::half_edge_handle, 3> outer;
+    for (int i = 0; i < 3; ++i)
+        v[i] = d.create_vertex();
+    for (int i = 0; i < 3; ++i) {
+        inner[i] = d.create_half_edge();
+        outer[i] = d.create_half_edge();
+    }
+    auto face = d.create_face();
+    d[face].incident = inner[0];
+
+    for (int i = 0; i < 3; ++i) {
+        const int next = (i + 1) % 3;
+        const int prev = (i + 2) % 3;
+        d[v[i]].incident = inner[i];
+        d[inner[i]].origin = d[outer[i]].origin = v[i];
+        d[inner[i]].twin = outer[next];
+        d[outer[next]].twin = inner[i];
+        d[inner[i]].next = inner[next];
+        d[inner[i]].prev = inner[prev];
+        d[outer[i]].next = outer[prev];
+        d[outer[i]].prev = outer[next];
+        d[inner[i]].face = face;
+    }
+
+    auto it = d.half_edge_loop_begin(inner[0]);
+    EXPECT_EQ(inner[0], it.handle());
+    EXPECT_EQ(inner[1], (++it).handle());
+    EXPECT_EQ(inner[2], (++it).handle());
+    EXPECT_EQ(d.half_edge_loop_end(inner[0]), ++it);
+
+    auto rit = d.half_edge_loop_rbegin(outer[0]);
+    EXPECT_EQ(d[outer[1]], *rit);
+    EXPECT_EQ(d[outer[2]], *(++rit));
+    EXPECT_EQ(d[outer[0]], *(++rit));
+    EXPECT_EQ(d.half_edge_loop_rend(outer[0]), ++rit);
+
+    auto vit = d.vertex_incident_begin(d[v[0]].incident);
+    EXPECT_EQ(inner[0], vit.handle());
+    EXPECT_EQ(outer[0], (++vit).handle());
+    EXPECT_EQ(d.vertex_incident_end(d[v[0]].incident), ++vit);
+
+    for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h)
+        EXPECT_EQ(d[d[d.handle_of(*h)].twin].twin, d.handle_of(*h));
+}
+
+namespace {
+
+// checks every link, the faces partition the half-edges into their loops
+template <typename Traits>
+void expect_consistent(const dcel<Traits>& d) {
+    for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h) {
+        const auto handle = d.handle_of(*h);
+        EXPECT_EQ(handle, d[h->twin].twin);
+        EXPECT_EQ(handle, d[h->next].prev);
+        EXPECT_EQ(handle, d[h->prev].next);
+        EXPECT_EQ(d[h->twin].origin, d[h->next].origin);
+        EXPECT_EQ(h->face, d[h->next].face);
+    }
+    for (auto v = d.vertices_begin(); v != d.vertices_end(); ++v) {
+        if (v->incident != d.null_half_edge) {
+            EXPECT_EQ(d.handle_of(*v), d[v->incident].origin);
+        }
+    }
+    size_t n = 0;
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f) {
+        EXPECT_EQ(d.handle_of(*f), d[f->incident].face);
+        n += std::distance(d.half_edge_loop_begin(f->incident), d.half_edge_loop_end(f->incident));
+    }
+    EXPECT_EQ(d.half_edges_size(), n);
+}
+
+template <typename Traits>
+size_t loop_size(const dcel<Traits>& d, typename Traits::face_handle f) {
+    return std::distance(d.half_edge_loop_begin(d[f].incident), d.half_edge_loop_end(d[f].incident));
+}
+
+// two unit squares side by side
+template <typename Traits>
+polygon_mesh<Traits> two_squares() {
+    return dcel_from_polygons<Traits>(vector<vec2d>(6), vector<vector<int>>{ {0, 1, 4, 3}, {1, 2, 5, 4} });
+}
+
+}   // namespace
+
+TEST(DCELEditTest, SplitEdge) {
+    auto mesh = two_squares<dcel_vector_Traits>();
+    auto& d = mesh.dcel;
+    const auto h = d[mesh.faces[0]].incident;
+    const auto v = d[d[h].next].origin;
+
+    const auto w = d.split_edge_at(h);
+    expect_consistent(d);
+    EXPECT_EQ(7, d.vertices_size());
+    EXPECT_EQ(16, d.half_edges_size());
+    EXPECT_EQ(w, d[d[h].next].origin);
+    EXPECT_EQ(v, d[d[d[h].next].next].origin);
+    EXPECT_EQ(w, d[d[h].twin].origin);
+    EXPECT_EQ(5, loop_size(d, mesh.faces[0]));
+    EXPECT_EQ(7, loop_size(d, mesh.outer_face));
+
+    d.remove_vertex(w);
+    expect_consistent(d);
+    EXPECT_EQ(6, d.vertices_size());
+    EXPECT_EQ(14, d.half_edges_size());
+    EXPECT_EQ(v, d[d[h].next].origin);
+    EXPECT_EQ(4, loop_size(d, mesh.faces[0]));
+
+    // the freed slots are taken again
+    EXPECT_EQ(w, d.split_edge_at(h));
+}
+
+TEST(DCELEditTest, SplitEdgeOfDanglingEdge) {
+    auto mesh = two_squares<dcel_vector_Traits>();
+    auto& d = mesh.dcel;
+    const auto h = d[mesh.faces[1]].incident;
+    const auto tip = d.add_vertex(h);
+    const auto w = d.split_edge_at(d[d[tip].incident].twin);
+    expect_consistent(d);
+    EXPECT_EQ(8, loop_size(d, mesh.faces[1]));
+
+    d.remove_vertex(tip);
+    d.remove_vertex(w);
+    expect_consistent(d);
+    EXPECT_EQ(6, d.vertices_size());
+    EXPECT_EQ(4, loop_size(d, mesh.faces[1]));
+}
+
+TEST(DCELEditTest, SplitAndMergeFaces) {
+    auto mesh = two_squares<dcel_vector_Traits>();
+    auto& d = mesh.dcel;
+    const auto f = mesh.faces[1];
+    const auto a = d[f].incident;
+    const auto b = d[d[a].next].next;
+
+    const auto e = d.split_face_at(a, b);
+    expect_consistent(d);
+    EXPECT_EQ(4, d.faces_size());
+    EXPECT_EQ(d[a].origin, d[e].origin);
+    EXPECT_EQ(d[b].origin, d[d[e].twin].origin);
+    EXPECT_EQ(f, d[a].face);
+    EXPECT_EQ(d[e].face, d[b].face);
+    EXPECT_NE(f, d[e].face);
+    EXPECT_EQ(3, loop_size(d, f));
+    EXPECT_EQ(3, loop_size(d, d[e].face));
+
+    EXPECT_EQ(f, d.merge_faces_at(d[e].twin));
+    expect_consistent(d);
+    EXPECT_EQ(3, d.faces_size());
+    EXPECT_EQ(14, d.half_edges_size());
+    EXPECT_EQ(4, loop_size(d, f));
+
+    // merging across an input edge joins the two squares
+    const auto shared = d[d[mesh.faces[0]].incident].next;
+    ASSERT_EQ(mesh.faces[1], d[d[shared].twin].face);
+    EXPECT_EQ(mesh.faces[0], d.merge_faces_at(shared));
+    expect_consistent(d);
+    EXPECT_EQ(2, d.faces_size());
+    EXPECT_EQ(6, loop_size(d, mesh.faces[0]));
+}
+
+TEST(DCELEditTest, AddAndRemoveVertex) {
+    auto mesh = two_squares<dcel_list_Traits>();
+    auto& d = mesh.dcel;
+    const auto h = d[mesh.faces[0]].incident;
+    const auto p = d[h].prev;
+
+    const auto w = d.add_vertex(h);
+    expect_consistent(d);
+    EXPECT_EQ(7, d.vertices_size());
+    EXPECT_EQ(6, loop_size(d, mesh.faces[0]));
+    EXPECT_EQ(d[h].origin, d[d[p].next].origin);
+    EXPECT_EQ(w, d[d[h].prev].origin);
+    EXPECT_EQ(d[w].incident, d[h].prev);
+
+    d.remove_vertex(w);
+    expect_consistent(d);
+    EXPECT_EQ(6, d.vertices_size());
+    EXPECT_EQ(14, d.half_edges_size());
+    EXPECT_EQ(p, d[h].prev);
+}
+
+TEST(DCELEditTest, RemoveLastEdge) {
+    // a single edge inside a face
+    dcel_vector d;
+    const auto f = d.create_face();
+    const auto u = d.create_vertex();
+    const auto v = d.create_vertex();
+    const auto a = d.create_half_edge();
+    const auto t = d.create_half_edge();
+    d[a] = {u, t, t, t, f};
+    d[t] = {v, a, a, a, f};
+    d[u].incident = a;
+    d[v].incident = t;
+    d[f].incident = a;
+
+    // v is left on its own in an empty face
+    d.remove_vertex(u);
+    EXPECT_EQ(1, d.vertices_size());
+    EXPECT_TRUE(d.half_edges_empty());
+    EXPECT_FALSE(d.is_consistent(v));
+    EXPECT_FALSE(d.is_consistent(f));
+}
+
+TEST(DCELDataTest, SideArrays) {
+    using traits = dcel_vector_data_Traits<vec2d, int, double, char>;
+    dcel<traits> d;
+    const auto v = d.create_vertex();
+    const auto h = d.create_half_edge();
+    const auto f = d.create_face();
+    EXPECT_EQ(0, d.data(v));
+    EXPECT_EQ(0.0, d.data(h));
+    EXPECT_EQ(0, d.data(f));
+
+    d.position(v) = vec2d(1, 2);
+    d.data(v) = 3;
+    d.data(h) = 4.5;
+    d.data(f) = 'f';
+    const auto& cd = d;
+    EXPECT_EQ(vec2d(1, 2), cd.position(v));
+    EXPECT_EQ(3, cd.data(v));
+    EXPECT_EQ(4.5, cd.data(h));
+    EXPECT_EQ('f', cd.data(f));
+
+    // a recycled slot starts over with default values
+    d.erase_vertex(v);
+    const auto w = d.create_vertex();
+    ASSERT_EQ(v, w);
+    EXPECT_EQ(0, d.data(w));
+}
+
+TEST(DCELDataTest, Geometry) {
+    using traits = dcel_vector_data_Traits<vec2d>;
+    vector<vec2d> points = { {0, 0}, {2, 0}, {2, 1}, {0, 1} };
+    auto mesh = dcel_from_polygons<traits>(points, vector<vector<int>>{ {0, 1, 2, 3} });
+    auto& d = mesh.dcel;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(points[i], d.position(mesh.vertices[i]));
+
+    EXPECT_EQ(2.0, face_area_2D(d, mesh.faces[0]));
+    EXPECT_EQ(-2.0, face_area_2D(d, mesh.outer_face));
+    const auto h = d[mesh.faces[0]].incident;
+    EXPECT_EQ(2.0, edge_length(d, h));
+    EXPECT_EQ(1.0, edge_length(d, d[h].next));
+    EXPECT_EQ(2.0, edge_length(d, d[h].twin));
+
+    // the vertex splitting an edge is placed on it, which keeps the area
+    const auto w = d.split_edge_at(h);
+    d.position(w) = vec2d(1, 0);
+    EXPECT_EQ(2.0, face_area_2D(d, mesh.faces[0]));
+    EXPECT_EQ(1.0, edge_length(d, h));
+}
@@ -0,0 +1,167 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace mtlib;
+using namespace mtlib::ds;
+using namespace std;
+
+namespace {
+
+// a triangle whose outer half-edges have no face
+template <typename Traits>
+dcel<Traits> triangle() {
+    dcel<Traits> d;
+    array<typename Traits::vertex_handle, 3> v;
+    array<typename Traits::half_edge_handle, 3> inner;
+    array<typename Traits::half_edge_handle, 3> outer;
+    for (int i = 0; i < 3; ++i) {
+        v[i] = d.create_vertex();
+        outer[i] = d.create_half_edge();
+        inner[i] = d.create_half_edge();
+    }
+    auto face = d.create_face();
+    d[face].incident = inner[1];
+
+    for (int i = 0; i < 3; ++i) {
+        const int next = (i + 1) % 3;
+        const int prev = (i + 2) % 3;
+        d[v[i]].incident = inner[i];
+        d[inner[i]].origin = d[outer[i]].origin = v[i];
+        d[inner[i]].twin = outer[next];
+        d[outer[next]].twin = inner[i];
+        d[inner[i]].next = inner[next];
+        d[inner[i]].prev = inner[prev];
+        d[outer[i]].next = outer[prev];
+        d[outer[i]].prev = outer[next];
+        d[inner[i]].face = face;
+    }
+    return d;
+}
+
+// every half-edge as the numbers of its end vertices, loop by loop and ring by ring, in the order of the iterators
+template <typename Dcel>
+pair<vector<pair<int, int>>, vector<pair<int, int>>> walk(const Dcel& d) {
+    map<typename Dcel::vertex_handle, int> number;
+    for (auto v = d.vertices_begin(); v != d.vertices_end(); ++v)
+        number.emplace(d.handle_of(*v), static_cast<int>(number.size()));
+    const auto ends = [&](const typename Dcel::half_edge& h) {
+        return make_pair(number[h.origin], number[d[h.twin].origin]);
+    };
+
+    pair<vector<pair<int, int>>, vector<pair<int, int>>> result;
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f) {
+        for (auto h = d.half_edge_loop_begin(f->incident); h != d.half_edge_loop_end(f->incident); ++h)
+            result.first.push_back(ends(*h));
+        for (auto h = d.half_edge_loop_rbegin(f->incident); h != d.half_edge_loop_rend(f->incident); ++h)
+            result.first.push_back(ends(*h));
+    }
+    for (auto v = d.vertices_begin(); v != d.vertices_end(); ++v) {
+        for (auto h = d.vertex_incident_begin(v->incident); h != d.vertex_incident_end(v->incident); ++h)
+            result.second.push_back(ends(*h));
+        for (auto h = d.vertex_incident_rbegin(v->incident); h != d.vertex_incident_rend(v->incident); ++h)
+            result.second.push_back(ends(*h));
+    }
+    return result;
+}
+
+}   // namespace
+
+TEST(FrozenDCELTest, Empty) {
+    const auto frozen = freeze(dcel_list());
+    EXPECT_TRUE(frozen.vertices_empty());
+    EXPECT_TRUE(frozen.half_edges_empty());
+    EXPECT_TRUE(frozen.faces_empty());
+}
+
+TEST(FrozenDCELTest, Layout) {
+    const auto d = triangle<dcel_list_Traits>();
+    const auto frozen = freeze(d);
+    ASSERT_EQ(3, frozen.vertices_size());
+    ASSERT_EQ(6, frozen.half_edges_size());
+    ASSERT_EQ(1, frozen.faces_size());
+
+    // the face loop comes first and starts at the incident half-edge, the outer half-edges follow
+    using half_edge_handle = frozen_dcel::half_edge_handle;
+    const frozen_dcel::face_handle face{0};
+    EXPECT_EQ(half_edge_handle{0}, frozen[face].incident);
+    const auto loop = frozen.face_half_edges(face);
+    ASSERT_EQ(3, loop.size());
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(half_edge_handle{i}, frozen.handle_of(loop[i]));
+        EXPECT_EQ(half_edge_handle{(i + 1) % 3}, loop[i].next);
+        EXPECT_EQ(half_edge_handle{(i + 2) % 3}, loop[i].prev);
+        EXPECT_EQ(face, loop[i].face);
+        EXPECT_EQ(frozen_dcel::vertex_handle{(i + 1) % 3}, loop[i].origin);
+    }
+    for (uint32_t i = 3; i < 6; ++i) {
+        EXPECT_EQ(frozen.null_face, frozen[half_edge_handle{i}].face);
+        EXPECT_FALSE(frozen.is_consistent(half_edge_handle{i}));
+        EXPECT_EQ(half_edge_handle{i}, frozen[frozen[half_edge_handle{i}].twin].twin);
+    }
+
+    // rings start at the incident half-edge of the vertex
+    for (auto v = frozen.vertices_begin(); v != frozen.vertices_end(); ++v) {
+        const auto ring = frozen.vertex_half_edges(frozen.handle_of(*v));
+        ASSERT_EQ(2, ring.size());
+        EXPECT_EQ(v->incident, ring[0]);
+        EXPECT_EQ(frozen.handle_of(*v), frozen[ring[1]].origin);
+    }
+
+    EXPECT_EQ(walk(d), walk(frozen));
+}
+
+TEST(FrozenDCELTest, IteratorsFromAnyHalfEdge) {
+    const auto frozen = freeze(triangle<dcel_vector_Traits>());
+    for (uint32_t i = 0; i < 6; ++i) {
+        const frozen_dcel::half_edge_handle h{i};
+        auto it = frozen.vertex_incident_begin(h);
+        EXPECT_EQ(h, it.handle());
+        EXPECT_EQ(frozen[frozen[h].prev].twin, (++it).handle());
+        EXPECT_EQ(frozen.vertex_incident_end(h), ++it);
+        EXPECT_EQ(frozen.null_half_edge, it.handle());
+
+        auto rit = frozen.vertex_incident_rbegin(h);
+        EXPECT_EQ(frozen[frozen[h].prev].twin, frozen.handle_of(*rit));
+        EXPECT_EQ(frozen.vertex_incident_rend(h), ++(++rit));
+    }
+}
+
+TEST(FrozenDCELTest, Arrangement) {
+    mt19937 gen(3);
+    uniform_real_distribution<double> dis(0, 60);
+    vector<segment2d> segments;
+    for (int i = 0; i < 120; ++i)
+        segments.emplace_back(vec2d(dis(gen), dis(gen)), vec2d(dis(gen), dis(gen)));
+
+    const auto list = snap_round_arrangement_2D(segments.begin(), segments.end(), 0.5);
+    const auto vector = snap_round_arrangement_2D<dcel_vector_Traits>(segments.begin(), segments.end(), 0.5);
+    const auto frozen = freeze(list.dcel);
+    ASSERT_EQ(list.dcel.half_edges_size(), frozen.half_edges_size());
+    EXPECT_EQ(walk(list.dcel), walk(frozen));
+    EXPECT_EQ(walk(vector.dcel), walk(freeze(vector.dcel)));
+
+    size_t n_half_edges = 0;
+    for (auto f = frozen.faces_begin(); f != frozen.faces_end(); ++f) {
+        const auto face = frozen.handle_of(*f);
+        const auto half_edges = frozen.face_half_edges(face);
+        EXPECT_EQ(f->incident, frozen.handle_of(half_edges[0]));
+        for (const auto& h : half_edges) {
+            EXPECT_TRUE(frozen.is_consistent(frozen.handle_of(h)));
+            EXPECT_EQ(face, h.face);
+        }
+        n_half_edges += half_edges.size();
+    }
+    EXPECT_EQ(frozen.half_edges_size(), n_half_edges);
+
+    n_half_edges = 0;
+    for (auto v = frozen.vertices_begin(); v != frozen.vertices_end(); ++v)
+        n_half_edges += frozen.vertex_half_edges(frozen.handle_of(*v)).size();
+    EXPECT_EQ(frozen.half_edges_size(), n_half_edges);
+}
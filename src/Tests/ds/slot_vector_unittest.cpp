@@ -0,0 +1,58 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <vector>
+
+using namespace mtlib;
+using namespace mtlib::ds;
+using namespace std;
+
+TEST(SlotVectorTest, Insert) {
+    slot_vector<int> v;
+    ASSERT_TRUE(v.empty());
+
+    for (int i = 0; i < 5; ++i)
+        ASSERT_EQ(static_cast<uint32_t>(i), v.insert(10 * i));
+    ASSERT_EQ(5, v.size());
+    ASSERT_EQ(30, v[3]);
+    ASSERT_EQ(3u, v.index_of(v[3]));
+    ASSERT_EQ(vector<int>({0, 10, 20, 30, 40}), vector<int>(v.begin(), v.end()));
+}
+
+TEST(SlotVectorTest, EraseReuses) {
+    slot_vector<int> v;
+    for (int i = 0; i < 5; ++i)
+        v.insert(i);
+
+    v.erase(0);
+    v.erase(3);
+    ASSERT_EQ(3, v.size());
+    ASSERT_EQ(5, v.slots());
+    ASSERT_FALSE(v.contains(0));
+    ASSERT_TRUE(v.contains(1));
+    ASSERT_EQ(4, v[4]);
+    ASSERT_EQ(vector<int>({1, 2, 4}), vector<int>(v.begin(), v.end()));
+    ASSERT_EQ(vector<int>({4, 2, 1}), vector<int>(v.rbegin(), v.rend()));
+
+    // the last freed slot is filled first, nothing else moves
+    ASSERT_EQ(3u, v.insert(7));
+    ASSERT_EQ(0u, v.insert(8));
+    ASSERT_EQ(5u, v.insert(9));
+    ASSERT_EQ(vector<int>({8, 1, 2, 7, 4, 9}), vector<int>(v.begin(), v.end()));
+}
+
+TEST(SlotVectorTest, EraseAll) {
+    slot_vector<int> v;
+    for (int i = 0; i < 3; ++i)
+        v.insert(i);
+    for (uint32_t i = 0; i < 3; ++i)
+        v.erase(i);
+
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.end(), v.begin());
+
+    const auto& cv = v;
+    ASSERT_EQ(0, distance(cv.begin(), cv.end()));
+}
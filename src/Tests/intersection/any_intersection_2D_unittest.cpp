@@ -0,0 +1,94 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+TEST(AnyIntersection2DTest, Empty) {
+    vector<segment2d> segments;
+    EXPECT_FALSE(any_intersection_2D(segments.begin(), segments.end()));
+}
+
+TEST(AnyIntersection2DTest, Disjoint) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(4, 0));
+    segments.emplace_back(vec2d(0, 1), vec2d(4, 2));
+    segments.emplace_back(vec2d(1, -1), vec2d(1, -3));
+    segments.emplace_back(vec2d(5, 0), vec2d(6, 5));
+
+    EXPECT_FALSE(any_intersection_2D(segments.begin(), segments.end()));
+}
+
+TEST(AnyIntersection2DTest, Crossing) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(4, 0));
+    segments.emplace_back(vec2d(0, 1), vec2d(4, 2));
+    segments.emplace_back(vec2d(2, -1), vec2d(3, 5));
+
+    EXPECT_TRUE(any_intersection_2D(segments.begin(), segments.end()));
+}
+
+TEST(AnyIntersection2DTest, SharedEndpoint) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(2, 2));
+    segments.emplace_back(vec2d(2, 2), vec2d(4, 0));
+
+    EXPECT_TRUE(any_intersection_2D(segments.begin(), segments.end()));
+}
+
+TEST(AnyIntersection2DTest, EndpointOnSegment) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(4, 0));
+    segments.emplace_back(vec2d(2, 0), vec2d(2, 3));
+
+    EXPECT_TRUE(any_intersection_2D(segments.begin(), segments.end()));
+}
+
+TEST(AnyIntersection2DTest, ZeroLength) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(0, 0));
+    EXPECT_FALSE(any_intersection_2D(segments.begin(), segments.end()));
+
+    segments.emplace_back(vec2d(1, 0), vec2d(3, 2));
+    segments.emplace_back(vec2d(2, 2), vec2d(2, 2));
+    EXPECT_FALSE(any_intersection_2D(segments.begin(), segments.end()));
+
+    // on the inside of a segment, at its endpoint, and on another zero-length segment
+    segments.emplace_back(vec2d(2, 1), vec2d(2, 1));
+    EXPECT_TRUE(any_intersection_2D(segments.begin(), segments.end()));
+    segments.back() = segment2d(vec2d(3, 2), vec2d(3, 2));
+    EXPECT_TRUE(any_intersection_2D(segments.begin(), segments.end()));
+    segments.back() = segment2d(vec2d(0, 0), vec2d(0, 0));
+    EXPECT_TRUE(any_intersection_2D(segments.begin(), segments.end()));
+}
+
+TEST(AnyIntersection2DTest, MatchesBruteForce) {
+    mt19937 gen(0);
+    uniform_int_distribution<int> dis(0, 20);
+
+    for (int round = 0; round < 500; ++round) {
+        vector<segment2d> segments;
+        for (int i = 0; i < 6; ++i) {
+            vec2d p1(dis(gen), dis(gen));
+            vec2d p2(dis(gen), dis(gen));
+            // zero-length segments too
+            segments.emplace_back(p1, (round + i) % 4 == 0 ? p1 : p2);
+        }
+
+        bool expected = false;
+        for (size_t i = 0; i < segments.size(); ++i) {
+            for (size_t j = i + 1; j < segments.size(); ++j)
+                expected = expected || overlap_segment_segment_2D(segments[i], segments[j]);
+        }
+
+        EXPECT_EQ(expected, any_intersection_2D(segments.begin(), segments.end())) << "round " << round;
+    }
+}
+
+}
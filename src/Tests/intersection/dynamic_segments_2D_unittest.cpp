@@ -0,0 +1,166 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+using pair_type = pair<uint32_t, uint32_t>;
+
+vector<pair_type> pairs_of(const intersection::dynamic_segments_2D<double>& set) {
+    vector<pair_type> result;
+    set.visit([&](uint32_t i, uint32_t j, const vec2d&) { result.emplace_back(i, j); });
+    sort(result.begin(), result.end());
+    return result;
+}
+
+vector<pair_type> brute_force(const intersection::dynamic_segments_2D<double>& set, uint32_t n_indices) {
+    vector<pair_type> result;
+    for (uint32_t i = 0; i < n_indices; ++i) {
+        for (uint32_t j = i + 1; j < n_indices; ++j) {
+            if (set.contains(i) && set.contains(j) && overlap_segment_segment_2D(set.segment(i), set.segment(j)))
+                result.emplace_back(i, j);
+        }
+    }
+    return result;
+}
+
+// endpoints on a small integer grid, so that many segments share endpoints or are colinear
+segment2d random_segment(mt19937& gen) {
+    uniform_int_distribution<int> dis(0, 30);
+    uniform_int_distribution<int> offset(-5, 5);
+    vec2d p(dis(gen), dis(gen));
+    vec2d q = p + vec2d(offset(gen), offset(gen));
+    if (p == q)
+        q = q + vec2d(1, 0);
+    return segment2d(p, q);
+}
+
+TEST(DynamicSegments2DTest, InsertErase) {
+    intersection::dynamic_segments_2D<double> set(1.0);
+    const auto a = set.insert(segment2d(vec2d(0, 0), vec2d(4, 4)));
+    const auto b = set.insert(segment2d(vec2d(0, 4), vec2d(4, 0)));
+    const auto c = set.insert(segment2d(vec2d(10, 0), vec2d(12, 0)));
+
+    EXPECT_EQ(3u, set.size());
+    EXPECT_EQ(1u, set.n_intersections());
+    ASSERT_EQ(1u, set.hits(a).size());
+    EXPECT_EQ(b, set.hits(a)[0].other);
+    EXPECT_EQ(vec2d(2, 2), set.hits(a)[0].point);
+    EXPECT_TRUE(set.hits(c).empty());
+
+    set.erase(b);
+    EXPECT_FALSE(set.contains(b));
+    EXPECT_EQ(2u, set.size());
+    EXPECT_EQ(0u, set.n_intersections());
+    EXPECT_TRUE(set.hits(a).empty());
+
+    // the index of an erased segment is reused
+    const auto d = set.insert(segment2d(vec2d(11, -1), vec2d(11, 1)));
+    EXPECT_EQ(b, d);
+    EXPECT_EQ(1u, set.n_intersections());
+    ASSERT_EQ(1u, set.hits(c).size());
+    EXPECT_EQ(vec2d(11, 0), set.hits(c)[0].point);
+}
+
+TEST(DynamicSegments2DTest, LongSegments) {
+    intersection::dynamic_segments_2D<double> set(0.5);
+    set.insert(segment2d(vec2d(-100, -30), vec2d(100, 70)));
+    set.insert(segment2d(vec2d(-100, 70), vec2d(100, -30)));
+    set.insert(segment2d(vec2d(0, -100), vec2d(0, 100)));
+
+    EXPECT_EQ(3u, set.n_intersections());
+}
+
+TEST(DynamicSegments2DTest, Points) {
+    // zero length segments have no mean length to size the cells by
+    vector<segment2d> points;
+    for (int i = 0; i < 20; ++i)
+        points.emplace_back(vec2d(i % 5, i / 5), vec2d(i % 5, i / 5));
+    points.emplace_back(vec2d(2, 2), vec2d(2, 2));
+
+    intersection::dynamic_segments_2D<double> set;
+    set.assign(points.begin(), points.end());
+    EXPECT_GT(set.cell_size(), 0.0);
+    EXPECT_TRUE(isfinite(set.cell_size()));
+    EXPECT_EQ(brute_force(set, 21), pairs_of(set));
+    EXPECT_EQ(1u, set.n_intersections());
+
+    // all at one point
+    vector<segment2d> same(3, segment2d(vec2d(7, -3), vec2d(7, -3)));
+    set.assign(same.begin(), same.end());
+    EXPECT_EQ(1.0, set.cell_size());
+    EXPECT_EQ(3u, set.n_intersections());
+}
+
+TEST(DynamicSegments2DTest, MatchesBruteForce) {
+    mt19937 gen(0);
+    vector<segment2d> initial;
+    for (int i = 0; i < 200; ++i)
+        initial.push_back(random_segment(gen));
+
+    intersection::dynamic_segments_2D<double> set;
+    set.assign(initial.begin(), initial.end());
+    EXPECT_EQ(brute_force(set, 200), pairs_of(set));
+
+    vector<uint32_t> live;
+    for (uint32_t i = 0; i < 200; ++i)
+        live.push_back(i);
+
+    for (int round = 0; round < 50; ++round) {
+        for (int edit = 0; edit < 10; ++edit) {
+            uniform_int_distribution<size_t> pick(0, live.size() - 1);
+            const auto k = pick(gen);
+            set.erase(live[k]);
+            live[k] = live.back();
+            live.pop_back();
+        }
+        for (int edit = 0; edit < 10; ++edit)
+            live.push_back(set.insert(random_segment(gen)));
+
+        const auto n_indices = *max_element(live.begin(), live.end()) + 1;
+        const auto expected = brute_force(set, n_indices);
+        ASSERT_EQ(expected, pairs_of(set));
+        EXPECT_EQ(expected.size(), set.n_intersections());
+    }
+}
+
+TEST(DynamicSegments2DTest, MatchesGrid) {
+    mt19937 gen(1);
+    uniform_real_distribution<double> dis(0, 100);
+    uniform_real_distribution<double> offset(-4, 4);
+
+    vector<segment2d> segments;
+    for (int i = 0; i < 2000; ++i) {
+        vec2d p(dis(gen), dis(gen));
+        segments.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+    }
+
+    intersection::dynamic_segments_2D<double> set;
+    set.assign(segments.begin(), segments.end());
+
+    // random segments meet in pairs, so every event of the grid is one pair
+    vector<uint32_t> indices;
+    vector<pair<vec2d, span<const uint32_t>>> events;
+    intersection::segment_grid_2D<double> grid;
+    grid(segments.begin(), segments.end(), indices, back_inserter(events));
+
+    vector<pair_type> expected;
+    for (const auto& [point, through] : events) {
+        ASSERT_EQ(2u, through.size());
+        expected.emplace_back(min(through[0], through[1]), max(through[0], through[1]));
+    }
+    sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, pairs_of(set));
+}
+
+}
@@ -0,0 +1,109 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+template <typename Scalar>
+class IntersectSegmentPairs2DTest : public ::testing::Test {
+protected:
+    // endpoints on a small integer grid, so that many pairs touch, share endpoints or are colinear
+    static vector<segment2<Scalar>> random_segments(size_t n, unsigned int seed) {
+        mt19937 gen(seed);
+        uniform_int_distribution<int> dis(0, 12);
+
+        vector<segment2<Scalar>> result;
+        for (size_t i = 0; i < n; ++i) {
+            vec2<Scalar> p1((Scalar)dis(gen), (Scalar)dis(gen));
+            vec2<Scalar> p2((Scalar)dis(gen), (Scalar)dis(gen));
+            if (p1 != p2)
+                result.emplace_back(p1, p2);
+        }
+        return result;
+    }
+
+    using hits_type = vector<intersection::pair_hit_2D<Scalar>>;
+
+    static void expect_hits(const hits_type& expected, const hits_type& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t h = 0; h < expected.size(); ++h) {
+            EXPECT_EQ(expected[h].pair, actual[h].pair);
+            EXPECT_EQ(expected[h].t1, actual[h].t1);
+            EXPECT_EQ(expected[h].t2, actual[h].t2);
+        }
+    }
+};
+
+using Scalars = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(IntersectSegmentPairs2DTest, Scalars);
+
+TYPED_TEST(IntersectSegmentPairs2DTest, MatchesScalarLoop) {
+    const auto segments = this->random_segments(300, 0);
+    const intersection::segments_soa_2D<TypeParam> soa(segments.begin(), segments.end());
+
+    mt19937 gen(1);
+    uniform_int_distribution<uint32_t> dis(0, static_cast<uint32_t>(segments.size() - 1));
+    vector<uint32_t> first;
+    vector<uint32_t> second;
+    for (int k = 0; k < 5003; ++k) {
+        first.push_back(dis(gen));
+        second.push_back(dis(gen));
+    }
+
+    vector<intersection::pair_hit_2D<TypeParam>> expected;
+    for (size_t k = 0; k < first.size(); ++k) {
+        const auto[result, success] = intersect_segment_segment_2D(segments[first[k]], segments[second[k]]);
+        if (success)
+            expected.push_back({static_cast<uint32_t>(k), result.t1, result.t2});
+    }
+    ASSERT_GT(expected.size(), 100u);
+
+    vector<intersection::pair_hit_2D<TypeParam>> actual;
+    intersect_segment_pairs_2D(soa, span<const uint32_t>(first), span<const uint32_t>(second), actual);
+    this->expect_hits(expected, actual);
+}
+
+#if defined(__AVX2__)
+TYPED_TEST(IntersectSegmentPairs2DTest, AVX2Kernel) {
+    ASSERT_STREQ("avx2", intersection::intersect_segment_pairs_isa());
+
+    const auto segments = this->random_segments(300, 2);
+    const intersection::segments_soa_2D<TypeParam> soa(segments.begin(), segments.end());
+    ASSERT_TRUE(intersection::fits_gather_indices_2D(soa));
+
+    // every segment against every other, so the gathers see the first and the last index in every lane
+    vector<uint32_t> first;
+    vector<uint32_t> second;
+    for (uint32_t i = 0; i < segments.size(); ++i) {
+        for (uint32_t j = 0; j < segments.size(); ++j) {
+            first.push_back(i);
+            second.push_back(j);
+        }
+    }
+
+    vector<intersection::pair_hit_2D<TypeParam>> expected;
+    for (size_t k = 0; k < first.size(); ++k) {
+        const auto[result, success] = intersect_segment_segment_2D(segments[first[k]], segments[second[k]]);
+        if (success)
+            expected.push_back({static_cast<uint32_t>(k), result.t1, result.t2});
+    }
+
+    // the kernel alone, without the scalar loop for the pairs after the last full block
+    vector<intersection::pair_hit_2D<TypeParam>> actual;
+    const auto n_blocked = intersection::intersect_segment_pairs_simd_2D(
+        soa, first.data(), second.data(), first.size(), actual);
+    ASSERT_EQ(first.size() - first.size() % (32 / sizeof(TypeParam)), n_blocked);
+    while (!expected.empty() && expected.back().pair >= n_blocked)
+        expected.pop_back();
+    this->expect_hits(expected, actual);
+}
+#endif
+
+}
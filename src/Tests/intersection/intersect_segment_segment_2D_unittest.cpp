@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <random>
+
 using namespace mtlib;
 using namespace std;
 
@@ -123,4 +126,68 @@ TEST(IntersectSegmentSegment2DTest, NoOverlapColinear) {
 
     const auto [result, success] = intersect_segment_segment_2D(s1, s2);
     ASSERT_FALSE(success);
-}
\ No newline at end of file
+}
+// Integer coordinates
+
+TEST(IntersectSegmentSegment2DTest, Integer) {
+    segment2<int32_t> s1 = { {0, 0}, {10, 10} };
+    segment2<int32_t> s2 = { {0, 10}, {10, 0} };
+
+    auto [result, success] = intersect_segment_segment_2D(s1, s2);
+    ASSERT_TRUE(success);
+    EXPECT_EQ(vec2<int32_t>(5, 5), result.point);
+    EXPECT_EQ(0.5, result.t1);
+    EXPECT_EQ(0.5, result.t2);
+
+    // crossing at (10/3, 10/3), snapped to the nearest integer point
+    s2 = { {0, 5}, {5, 2} };
+    std::tie(result, success) = intersect_segment_segment_2D(s1, s2);
+    ASSERT_TRUE(success);
+    EXPECT_EQ(vec2<int32_t>(3, 3), result.point);
+
+    // touching at an end point
+    s2 = { {10, 10}, {20, 0} };
+    std::tie(result, success) = intersect_segment_segment_2D(s1, s2);
+    ASSERT_TRUE(success);
+    EXPECT_EQ(vec2<int32_t>(10, 10), result.point);
+    EXPECT_EQ(1, result.t1);
+    EXPECT_EQ(0, result.t2);
+
+    // one unit past the end
+    s2 = { {11, 10}, {20, 0} };
+    EXPECT_FALSE(overlap_segment_segment_2D(s1, s2));
+    EXPECT_FALSE(intersect_segment_segment_2D(s1, s2).second);
+}
+
+TEST(IntersectSegmentSegment2DTest, IntegerSnapping) {
+    // the 32 and 64 bit kernels round the same crossings the same way, and the 64 bit one agrees with itself at a
+    // scale where it needs its long division
+    mt19937 gen(0);
+    uniform_int_distribution<int32_t> dis(-(1 << 29), 1 << 29);
+    const int64_t scale = (int64_t)1 << 31;
+    int n_crossings = 0;
+    for (int i = 0; i < 2000; ++i) {
+        const segment2<int32_t> s1 = { {dis(gen), dis(gen)}, {dis(gen), dis(gen)} };
+        const segment2<int32_t> s2 = { {dis(gen), dis(gen)}, {dis(gen), dis(gen)} };
+        auto wide = [](const segment2<int32_t>& s, int64_t f) {
+            return segment2<int64_t>({ {s[0][0] * f, s[0][1] * f}, {s[1][0] * f, s[1][1] * f} });
+        };
+
+        const auto narrow_result = intersect_segment_segment_2D(s1, s2);
+        const auto wide_result = intersect_segment_segment_2D(wide(s1, 1), wide(s2, 1));
+        const auto scaled_result = intersect_segment_segment_2D(wide(s1, scale), wide(s2, scale));
+        ASSERT_EQ(narrow_result.second, wide_result.second);
+        ASSERT_EQ(narrow_result.second, scaled_result.second);
+        if (!narrow_result.second)
+            continue;
+        ++n_crossings;
+
+        const auto& p = narrow_result.first.point;
+        const auto& q = scaled_result.first.point;
+        EXPECT_EQ(vec2<int64_t>(p[0], p[1]), wide_result.first.point);
+        // the scaled crossing rounds to within half a unit of the scaled rounded one
+        EXPECT_LE(abs(q[0] - p[0] * scale), scale / 2 + 1);
+        EXPECT_LE(abs(q[1] - p[1] * scale), scale / 2 + 1);
+    }
+    EXPECT_GT(n_crossings, 100);
+}
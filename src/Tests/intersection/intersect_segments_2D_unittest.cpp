@@ -2,7 +2,11 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdio>  // remove
+#include <random>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -107,4 +111,223 @@ TEST_F(IntersectSegments2DTest, TriangleOverlaps) {
 
     for (auto& intersection : intersections)
         EXPECT_NE(intersection.second[0], intersection.second[1]);
-}
\ No newline at end of file
+}
+
+class IntersectSegments2DRandomTest : public ::testing::Test {
+protected:
+    static vector<segment2d> random_segments(size_t n, unsigned int seed) {
+        mt19937 gen(seed);
+        uniform_real_distribution<double> dis(0.0, 100.0);
+
+        vector<segment2d> result;
+        result.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            result.emplace_back(vec2d(dis(gen), dis(gen)), vec2d(dis(gen), dis(gen)));
+        return result;
+    }
+};
+
+TEST_F(IntersectSegments2DRandomTest, MatchesBruteForce) {
+    const auto segments = random_segments(200, 7);
+
+    vector<pair<vec2d, std::vector<segment2d>>> intersections;
+    intersect_segments_2D(segments.begin(), segments.end(), back_inserter(intersections));
+
+    size_t expected = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        for (size_t j = i + 1; j < segments.size(); ++j) {
+            if (intersect_segment_segment_2D(segments[i], segments[j]).second)
+                ++expected;
+        }
+    }
+
+    // random segments are in general position, so every event is a single pair
+    EXPECT_EQ(expected, intersections.size());
+    for (auto& intersection : intersections)
+        EXPECT_EQ(2, intersection.second.size());
+}
+
+TEST_F(IntersectSegments2DRandomTest, ConcurrentSweeps) {
+    const size_t n_threads = std::max(4u, std::thread::hardware_concurrency());
+    const size_t n_rounds = 4;
+
+    vector<vector<segment2d>> tiles;
+    vector<vector<pair<vec2d, std::vector<segment2d>>>> expected(n_threads);
+    for (size_t i = 0; i < n_threads; ++i) {
+        tiles.push_back(random_segments(150, i));
+        intersect_segments_2D(tiles[i].begin(), tiles[i].end(), back_inserter(expected[i]));
+    }
+
+    for (size_t round = 0; round < n_rounds; ++round) {
+        vector<vector<pair<vec2d, std::vector<segment2d>>>> actual(n_threads);
+        vector<thread> threads;
+        for (size_t i = 0; i < n_threads; ++i) {
+            threads.emplace_back([&, i]() {
+                intersection::segment_sweep_2D<double> sweep;
+                sweep(tiles[i].begin(), tiles[i].end(), back_inserter(actual[i]));
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        for (size_t i = 0; i < n_threads; ++i)
+            EXPECT_EQ(expected[i], actual[i]) << "tile " << i << " round " << round;
+    }
+}
+
+TEST_F(IntersectSegments2DRandomTest, ReusedEngine) {
+    intersection::segment_sweep_2D<double> sweep;
+
+    // larger and smaller inputs in turn, so the second sweep of each size runs on recycled storage
+    for (size_t n : {200, 50, 200, 120}) {
+        auto segments = random_segments(n, n);
+
+        vector<pair<vec2d, std::vector<segment2d>>> expected;
+        intersect_segments_2D(segments.begin(), segments.end(), back_inserter(expected));
+
+        vector<pair<vec2d, std::vector<segment2d>>> actual;
+        sweep(segments.begin(), segments.end(), back_inserter(actual));
+
+        EXPECT_EQ(expected, actual) << n << " segments";
+    }
+}
+
+TEST_F(IntersectSegments2DRandomTest, Indices) {
+    auto segments = random_segments(200, 7);
+
+    vector<pair<vec2d, std::vector<segment2d>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), back_inserter(expected));
+
+    vector<intersection::segment_index> indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> actual;
+    intersect_segments_2D(segments.begin(), segments.end(), indices, back_inserter(actual));
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].first, actual[i].first);
+        ASSERT_TRUE(std::is_sorted(actual[i].second.begin(), actual[i].second.end()));
+
+        vector<segment2d> by_index;
+        for (auto idx : actual[i].second)
+            by_index.push_back(segments[idx]);
+        std::sort(by_index.begin(), by_index.end());
+        EXPECT_EQ(expected[i].second, by_index);
+    }
+}
+
+TEST_F(IntersectSegments2DRandomTest, Visitor) {
+    auto segments = random_segments(200, 11);
+
+    vector<intersection::segment_index> indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), indices, back_inserter(expected));
+    ASSERT_GT(expected.size(), 2u);
+
+    size_t count = 0;
+    EXPECT_TRUE(visit_intersections_2D(segments.begin(), segments.end(),
+        [&](const vec2d& point, span<const intersection::segment_index> through) {
+            ASSERT_LT(count, expected.size());
+            EXPECT_EQ(expected[count].first, point);
+            EXPECT_TRUE(std::equal(through.begin(), through.end(),
+                expected[count].second.begin(), expected[count].second.end()));
+            ++count;
+        }
+    ));
+    EXPECT_EQ(expected.size(), count);
+
+    count = 0;
+    EXPECT_FALSE(visit_intersections_2D(segments.begin(), segments.end(),
+        [&](const vec2d&, span<const intersection::segment_index>) {
+            return ++count < 2;
+        }
+    ));
+    EXPECT_EQ(2u, count);
+}
+
+TEST_F(IntersectSegments2DRandomTest, Generator) {
+    auto segments = random_segments(200, 13);
+
+    vector<intersection::segment_index> indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), indices, back_inserter(expected));
+
+    intersection::segment_sweep_2D<double> sweep;
+    sweep.start(segments.begin(), segments.end());
+    for (const auto& event : expected) {
+        ASSERT_TRUE(sweep.next());
+        EXPECT_EQ(event.first, sweep.point());
+        EXPECT_TRUE(std::equal(sweep.indices().begin(), sweep.indices().end(),
+            event.second.begin(), event.second.end()));
+    }
+    EXPECT_FALSE(sweep.next());
+    EXPECT_FALSE(sweep.next());
+
+    // restarting abandons the unswept remainder
+    sweep.start(segments.begin(), segments.end());
+    ASSERT_TRUE(sweep.next());
+    sweep.start(segments.begin(), segments.end());
+    ASSERT_TRUE(sweep.next());
+    EXPECT_EQ(expected.front().first, sweep.point());
+}
+
+TEST_F(IntersectSegments2DRandomTest, Parallel) {
+    auto segments = random_segments(200, 17);
+
+    vector<pair<vec2d, std::vector<segment2d>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), back_inserter(expected));
+
+    vector<intersection::segment_index> expected_indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> expected_by_index;
+    intersect_segments_2D(segments.begin(), segments.end(), expected_indices, back_inserter(expected_by_index));
+
+    for (size_t n_threads : {1, 2, 3, 8}) {
+        vector<pair<vec2d, std::vector<segment2d>>> actual;
+        intersect_segments_parallel_2D(segments.begin(), segments.end(), back_inserter(actual), n_threads);
+        EXPECT_EQ(expected, actual) << n_threads << " threads";
+
+        vector<intersection::segment_index> indices;
+        vector<pair<vec2d, span<const intersection::segment_index>>> by_index;
+        intersect_segments_parallel_2D(segments.begin(), segments.end(), indices, back_inserter(by_index), n_threads);
+        ASSERT_EQ(expected_by_index.size(), by_index.size());
+        for (size_t i = 0; i < expected_by_index.size(); ++i) {
+            EXPECT_EQ(expected_by_index[i].first, by_index[i].first);
+            EXPECT_TRUE(std::equal(by_index[i].second.begin(), by_index[i].second.end(),
+                expected_by_index[i].second.begin(), expected_by_index[i].second.end()));
+        }
+    }
+}
+
+TEST_F(IntersectSegments2DRandomTest, External) {
+    auto segments = random_segments(200, 29);
+
+    vector<intersection::segment_index> expected_indices;
+    vector<pair<vec2d, span<const intersection::segment_index>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), expected_indices, back_inserter(expected));
+
+    const auto segment_path = ::testing::TempDir() + "external_segments.bin";
+    const auto report_path = ::testing::TempDir() + "external_reports.bin";
+    ASSERT_TRUE(write_segments_2D(segment_path, segments.begin(), segments.end()));
+
+    // from many small runs and slabs to everything in memory
+    for (size_t budget : {16384, 1 << 24}) {
+        ASSERT_TRUE(intersect_segments_external_2D<double>(segment_path, report_path, budget));
+
+        size_t i = 0;
+        ASSERT_TRUE(visit_intersection_reports_2D<double>(report_path,
+            [&](const vec2d& point, span<const intersection::segment_index> through) {
+                ASSERT_LT(i, expected.size());
+                EXPECT_EQ(expected[i].first, point);
+                vector<intersection::segment_index> lhs(expected[i].second.begin(), expected[i].second.end());
+                vector<intersection::segment_index> rhs(through.begin(), through.end());
+                sort(lhs.begin(), lhs.end());
+                sort(rhs.begin(), rhs.end());
+                EXPECT_EQ(lhs, rhs);
+                ++i;
+            }
+        ));
+        EXPECT_EQ(expected.size(), i) << budget << " bytes";
+    }
+
+    remove(segment_path.c_str());
+    remove(report_path.c_str());
+}
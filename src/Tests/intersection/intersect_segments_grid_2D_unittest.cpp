@@ -0,0 +1,152 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+vector<segment2d> random_segments(size_t n, double length, unsigned int seed) {
+    mt19937 gen(seed);
+    uniform_real_distribution<double> dis(0.0, 100.0);
+    uniform_real_distribution<double> offset(-length, length);
+
+    vector<segment2d> result;
+    for (size_t i = 0; i < n; ++i) {
+        vec2d p(dis(gen), dis(gen));
+        result.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+    }
+    return result;
+}
+
+TEST(IntersectSegmentsGrid2DTest, Empty) {
+    vector<segment2d> segments;
+    vector<pair<vec2d, vector<segment2d>>> intersections;
+    intersect_segments_grid_2D(segments.begin(), segments.end(), back_inserter(intersections));
+    EXPECT_TRUE(intersections.empty());
+}
+
+TEST(IntersectSegmentsGrid2DTest, Colinear) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(2, 2));
+    segments.emplace_back(vec2d(3, 3), vec2d(1, 1));
+    segments.emplace_back(vec2d(0, 2), vec2d(2, 0));
+
+    vector<pair<vec2d, vector<segment2d>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), back_inserter(expected));
+
+    vector<pair<vec2d, vector<segment2d>>> actual;
+    intersect_segments_grid_2D(segments.begin(), segments.end(), back_inserter(actual));
+
+    ASSERT_EQ(2u, actual.size());
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(IntersectSegmentsGrid2DTest, MatchesSweep) {
+    intersection::segment_grid_2D<double> grid;
+    for (double length : {1.0, 5.0, 40.0}) {
+        auto segments = random_segments(400, length, 3);
+
+        vector<pair<vec2d, vector<segment2d>>> expected;
+        intersect_segments_2D(segments.begin(), segments.end(), back_inserter(expected));
+
+        vector<pair<vec2d, vector<segment2d>>> actual;
+        grid(segments.begin(), segments.end(), back_inserter(actual));
+        EXPECT_EQ(expected, actual) << "length " << length;
+
+        vector<intersection::segment_index> indices;
+        vector<pair<vec2d, span<const intersection::segment_index>>> by_index;
+        grid(segments.begin(), segments.end(), indices, back_inserter(by_index));
+        ASSERT_EQ(expected.size(), by_index.size());
+    }
+}
+
+TEST(IntersectSegmentsGrid2DTest, Lattice) {
+    // alternately horizontal and vertical, with integer endpoints on a lattice finer than the cells
+    mt19937 gen(13);
+    uniform_int_distribution<int> coordinate(0, 30);
+    uniform_int_distribution<int> length(1, 8);
+    vector<segment2d> segments;
+    for (int i = 0; i < 600; ++i) {
+        vec2d p(coordinate(gen), coordinate(gen));
+        const double l = length(gen);
+        segments.emplace_back(p, p + (i % 2 == 0 ? vec2d(l, 0.0) : vec2d(0.0, l)));
+    }
+
+    vector<pair<vec2d, vector<segment2d>>> expected;
+    intersect_segments_2D(segments.begin(), segments.end(), back_inserter(expected));
+
+    vector<pair<vec2d, vector<segment2d>>> actual;
+    intersect_segments_grid_2D(segments.begin(), segments.end(), back_inserter(actual));
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(IntersectSegmentsGrid2DTest, MergesRoundedPoints) {
+    // endpoints on a grid of step 0.1, which is not representable, so concurrent segments cross at rounded points
+    mt19937 gen(11);
+    uniform_int_distribution<int> coordinate(0, 20);
+    intersection::segment_grid_2D<double> grid;
+    for (int round = 0; round < 20; ++round) {
+        vector<segment2d> segments;
+        for (int i = 0; i < 200; ++i) {
+            vec2d p(0.1 * coordinate(gen), 0.1 * coordinate(gen));
+            vec2d q(0.1 * coordinate(gen), 0.1 * coordinate(gen));
+            segments.emplace_back(p, q);
+        }
+
+        vector<intersection::segment_index> indices;
+        vector<pair<vec2d, span<const intersection::segment_index>>> events;
+        grid(segments.begin(), segments.end(), indices, back_inserter(events));
+
+        // no segment is left at two points that round to each other, wherever their cells are
+        for (size_t i = 0; i < events.size(); ++i) {
+            for (size_t j = i + 1; j < events.size(); ++j) {
+                if (!intersection::rounds_to_2D(events[i].first, events[j].first))
+                    continue;
+                for (auto segment : events[i].second) {
+                    EXPECT_FALSE(std::binary_search(events[j].second.begin(), events[j].second.end(), segment))
+                        << "round " << round << ", segment " << segment;
+                }
+            }
+        }
+    }
+}
+
+TEST(IntersectSegmentsGrid2DTest, Auto) {
+    auto short_segments = random_segments(2000, 1.0, 5);
+    EXPECT_TRUE(intersection::prefer_grid_2D(short_segments.begin(), short_segments.end()));
+
+    // long horizontal lines share every cell but never cross
+    mt19937 gen(7);
+    uniform_real_distribution<double> dis(0.0, 100.0);
+    vector<segment2d> hatch;
+    for (int i = 0; i < 2000; ++i) {
+        vec2d p(dis(gen), dis(gen));
+        hatch.emplace_back(p, p + vec2d(80.0, 0.0));
+    }
+    EXPECT_FALSE(intersection::prefer_grid_2D(hatch.begin(), hatch.end()));
+
+    // crossing axis-aligned lines with integer endpoints, where dozens of segments meet at every lattice point
+    uniform_int_distribution<int> coordinate(0, 40);
+    vector<segment2d> lattice;
+    for (int i = 0; i < 4000; ++i) {
+        vec2d p(coordinate(gen), coordinate(gen));
+        lattice.emplace_back(p, p + (i % 2 == 0 ? vec2d(10.0, 0.0) : vec2d(0.0, 10.0)));
+    }
+    EXPECT_FALSE(intersection::prefer_grid_2D(lattice.begin(), lattice.end()));
+
+    for (const auto* segments : {&short_segments, &hatch, &lattice}) {
+        vector<pair<vec2d, vector<segment2d>>> expected;
+        intersect_segments_2D(segments->begin(), segments->end(), back_inserter(expected));
+
+        vector<pair<vec2d, vector<segment2d>>> actual;
+        intersect_segments_auto_2D(segments->begin(), segments->end(), back_inserter(actual));
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+}
@@ -0,0 +1,226 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+using arrangement_type = arrangement_2D<double>;
+
+// checks the links of every half-edge, returns the edges as segments between the vertex positions
+vector<segment2d> check_links(arrangement_type& arrangement) {
+    auto& d = arrangement.dcel;
+    map<const ds::dcel_list::vertex*, size_t> index;
+    for (size_t i = 0; i < arrangement.vertices.size(); ++i)
+        index[arrangement.vertices[i]] = i;
+    EXPECT_EQ(arrangement.points.size(), arrangement.vertices.size());
+    EXPECT_EQ(d.vertices_size(), arrangement.vertices.size());
+
+    for (auto v = d.vertices_begin(); v != d.vertices_end(); ++v) {
+        EXPECT_TRUE(d.is_consistent(&*v));
+        EXPECT_EQ(&*v, v->incident->origin);
+    }
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f) {
+        EXPECT_TRUE(d.is_consistent(&*f));
+        EXPECT_EQ(&*f, f->incident->face);
+    }
+
+    vector<segment2d> edges;
+    for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h) {
+        EXPECT_TRUE(d.is_consistent(&*h));
+        EXPECT_NE(&*h, h->twin);
+        EXPECT_EQ(&*h, h->twin->twin);
+        EXPECT_EQ(&*h, h->next->prev);
+        EXPECT_EQ(&*h, h->prev->next);
+        EXPECT_EQ(h->twin->origin, h->next->origin);
+        EXPECT_EQ(h->face, h->next->face);
+        if (index[h->origin] < index[h->twin->origin])
+            edges.emplace_back(arrangement.points[index[h->origin]], arrangement.points[index[h->twin->origin]]);
+    }
+    return edges;
+}
+
+// number of connected components of the edges
+size_t components(const arrangement_type& arrangement, const vector<segment2d>& edges) {
+    map<vec2d, size_t> index;
+    for (size_t i = 0; i < arrangement.points.size(); ++i)
+        index[arrangement.points[i]] = i;
+    vector<size_t> parent(arrangement.points.size());
+    iota(parent.begin(), parent.end(), 0);
+    auto find = [&](size_t i) {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    size_t n = parent.size();
+    for (const auto& edge : edges) {
+        const auto a = find(index[edge[0]]);
+        const auto b = find(index[edge[1]]);
+        if (a != b) {
+            parent[a] = b;
+            --n;
+        }
+    }
+    return n;
+}
+
+}   // namespace
+
+TEST(SnapRoundArrangement2DTest, Empty) {
+    vector<segment2d> segments;
+    auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+    EXPECT_TRUE(arrangement.dcel.vertices_empty());
+    EXPECT_TRUE(arrangement.dcel.half_edges_empty());
+    EXPECT_TRUE(arrangement.dcel.faces_empty());
+}
+
+TEST(SnapRoundArrangement2DTest, Cross) {
+    vector<segment2d> segments = { { {-2, -2}, {2, 2} }, { {-2, 2}, {2, -2} } };
+    auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+
+    const auto edges = check_links(arrangement);
+    EXPECT_EQ(5, arrangement.dcel.vertices_size());
+    EXPECT_EQ(8, arrangement.dcel.half_edges_size());
+    // a tree has a single boundary
+    EXPECT_EQ(1, arrangement.dcel.faces_size());
+    EXPECT_EQ(4, edges.size());
+}
+
+TEST(SnapRoundArrangement2DTest, Faces) {
+    // a square split by a diagonal, with the intersection point of the diagonal and a crossing segment off the grid
+    vector<segment2d> segments = {
+        { {0, 0}, {4, 0} }, { {4, 0}, {4, 4} }, { {4, 4}, {0, 4} }, { {0, 4}, {0, 0} },
+        { {0, 0}, {4, 4} }, { {0.2, 3.1}, {3.3, 0.3} }
+    };
+    auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+
+    const auto edges = check_links(arrangement);
+    for (const auto& point : arrangement.points) {
+        EXPECT_EQ(round(point[0]), point[0]);
+        EXPECT_EQ(round(point[1]), point[1]);
+    }
+    EXPECT_EQ(edges.size() - arrangement.vertices.size() + 2, arrangement.dcel.faces_size());
+
+    // the outer boundary is clockwise, every other face counter-clockwise
+    map<const ds::dcel_list::vertex*, vec2d> position;
+    for (size_t i = 0; i < arrangement.vertices.size(); ++i)
+        position[arrangement.vertices[i]] = arrangement.points[i];
+    int n_clockwise = 0;
+    auto& d = arrangement.dcel;
+    for (auto f = d.faces_begin(); f != d.faces_end(); ++f) {
+        double area = 0;
+        for (auto h = d.half_edge_loop_begin(f->incident); h != d.half_edge_loop_end(f->incident); ++h)
+            area += dot_perp(position[h->origin], position[h->twin->origin]);
+        EXPECT_NE(0, area);
+        n_clockwise += area < 0;
+    }
+    EXPECT_EQ(1, n_clockwise);
+}
+
+TEST(SnapRoundArrangement2DTest, Collapse) {
+    // nearly parallel segments a fraction of a pixel apart snap onto the same edge
+    vector<segment2d> segments = { { {0, 0}, {10, 0.1} }, { {0, 0.2}, {10, 0.3} } };
+    auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+
+    check_links(arrangement);
+    EXPECT_EQ(2, arrangement.dcel.vertices_size());
+    EXPECT_EQ(2, arrangement.dcel.half_edges_size());
+    EXPECT_EQ(vec2d(0, 0), arrangement.points[0]);
+    EXPECT_EQ(vec2d(10, 0), arrangement.points[1]);
+}
+
+TEST(SnapRoundArrangement2DTest, HotPixel) {
+    // a segment passing through the pixel of another one's endpoint is routed through its centre
+    vector<segment2d> segments = { { {0, 0}, {10, 0.4} }, { {5, 0.1}, {5, 8} } };
+    auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+
+    check_links(arrangement);
+    EXPECT_EQ(4, arrangement.dcel.vertices_size());
+    EXPECT_EQ(6, arrangement.dcel.half_edges_size());
+}
+
+TEST(SnapRoundArrangement2DTest, Grazing) {
+    // through the corner (0.5, 0.5) of the hot pixel (0, 0), so routed through its centre
+    vector<segment2d> segments = { { {0, 0}, {0, -3} }, { {-0.5, 1.5}, {1.5, -0.5} } };
+    auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+    check_links(arrangement);
+    EXPECT_EQ(4, arrangement.dcel.vertices_size());
+    EXPECT_EQ(6, arrangement.dcel.half_edges_size());
+
+    // stops on the side x = 0.5 of the pixel (0, 0) from outside, so does not pass through it
+    segments[1] = segment2d(vec2d(3, 0.25), vec2d(0.5, 0.25));
+    arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), 1.0);
+    check_links(arrangement);
+    EXPECT_EQ(4, arrangement.dcel.vertices_size());
+    EXPECT_EQ(4, arrangement.dcel.half_edges_size());
+}
+
+TEST(SnapRoundArrangement2DTest, Random) {
+    mt19937 gen(1);
+    uniform_real_distribution<double> dis(0, 100);
+    uniform_real_distribution<double> offset(-20, 20);
+    for (double pixel_size : {0.5, 1.0, 4.0}) {
+        vector<segment2d> segments;
+        for (int i = 0; i < 150; ++i) {
+            const vec2d p(dis(gen), dis(gen));
+            segments.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+        }
+        auto arrangement = snap_round_arrangement_2D(segments.begin(), segments.end(), pixel_size);
+
+        const auto edges = check_links(arrangement);
+        EXPECT_EQ(edges.size() - arrangement.vertices.size() + 2 * components(arrangement, edges),
+            arrangement.dcel.faces_size());
+
+        // the edges only meet at shared endpoints
+        for (size_t i = 0; i < edges.size(); ++i) {
+            for (size_t j = i + 1; j < edges.size(); ++j) {
+                const auto& a = edges[i];
+                const auto& b = edges[j];
+                const bool shared = a[0] == b[0] || a[0] == b[1] || a[1] == b[0] || a[1] == b[1];
+                if (!shared) {
+                    EXPECT_FALSE(overlap_segment_segment_2D(a, b, adaptive_predicates())) << a << " " << b;
+                }
+                else {
+                    const auto& apex = a[0] == b[0] || a[0] == b[1] ? a[0] : a[1];
+                    const auto& p = a[0] == apex ? a[1] : a[0];
+                    const auto& q = b[0] == apex ? b[1] : b[0];
+                    const bool same_direction = adaptive_predicates::orientation_2D(apex, p, q) == 0 &&
+                        (p[0] - apex[0]) * (q[0] - apex[0]) + (p[1] - apex[1]) * (q[1] - apex[1]) > 0;
+                    EXPECT_FALSE(same_direction) << a << " " << b;
+                }
+            }
+        }
+    }
+}
+
+TEST(SnapRoundArrangement2DTest, VectorTraits) {
+    mt19937 gen(2);
+    uniform_real_distribution<double> dis(0, 50);
+    vector<segment2d> segments;
+    for (int i = 0; i < 100; ++i)
+        segments.emplace_back(vec2d(dis(gen), dis(gen)), vec2d(dis(gen), dis(gen)));
+
+    auto list = snap_round_arrangement_2D(segments.begin(), segments.end(), 0.5);
+    auto vector = snap_round_arrangement_2D<ds::dcel_vector_Traits>(segments.begin(), segments.end(), 0.5);
+    EXPECT_EQ(list.points, vector.points);
+    EXPECT_EQ(list.dcel.half_edges_size(), vector.dcel.half_edges_size());
+    EXPECT_EQ(list.dcel.faces_size(), vector.dcel.faces_size());
+
+    auto& d = vector.dcel;
+    for (auto h = d.half_edges_begin(); h != d.half_edges_end(); ++h) {
+        const auto handle = d.handle_of(*h);
+        EXPECT_TRUE(d.is_consistent(handle));
+        EXPECT_EQ(handle, d[d[handle].twin].twin);
+        EXPECT_EQ(handle, d[d[handle].next].prev);
+        EXPECT_EQ(d[d[handle].twin].origin, d[d[handle].next].origin);
+    }
+}
@@ -0,0 +1,142 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+using pair_type = pair<uint32_t, uint32_t>;
+
+template <typename T>
+vector<pair_type> brute_force(const vector<T>& objects) {
+    vector<pair_type> result;
+    for (uint32_t i = 0; i < objects.size(); ++i) {
+        for (uint32_t j = i + 1; j < objects.size(); ++j) {
+            if (overlap_aabb_aabb(bounding_box(objects[i]), bounding_box(objects[j])))
+                result.emplace_back(i, j);
+        }
+    }
+    return result;
+}
+
+vector<pair_type> sorted(vector<pair_type> pairs) {
+    sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+// endpoints on a small integer grid, so that many boxes touch
+vector<segment2d> random_segments(size_t n, mt19937& gen) {
+    uniform_int_distribution<int> dis(0, 40);
+    uniform_int_distribution<int> offset(-4, 4);
+
+    vector<segment2d> result;
+    for (size_t i = 0; i < n; ++i) {
+        vec2d p(dis(gen), dis(gen));
+        result.emplace_back(p, p + vec2d(offset(gen), offset(gen)));
+    }
+    return result;
+}
+
+TEST(SweepAndPrune2DTest, Empty) {
+    vector<segment2d> segments;
+    vector<pair_type> pairs;
+    overlapping_boxes_2D(segments.begin(), segments.end(), back_inserter(pairs));
+    EXPECT_TRUE(pairs.empty());
+}
+
+TEST(SweepAndPrune2DTest, Touching) {
+    vector<segment2d> segments;
+    segments.emplace_back(vec2d(0, 0), vec2d(2, 2));
+    segments.emplace_back(vec2d(2, 2), vec2d(4, 0));
+    segments.emplace_back(vec2d(5, 0), vec2d(6, 1));
+    segments.emplace_back(vec2d(0, 3), vec2d(4, 3));
+
+    vector<pair_type> pairs;
+    overlapping_boxes_2D(segments.begin(), segments.end(), back_inserter(pairs));
+    EXPECT_EQ(vector<pair_type>({{0, 1}}), sorted(pairs));
+}
+
+TEST(SweepAndPrune2DTest, Axis) {
+    vector<segment2d> segments;
+    for (int i = 0; i < 10; ++i)
+        segments.emplace_back(vec2d(0, 3 * i), vec2d(1, 3 * i + 1));
+
+    intersection::sweep_and_prune_2D<double> sap;
+    sap.build(segments.begin(), segments.end());
+    EXPECT_EQ(1u, sap.axis());
+
+    vector<pair_type> pairs;
+    sap.pairs(back_inserter(pairs));
+    EXPECT_TRUE(pairs.empty());
+}
+
+TEST(SweepAndPrune2DTest, MatchesBruteForce) {
+    mt19937 gen(0);
+    for (int round = 0; round < 20; ++round) {
+        const auto segments = random_segments(200, gen);
+
+        vector<pair_type> pairs;
+        overlapping_boxes_2D(segments.begin(), segments.end(), back_inserter(pairs));
+        EXPECT_EQ(brute_force(segments), sorted(pairs));
+    }
+}
+
+TEST(SweepAndPrune2DTest, Polygons) {
+    mt19937 gen(1);
+    uniform_real_distribution<double> dis(0, 50);
+    uniform_real_distribution<double> offset(-3, 3);
+
+    vector<aabb2d> boxes;
+    for (int i = 0; i < 300; ++i) {
+        const vec2d centre(dis(gen), dis(gen));
+        vector<vec2d> polygon;
+        for (int k = 0; k < 5; ++k)
+            polygon.push_back(centre + vec2d(offset(gen), offset(gen)));
+        boxes.push_back(bounding_box(polygon.begin(), polygon.end()));
+    }
+
+    vector<pair_type> pairs;
+    overlapping_boxes_2D(boxes.begin(), boxes.end(), back_inserter(pairs));
+    EXPECT_EQ(brute_force(boxes), sorted(pairs));
+}
+
+TEST(SweepAndPrune2DTest, Update) {
+    mt19937 gen(2);
+    uniform_real_distribution<double> step(-0.5, 0.5);
+    auto segments = random_segments(300, gen);
+
+    intersection::sweep_and_prune_2D<double> sap;
+    sap.build(segments.begin(), segments.end());
+
+    for (int frame = 0; frame < 20; ++frame) {
+        for (auto& seg : segments) {
+            const vec2d d(step(gen), step(gen));
+            seg = segment2d(seg[0] + d, seg[1] + d);
+        }
+        sap.update(segments.begin(), segments.end());
+
+        vector<pair_type> pairs;
+        sap.pairs(back_inserter(pairs));
+        EXPECT_EQ(brute_force(segments), sorted(pairs));
+    }
+}
+
+TEST(SweepAndPrune2DTest, UpdateUnchanged) {
+    mt19937 gen(3);
+    const auto segments = random_segments(100, gen);
+
+    intersection::sweep_and_prune_2D<double> sap;
+    sap.build(segments.begin(), segments.end());
+    EXPECT_EQ(0u, sap.update(segments.begin(), segments.end()));
+}
+
+}
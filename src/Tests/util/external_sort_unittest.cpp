@@ -0,0 +1,56 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+vector<int> drain(external_sorter<int>& sorter) {
+    vector<int> result;
+    while (!sorter.empty()) {
+        result.push_back(sorter.front());
+        EXPECT_TRUE(sorter.pop());
+    }
+    return result;
+}
+
+TEST(ExternalSortTest, InMemory) {
+    external_sorter<int> sorter(1024);
+    for (int i : {5, 3, 9, 1, 3})
+        ASSERT_TRUE(sorter.push(i));
+    ASSERT_TRUE(sorter.finish());
+
+    EXPECT_EQ(0u, sorter.n_runs());
+    EXPECT_EQ(vector<int>({1, 3, 3, 5, 9}), drain(sorter));
+}
+
+TEST(ExternalSortTest, Runs) {
+    mt19937 gen(0);
+    uniform_int_distribution<int> dis(-1000, 1000);
+
+    vector<int> expected;
+    external_sorter<int> sorter(64 * sizeof(int));
+    for (int i = 0; i < 10000; ++i) {
+        expected.push_back(dis(gen));
+        ASSERT_TRUE(sorter.push(expected.back()));
+    }
+    ASSERT_TRUE(sorter.finish());
+    sort(expected.begin(), expected.end());
+
+    EXPECT_GT(sorter.n_runs(), 100u);
+    EXPECT_EQ(expected, drain(sorter));
+}
+
+TEST(ExternalSortTest, Empty) {
+    external_sorter<int> sorter(1024);
+    ASSERT_TRUE(sorter.finish());
+    EXPECT_TRUE(sorter.empty());
+}
+
+}
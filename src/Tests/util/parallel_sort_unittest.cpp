@@ -0,0 +1,41 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mtlib;
+using namespace std;
+
+namespace {
+
+TEST(ParallelSortTest, MatchesSort) {
+    mt19937 gen(0);
+    uniform_int_distribution<int> dis(-1000, 1000);
+
+    vector<int> values(100000);
+    for (auto& value : values)
+        value = dis(gen);
+    auto expected = values;
+    sort(expected.begin(), expected.end());
+
+    // odd numbers of runs leave one unmerged in some rounds, 2 and 4 end in the input, 3 and 5 in the buffer
+    for (size_t n_threads : {1, 2, 3, 4, 5, 6}) {
+        auto sorted = values;
+        parallel_sort(sorted.begin(), sorted.end(), less<>(), n_threads);
+        EXPECT_EQ(expected, sorted) << n_threads << " threads";
+    }
+}
+
+TEST(ParallelSortTest, Comparator) {
+    vector<int> values(1 << 16);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<int>(i % 1000);
+
+    parallel_sort(values.begin(), values.end(), greater<>(), 4);
+    EXPECT_TRUE(is_sorted(values.begin(), values.end(), greater<>()));
+}
+
+}   // namespace
@@ -0,0 +1,61 @@
+#include <MTLib/mtlib.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+
+using namespace mtlib;
+using namespace std;
+
+TEST(PoolAllocatorTest, RecyclesNodes) {
+    node_pool pool(1024);
+    set<int, less<int>, pool_allocator<int>> s {pool_allocator<int>(&pool)};
+
+    for (int i = 0; i < 200; ++i)
+        s.insert(i);
+    const auto blocks = pool.blocks();
+    ASSERT_GT(blocks, 1u);
+
+    for (int round = 0; round < 4; ++round) {
+        s.clear();
+        for (int i = 0; i < 200; ++i)
+            s.insert(200 - i);
+        EXPECT_EQ(blocks, pool.blocks());
+    }
+
+    EXPECT_EQ(200u, s.size());
+    EXPECT_EQ(1, *s.begin());
+    EXPECT_EQ(200, *s.rbegin());
+}
+
+TEST(PoolAllocatorTest, LargeRequests) {
+    node_pool pool(1024);
+    pool_allocator<double> alloc(&pool);
+
+    // more than the largest size class goes straight to operator new
+    auto p = alloc.allocate(1000);
+    p[999] = 1.0;
+    alloc.deallocate(p, 1000);
+    EXPECT_EQ(0u, pool.blocks());
+}
+
+TEST(PoolAllocatorTest, SmallBlocks) {
+    // a block smaller than a node is raised to the largest pooled node, so every node fits in its block
+    node_pool pool(1);
+    pool_allocator<char> alloc(&pool);
+
+    const auto largest = 16 * alignof(max_align_t);
+    auto p = alloc.allocate(largest);
+    auto q = alloc.allocate(largest);
+    fill(p, p + largest, 'p');
+    fill(q, q + largest, 'q');
+    EXPECT_EQ(2u, pool.blocks());
+    EXPECT_EQ(largest, static_cast<size_t>(count(p, p + largest, 'p')));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(q) % alignof(max_align_t));
+
+    alloc.deallocate(q, largest);
+    alloc.deallocate(p, largest);
+}